@@ -0,0 +1,128 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+using namespace llvm;
+
+namespace {
+
+// Measures -O0 code generation, as a JIT would do it, of a module with many
+// small functions, with FastISel and with GlobalISel. Functions GlobalISel
+// cannot handle fall back to SelectionDAG, as they do in llc. On AArch64,
+// GlobalISel is also measured with -global-isel-fused-select.
+
+std::string makeModule(unsigned NumFunctions) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "declare i32 @ext(i32, i32*)\n";
+  for (unsigned I = 0; I != NumFunctions; ++I)
+    OS << "define i32 @f" << I << "(i32* %p, i32 %n) {\n"
+       << "entry:\n"
+       << "  %slot = alloca i32\n"
+       << "  store i32 " << I << ", i32* %slot\n"
+       << "  br label %loop\n"
+       << "loop:\n"
+       << "  %i = phi i32 [ 0, %entry ], [ %i.next, %latch ]\n"
+       << "  %a = getelementptr i32, i32* %p, i32 %i\n"
+       << "  %v = load i32, i32* %a\n"
+       << "  %s = load i32, i32* %slot\n"
+       << "  %c = icmp slt i32 %v, %s\n"
+       << "  br i1 %c, label %small, label %latch\n"
+       << "small:\n"
+       << "  %m = mul i32 %v, 3\n"
+       << "  %x = xor i32 %m, %i\n"
+       << "  %r = call i32 @ext(i32 %x, i32* %slot)\n"
+       << "  store i32 %r, i32* %a\n"
+       << "  br label %latch\n"
+       << "latch:\n"
+       << "  %i.next = add i32 %i, 1\n"
+       << "  %done = icmp eq i32 %i.next, %n\n"
+       << "  br i1 %done, label %exit, label %loop\n"
+       << "exit:\n"
+       << "  %t = load i32, i32* %slot\n"
+       << "  %u = sub i32 %t, %n\n"
+       << "  ret i32 %u\n"
+       << "}\n";
+  return OS.str();
+}
+
+void codeGen(benchmark::State &State, const char *Triple, bool GlobalISel,
+             bool FusedSelect = false) {
+  InitializeAllTargetInfos();
+  InitializeAllTargets();
+  InitializeAllTargetMCs();
+  InitializeAllAsmPrinters();
+
+  auto &FusedSelectOpt = *static_cast<cl::opt<bool> *>(
+      cl::getRegisteredOptions()["global-isel-fused-select"]);
+  FusedSelectOpt = FusedSelect;
+
+  std::string Error;
+  const Target *T = TargetRegistry::lookupTarget(Triple, Error);
+  if (!T) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+
+  std::string IR = makeModule(500);
+  for (auto _ : State) {
+    State.PauseTiming();
+    LLVMContext Ctx;
+    SMDiagnostic Err;
+    std::unique_ptr<Module> M = parseAssemblyString(IR, Err, Ctx);
+    std::unique_ptr<TargetMachine> TM(T->createTargetMachine(
+        Triple, "", "", TargetOptions(), None, None, CodeGenOpt::None));
+    TM->setFastISel(!GlobalISel);
+    TM->setGlobalISel(GlobalISel);
+    TM->setGlobalISelAbort(GlobalISelAbortMode::Disable);
+    M->setDataLayout(TM->createDataLayout());
+    SmallString<0> Obj;
+    raw_svector_ostream OS(Obj);
+    legacy::PassManager PM;
+    TM->addPassesToEmitFile(PM, OS, nullptr, TargetMachine::CGFT_ObjectFile);
+    State.ResumeTiming();
+
+    PM.run(*M);
+    benchmark::DoNotOptimize(Obj.size());
+  }
+}
+
+void BM_X86FastISel(benchmark::State &State) {
+  codeGen(State, "x86_64-unknown-linux-gnu", /*GlobalISel=*/false);
+}
+
+void BM_X86GlobalISel(benchmark::State &State) {
+  codeGen(State, "x86_64-unknown-linux-gnu", /*GlobalISel=*/true);
+}
+
+void BM_AArch64FastISel(benchmark::State &State) {
+  codeGen(State, "aarch64-unknown-linux-gnu", /*GlobalISel=*/false);
+}
+
+void BM_AArch64GlobalISel(benchmark::State &State) {
+  codeGen(State, "aarch64-unknown-linux-gnu", /*GlobalISel=*/true);
+}
+
+void BM_AArch64GlobalISelFused(benchmark::State &State) {
+  codeGen(State, "aarch64-unknown-linux-gnu", /*GlobalISel=*/true,
+          /*FusedSelect=*/true);
+}
+
+} // end anonymous namespace
+
+BENCHMARK(BM_X86FastISel)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_X86GlobalISel)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AArch64FastISel)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AArch64GlobalISel)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AArch64GlobalISelFused)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,111 @@
+#include "benchmark/benchmark.h"
+#include "llvm/CodeGen/GlobalISel/Legalizer.h"
+#include "llvm/CodeGen/MIRParser/MIRParser.h"
+#include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/TargetPassConfig.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/InitializePasses.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+using namespace llvm;
+
+namespace {
+
+// Measures the Legalizer pass on an AArch64 function of State.range(0) groups
+// of generic instructions, most of them legal and some to widen, so that the
+// same few type signatures are queried over and over.
+
+std::string makeMIR(unsigned NumGroups) {
+  std::string MIR;
+  raw_string_ostream OS(MIR);
+  OS << "---\n"
+     << "name: f\n"
+     << "body: |\n"
+     << "  bb.0:\n"
+     << "    liveins: $x0, $x1\n"
+     << "    %0:_(p0) = COPY $x0\n"
+     << "    %1:_(s64) = COPY $x1\n";
+  unsigned R = 2;
+  for (unsigned I = 0; I != NumGroups; ++I, R += 11) {
+    OS << "    %" << R << ":_(s64) = G_CONSTANT i64 " << I * 8 << "\n"
+       << "    %" << R + 1 << ":_(p0) = G_GEP %0, %" << R << "(s64)\n"
+       << "    %" << R + 2 << ":_(s8) = G_LOAD %" << R + 1
+       << "(p0) :: (load 1)\n"
+       << "    %" << R + 3 << ":_(s8) = G_ADD %" << R + 2 << ", %" << R + 2
+       << "\n"
+       << "    %" << R + 4 << ":_(s32) = G_ZEXT %" << R + 3 << "(s8)\n"
+       << "    %" << R + 5 << ":_(s32) = G_MUL %" << R + 4 << ", %" << R + 4
+       << "\n"
+       << "    %" << R + 6 << ":_(s64) = G_SEXT %" << R + 5 << "(s32)\n"
+       << "    %" << R + 7 << ":_(s64) = G_SHL %" << R + 6 << ", %" << R
+       << "(s64)\n"
+       << "    %" << R + 8 << ":_(s1) = G_ICMP intpred(slt), %" << R + 7
+       << "(s64), %1\n"
+       << "    %" << R + 9 << ":_(s64) = G_SELECT %" << R + 8 << "(s1), %"
+       << R + 7 << ", %1\n"
+       << "    %" << R + 10 << ":_(s64) = G_XOR %" << R + 9 << ", %1\n"
+       << "    G_STORE %" << R + 10 << "(s64), %" << R + 1
+       << "(p0) :: (store 8)\n";
+  }
+  OS << "    RET_ReallyLR\n"
+     << "...\n";
+  return OS.str();
+}
+
+void BM_Legalizer(benchmark::State &State) {
+  InitializeAllTargetInfos();
+  InitializeAllTargets();
+  InitializeAllTargetMCs();
+  initializeCodeGen(*PassRegistry::getPassRegistry());
+  initializeGlobalISel(*PassRegistry::getPassRegistry());
+
+  const char *Triple = "aarch64-unknown-linux-gnu";
+  std::string Error;
+  const Target *T = TargetRegistry::lookupTarget(Triple, Error);
+  if (!T) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+
+  std::string Text = makeMIR(State.range(0));
+  for (auto _ : State) {
+    State.PauseTiming();
+    LLVMContext Ctx;
+    std::unique_ptr<MIRParser> MIR =
+        createMIRParser(MemoryBuffer::getMemBuffer(Text), Ctx);
+    std::unique_ptr<Module> M = MIR->parseIRModule();
+    std::unique_ptr<LLVMTargetMachine> TM(
+        static_cast<LLVMTargetMachine *>(T->createTargetMachine(
+            Triple, "", "", TargetOptions(), None, None, CodeGenOpt::None)));
+    M->setDataLayout(TM->createDataLayout());
+    legacy::PassManager PM;
+    TargetPassConfig *TPC = TM->createPassConfig(PM);
+    MachineModuleInfo *MMI = new MachineModuleInfo(TM.get());
+    PM.add(TPC);
+    PM.add(MMI);
+    PM.add(new Legalizer());
+    TPC->setInitialized();
+    if (MIR->parseMachineFunctions(*M, *MMI)) {
+      State.SkipWithError("invalid MIR");
+      return;
+    }
+    State.ResumeTiming();
+
+    PM.run(*M);
+  }
+}
+
+} // end anonymous namespace
+
+BENCHMARK(BM_Legalizer)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
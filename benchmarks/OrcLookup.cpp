@@ -0,0 +1,65 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+// Measures the throughput of concurrent lookups of symbols that have already
+// been materialized, as done by compile threads resolving the references of
+// the objects they link.
+
+struct LookupFixture {
+  static const unsigned NumSymbols = 4096;
+
+  LookupFixture() : JD(ES.createJITDylib("main")) {
+    SymbolMap Defs;
+    SymbolNameSet AllNames;
+    for (unsigned I = 0; I != NumSymbols; ++I) {
+      auto Name = ES.intern("sym" + std::to_string(I));
+      Defs[Name] = JITEvaluatedSymbol(0x1000 + I, JITSymbolFlags::Exported);
+      Names.push_back(Name);
+      AllNames.insert(Name);
+    }
+    cantFail(JD.define(absoluteSymbols(std::move(Defs))));
+
+    // Materialize everything up front.
+    cantFail(ES.lookup(JITDylibSearchList({{&JD, false}}), AllNames));
+  }
+
+  ExecutionSession ES;
+  JITDylib &JD;
+  std::vector<SymbolStringPtr> Names;
+};
+
+LookupFixture &getFixture() {
+  static LookupFixture F;
+  return F;
+}
+
+void BM_LookupReadySymbols(benchmark::State &State) {
+  auto &F = getFixture();
+  JITDylibSearchList SearchOrder({{&F.JD, false}});
+  unsigned SymbolsPerLookup = State.range(0);
+
+  // Each thread walks the symbol table from a different starting point.
+  unsigned Next = State.thread_index * 997;
+  for (auto _ : State) {
+    SymbolNameSet Symbols;
+    for (unsigned I = 0; I != SymbolsPerLookup; ++I)
+      Symbols.insert(F.Names[Next++ % LookupFixture::NumSymbols]);
+    benchmark::DoNotOptimize(cantFail(F.ES.lookup(SearchOrder, Symbols)));
+  }
+  State.SetItemsProcessed(State.iterations() * SymbolsPerLookup);
+}
+
+} // end anonymous namespace
+
+BENCHMARK(BM_LookupReadySymbols)
+    ->Arg(1)
+    ->Arg(16)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,162 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/ExecutionEngine/Orc/NullResolver.h"
+#include "llvm/ExecutionEngine/Orc/OrcABISupport.h"
+#include "llvm/ExecutionEngine/Orc/OrcRemoteTargetClient.h"
+#include "llvm/ExecutionEngine/Orc/OrcRemoteTargetServer.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/TargetSelect.h"
+#include <thread>
+#include <unistd.h>
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+// Compares loading objects into a remote JIT server over a pipe with and
+// without shared memory. The server runs on a thread of this process, but
+// only talks to the client through the pipe (and the shared memory).
+
+class PipeChannel final : public rpc::RawByteChannel {
+public:
+  PipeChannel(int InFD, int OutFD) : InFD(InFD), OutFD(OutFD) {}
+
+  Error readBytes(char *Dst, unsigned Size) override {
+    while (Size) {
+      ssize_t Read = ::read(InFD, Dst, Size);
+      if (Read <= 0)
+        return errorCodeToError(
+            std::error_code(errno, std::generic_category()));
+      Dst += Read;
+      Size -= Read;
+    }
+    return Error::success();
+  }
+
+  Error appendBytes(const char *Src, unsigned Size) override {
+    while (Size) {
+      ssize_t Written = ::write(OutFD, Src, Size);
+      if (Written < 0)
+        return errorCodeToError(
+            std::error_code(errno, std::generic_category()));
+      Src += Written;
+      Size -= Written;
+    }
+    return Error::success();
+  }
+
+  Error send() override { return Error::success(); }
+
+private:
+  int InFD, OutFD;
+};
+
+// Compiles a module with a function and a read-only array of DataSize bytes.
+std::unique_ptr<MemoryBuffer> compileObject(size_t DataSize) {
+  LLVMContext Ctx;
+  Module M("bench", Ctx);
+  auto JTMB = cantFail(JITTargetMachineBuilder::detectHost());
+  auto TM = cantFail(JTMB.createTargetMachine());
+  M.setDataLayout(TM->createDataLayout());
+
+  std::vector<uint8_t> Bytes(DataSize, 0x5a);
+  auto *Init = ConstantDataArray::get(Ctx, Bytes);
+  auto *Data = new GlobalVariable(M, Init->getType(), true,
+                                  GlobalValue::ExternalLinkage, Init, "data");
+
+  auto *F = Function::Create(FunctionType::get(Type::getInt8Ty(Ctx), false),
+                             GlobalValue::ExternalLinkage, "f", &M);
+  IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+  B.CreateRet(B.CreateLoad(B.CreateConstGEP2_32(Init->getType(), Data, 0, 0)));
+
+  return SimpleCompiler(*TM)(M);
+}
+
+void BM_RemoteLoadObject(benchmark::State &State, bool UseSharedMemory) {
+  static const uint64_t SharedMemSize = 64 * 1024 * 1024;
+
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  auto ObjBuffer = compileObject(State.range(0));
+  auto Obj = cantFail(
+      object::ObjectFile::createObjectFile(ObjBuffer->getMemBufferRef()));
+
+  int SharedMemFD = -1;
+  if (UseSharedMemory) {
+    SmallString<128> Path;
+    if (sys::fs::createTemporaryFile("orc-remote-bench", "mem", SharedMemFD,
+                                     Path)) {
+      State.SkipWithError("could not create shared memory");
+      return;
+    }
+    sys::fs::remove(Path);
+    if (sys::fs::resize_file(SharedMemFD, SharedMemSize)) {
+      State.SkipWithError("could not create shared memory");
+      return;
+    }
+  }
+
+  int ToServer[2], ToClient[2];
+  if (pipe(ToServer) != 0 || pipe(ToClient) != 0) {
+    State.SkipWithError("could not create pipes");
+    return;
+  }
+
+  std::thread ServerThread([&]() {
+    PipeChannel Channel(ToServer[0], ToClient[1]);
+    remote::OrcRemoteTargetServer<PipeChannel, OrcGenericABI> Server(
+        Channel, [](const std::string &) -> JITTargetAddress { return 0; },
+        [](uint8_t *, uint32_t) {}, [](uint8_t *, uint32_t) {});
+    if (UseSharedMemory)
+      Server.enableSharedMemory(SharedMemFD);
+    while (!Server.receivedTerminate())
+      cantFail(Server.handleOne());
+  });
+
+  {
+    ExecutionSession ES;
+    PipeChannel Channel(ToClient[0], ToServer[1]);
+    auto Client = cantFail(remote::OrcRemoteTargetClient::Create(Channel, ES));
+    if (UseSharedMemory)
+      cantFail(Client->enableSharedMemory(SharedMemFD, SharedMemSize));
+
+    NullLegacyResolver Resolver;
+    for (auto _ : State) {
+      auto MemMgr = cantFail(Client->createRemoteMemoryManager());
+      RuntimeDyld Dyld(*MemMgr, Resolver);
+      Dyld.loadObject(*Obj);
+      Dyld.resolveRelocations();
+      Dyld.registerEHFrames();
+      MemMgr->finalizeMemory();
+    }
+    State.SetBytesProcessed(State.iterations() * State.range(0));
+
+    cantFail(Client->terminateSession());
+  }
+  ServerThread.join();
+
+  for (int FD : {ToServer[0], ToServer[1], ToClient[0], ToClient[1]})
+    close(FD);
+  if (SharedMemFD >= 0)
+    close(SharedMemFD);
+}
+
+} // end anonymous namespace
+
+BENCHMARK_CAPTURE(BM_RemoteLoadObject, Pipe, false)
+    ->Arg(4 << 10)
+    ->Arg(256 << 10)
+    ->Arg(4 << 20);
+BENCHMARK_CAPTURE(BM_RemoteLoadObject, SharedMemory, true)
+    ->Arg(4 << 10)
+    ->Arg(256 << 10)
+    ->Arg(4 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,104 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+using namespace llvm;
+
+namespace {
+
+// Measures llc-style code generation of a module with many functions, with
+// the machine passes running on State.range(0) threads (0 is the normal,
+// serial pipeline).
+
+std::string makeModule(unsigned NumFunctions) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  for (unsigned I = 0; I != NumFunctions; ++I)
+    OS << "define i64 @f" << I << "(i64* %p, i64 %n) {\n"
+       << "entry:\n"
+       << "  br label %loop\n"
+       << "loop:\n"
+       << "  %i = phi i64 [ 0, %entry ], [ %i.next, %latch ]\n"
+       << "  %acc = phi i64 [ " << I << ", %entry ], [ %acc.next, %latch ]\n"
+       << "  %a = getelementptr i64, i64* %p, i64 %i\n"
+       << "  %v = load i64, i64* %a\n"
+       << "  %odd = and i64 %v, 1\n"
+       << "  %c = icmp eq i64 %odd, 0\n"
+       << "  br i1 %c, label %even, label %latch\n"
+       << "even:\n"
+       << "  %h = lshr i64 %v, 1\n"
+       << "  %x = mul i64 %h, %acc\n"
+       << "  %y = xor i64 %x, %i\n"
+       << "  store i64 %y, i64* %a\n"
+       << "  br label %latch\n"
+       << "latch:\n"
+       << "  %w = phi i64 [ %v, %loop ], [ %y, %even ]\n"
+       << "  %acc.next = add i64 %acc, %w\n"
+       << "  %i.next = add i64 %i, 1\n"
+       << "  %done = icmp eq i64 %i.next, %n\n"
+       << "  br i1 %done, label %exit, label %loop\n"
+       << "exit:\n"
+       << "  ret i64 %acc.next\n"
+       << "}\n";
+  return OS.str();
+}
+
+void BM_CodeGen(benchmark::State &State) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+
+  auto &Options = cl::getRegisteredOptions();
+  auto *Threads =
+      static_cast<cl::opt<unsigned> *>(Options["machine-function-threads"]);
+  Threads->setValue(State.range(0));
+
+  std::string Triple = sys::getProcessTriple();
+  std::string Error;
+  const Target *T = TargetRegistry::lookupTarget(Triple, Error);
+  if (!T) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+
+  std::string IR = makeModule(2000);
+  for (auto _ : State) {
+    State.PauseTiming();
+    LLVMContext Ctx;
+    SMDiagnostic Err;
+    std::unique_ptr<Module> M = parseAssemblyString(IR, Err, Ctx);
+    std::unique_ptr<TargetMachine> TM(T->createTargetMachine(
+        Triple, "", "", TargetOptions(), None, None, CodeGenOpt::Default));
+    M->setDataLayout(TM->createDataLayout());
+    SmallString<0> Obj;
+    raw_svector_ostream OS(Obj);
+    legacy::PassManager PM;
+    TM->addPassesToEmitFile(PM, OS, nullptr, TargetMachine::CGFT_ObjectFile);
+    State.ResumeTiming();
+
+    PM.run(*M);
+    benchmark::DoNotOptimize(Obj.size());
+  }
+  Threads->setValue(0);
+}
+
+} // end anonymous namespace
+
+BENCHMARK(BM_CodeGen)
+    ->Arg(0)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+using namespace llvm;
+
+namespace {
+
+// Measures llc-style code generation of a function whose single basic block
+// has State.range(0) groups of instructions, so that one SelectionDAG holds
+// them all. Each group recomputes some values of the group before it, which
+// the DAG combiner finds again in the CSE map.
+
+std::string makeModule(unsigned NumGroups) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "define i64 @f(i64* %p, i64 %x) {\n"
+     << "entry:\n"
+     << "  %acc0 = add i64 %x, 1\n";
+  for (unsigned I = 0; I != NumGroups; ++I) {
+    unsigned J = I + 1;
+    OS << "  %a" << J << " = getelementptr i64, i64* %p, i64 " << I << "\n"
+       << "  %v" << J << " = load i64, i64* %a" << J << "\n"
+       << "  %m" << J << " = mul i64 %v" << J << ", %acc" << I << "\n"
+       << "  %s" << J << " = shl i64 %acc" << I << ", 3\n"
+       << "  %t" << J << " = shl i64 %acc" << I << ", 3\n"
+       << "  %u" << J << " = xor i64 %m" << J << ", %s" << J << "\n"
+       << "  %w" << J << " = sub i64 %u" << J << ", %t" << J << "\n"
+       << "  store i64 %w" << J << ", i64* %a" << J << "\n"
+       << "  %acc" << J << " = add i64 %w" << J << ", %v" << J << "\n";
+  }
+  OS << "  ret i64 %acc" << NumGroups << "\n"
+     << "}\n";
+  return OS.str();
+}
+
+void BM_CodeGen(benchmark::State &State) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+
+  std::string Triple = sys::getProcessTriple();
+  std::string Error;
+  const Target *T = TargetRegistry::lookupTarget(Triple, Error);
+  if (!T) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+
+  std::string IR = makeModule(State.range(0));
+  for (auto _ : State) {
+    State.PauseTiming();
+    LLVMContext Ctx;
+    SMDiagnostic Err;
+    std::unique_ptr<Module> M = parseAssemblyString(IR, Err, Ctx);
+    std::unique_ptr<TargetMachine> TM(T->createTargetMachine(
+        Triple, "", "", TargetOptions(), None, None, CodeGenOpt::Default));
+    M->setDataLayout(TM->createDataLayout());
+    SmallString<0> Obj;
+    raw_svector_ostream OS(Obj);
+    legacy::PassManager PM;
+    TM->addPassesToEmitFile(PM, OS, nullptr, TargetMachine::CGFT_ObjectFile);
+    State.ResumeTiming();
+
+    PM.run(*M);
+    benchmark::DoNotOptimize(Obj.size());
+  }
+}
+
+} // end anonymous namespace
+
+BENCHMARK(BM_CodeGen)
+    ->Arg(1000)
+    ->Arg(4000)
+    ->Arg(16000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Support/SuffixArray.h"
+#include "llvm/Support/SuffixTree.h"
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+// Compares finding the repeated substrings of a string shaped like the
+// instruction mapping of the MachineOutliner with a suffix tree and with a
+// suffix array. The string has State.range(0) elements: basic blocks of a
+// few dozen instructions taken from a small set, separated by unique
+// instructions that can't be outlined.
+
+std::vector<unsigned> makeString(unsigned Length) {
+  std::vector<unsigned> Str;
+  Str.reserve(Length);
+  unsigned Illegal = -3;
+  uint32_t Seed = 1;
+  while (Str.size() < Length) {
+    Seed = Seed * 1103515245 + 12345;
+    if ((Seed >> 16) % 32 == 0)
+      Str.push_back(Illegal--);
+    else
+      Str.push_back((Seed >> 16) % 200);
+  }
+  Str.back() = Illegal;
+  return Str;
+}
+
+void BM_SuffixTree(benchmark::State &State) {
+  std::vector<unsigned> Str = makeString(State.range(0));
+  for (auto _ : State) {
+    SuffixTree ST(Str);
+    unsigned NumRepeats = 0;
+    for (auto It = ST.begin(), Et = ST.end(); It != Et; ++It)
+      ++NumRepeats;
+    benchmark::DoNotOptimize(NumRepeats);
+  }
+  State.SetItemsProcessed(State.iterations() * Str.size());
+}
+
+void BM_SuffixArray(benchmark::State &State) {
+  std::vector<unsigned> Str = makeString(State.range(0));
+  for (auto _ : State) {
+    SuffixArray SA(Str);
+    unsigned NumRepeats = 0;
+    SA.forEachRepeatedSubstring(
+        [&NumRepeats](const RepeatedSubstring &) { ++NumRepeats; });
+    benchmark::DoNotOptimize(NumRepeats);
+  }
+  State.SetItemsProcessed(State.iterations() * Str.size());
+}
+
+} // end anonymous namespace
+
+BENCHMARK(BM_SuffixTree)
+    ->Range(1 << 12, 1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SuffixArray)
+    ->Range(1 << 12, 1 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -38,6 +38,7 @@ class CallLowering;
 class Constant;
 class DataLayout;
 class Instruction;
+class InstructionSelector;
 class MachineBasicBlock;
 class MachineFunction;
 class MachineInstr;
@@ -64,6 +65,10 @@ private:
   /// Interface used to lower the everything related to calls.
   const CallLowering *CLI;
 
+  /// Selector given the instructions it can select as soon as they are
+  /// translated, or null if selection is not fused with translation.
+  const InstructionSelector *FusedISel = nullptr;
+
   /// This class contains the mapping between the Values to vreg related data.
   class ValueToVRegInfo {
   public:
@@ -79,20 +84,24 @@ private:
 
     inline const_vreg_iterator vregs_end() const { return ValToVRegs.end(); }
 
-    VRegListT *getVRegs(const Value &V) {
-      auto It = ValToVRegs.find(&V);
-      if (It != ValToVRegs.end())
-        return It->second;
+    VRegListT *getVRegs(const Value &V) { return getOrInsertVRegs(V).first; }
 
-      return insertVRegs(V);
+    /// Return the vreg list of \p V, creating an empty one if there is none,
+    /// and whether it was created. This takes a single map lookup.
+    std::pair<VRegListT *, bool> getOrInsertVRegs(const Value &V) {
+      auto Res = ValToVRegs.try_emplace(&V, nullptr);
+      // We placement new using our fast allocator since we never try to free
+      // the vectors until translation is finished.
+      if (Res.second)
+        Res.first->second = new (VRegAlloc.Allocate()) VRegListT();
+      return {Res.first->second, Res.second};
     }
 
     OffsetListT *getOffsets(const Value &V) {
-      auto It = TypeToOffsets.find(V.getType());
-      if (It != TypeToOffsets.end())
-        return It->second;
-
-      return insertOffsets(V);
+      auto Res = TypeToOffsets.try_emplace(V.getType(), nullptr);
+      if (Res.second)
+        Res.first->second = new (OffsetAlloc.Allocate()) OffsetListT();
+      return Res.first->second;
     }
 
     const_vreg_iterator findVRegs(const Value &V) const {
@@ -111,24 +120,6 @@ private:
     }
 
   private:
-    VRegListT *insertVRegs(const Value &V) {
-      assert(ValToVRegs.find(&V) == ValToVRegs.end() && "Value already exists");
-
-      // We placement new using our fast allocator since we never try to free
-      // the vectors until translation is finished.
-      auto *VRegList = new (VRegAlloc.Allocate()) VRegListT();
-      ValToVRegs[&V] = VRegList;
-      return VRegList;
-    }
-
-    OffsetListT *insertOffsets(const Value &V) {
-      assert(TypeToOffsets.find(V.getType()) == TypeToOffsets.end() &&
-             "Type already exists");
-
-      auto *OffsetList = new (OffsetAlloc.Allocate()) OffsetListT();
-      TypeToOffsets[V.getType()] = OffsetList;
-      return OffsetList;
-    }
     SpecificBumpPtrAllocator<VRegListT> VRegAlloc;
     SpecificBumpPtrAllocator<OffsetListT> OffsetAlloc;
 
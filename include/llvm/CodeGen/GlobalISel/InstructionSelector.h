@@ -358,6 +358,14 @@ public:
   ///       !isPreISelGenericOpcode(I.getOpcode())
   virtual bool select(MachineInstr &I, CodeGenCoverage &CoverageInfo) const = 0;
 
+  /// Select the generic instruction \p I that the IRTranslator just built, at
+  /// -O0 with -global-isel-fused-select. Its operands have no register bank
+  /// yet, so the replacement must constrain them to register classes. Targets
+  /// only need to handle the instructions that are legal as they are.
+  ///
+  /// \returns whether \p I was replaced and erased.
+  virtual bool selectDuringTranslation(MachineInstr &I) const { return false; }
+
 protected:
   using ComplexRendererFns =
       Optional<SmallVector<std::function<void(MachineInstrBuilder &)>, 4>>;
@@ -32,6 +32,7 @@ namespace llvm {
 class LegalizerInfo;
 class Legalizer;
 class MachineRegisterInfo;
+struct LegalizeActionStep;
 
 class LegalizerHelper {
 public:
@@ -60,6 +61,11 @@ public:
   /// registers as \p MI.
   LegalizeResult legalizeInstrStep(MachineInstr &MI);
 
+  /// Same as above, but apply \p Step, an action already computed for \p MI
+  /// by the LegalizerInfo, instead of querying it again.
+  LegalizeResult legalizeInstrStep(MachineInstr &MI,
+                                   const LegalizeActionStep &Step);
+
   /// Legalize an instruction by emiting a runtime library call instead.
   LegalizeResult libcall(MachineInstr &MI);
 
@@ -30,6 +30,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -937,6 +938,10 @@ public:
   /// Determine what action should be taken to legalize the described
   /// instruction. Requires computeTables to have been called.
   ///
+  /// The decisions are remembered in a table indexed by the opcode and types
+  /// of the query, so that only the first query with a given signature runs
+  /// the rules. This makes queries unsafe to run concurrently.
+  ///
   /// \returns a description of the next legalization step to perform.
   LegalizeActionStep getAction(const LegalityQuery &Query) const;
 
@@ -954,6 +959,10 @@ public:
                               MachineIRBuilder &MIRBuilder) const;
 
 private:
+  /// Run \p Query through the rules, or the legacy actions if there are none
+  /// for its opcode.
+  LegalizeActionStep decideAction(const LegalityQuery &Query) const;
+
   /// Determine what action should be taken to legalize the given generic
   /// instruction opcode, type-index and type. Requires computeTables to have
   /// been called.
@@ -1139,6 +1148,28 @@ private:
       NumElements2Actions[LastOp - FirstOp + 1];
 
   LegalizeRuleSet RulesForOpcode[LastOp - FirstOp + 1];
+
+  // Data structures used to remember the decisions of getAction:
+  static const unsigned MaxDecisionTypes = 3;
+  static const unsigned NumDecisions = 512;
+
+  /// The decision for a query signature. Queries with more types or memory
+  /// operands than fit are decided every time.
+  struct Decision {
+    unsigned Opcode = 0;
+    unsigned NumTypes = 0;
+    unsigned NumMMOs = 0;
+    LLT Types[MaxDecisionTypes];
+    LegalityQuery::MemDesc MMO = {0, AtomicOrdering::NotAtomic};
+    LegalizeActionStep Step = {LegalizeActions::Unsupported, 0, LLT{}};
+
+    bool matches(const LegalityQuery &Query) const;
+  };
+
+  /// A direct-mapped table of decisions, indexed by a hash of the query
+  /// signature. It is allocated on the first query and cleared whenever the
+  /// rules may change.
+  mutable std::vector<Decision> Decisions;
 };
 
 #ifndef NDEBUG
@@ -35,7 +35,9 @@
 #include "llvm/Support/ErrorHandling.h"
 #include <cassert>
 #include <cstdint>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -65,6 +67,11 @@ class VirtRegMap;
     /// Special pool allocator for VNInfo's (LiveInterval val#).
     VNInfo::Allocator VNInfoAllocator;
 
+    /// The VNInfo allocators of the threads that compute virtual register
+    /// intervals with -live-interval-threads, one per thread. Their values
+    /// are released with the intervals.
+    std::vector<std::unique_ptr<VNInfo::Allocator>> ThreadVNInfoAllocators;
+
     /// Live interval pointers for all the virtual registers.
     IndexedMap<LiveInterval*, VirtReg2IndexFunctor> VirtRegIntervals;
 
@@ -440,6 +447,11 @@ class VirtRegMap;
     /// Compute live intervals for all virtual registers.
     void computeVirtRegs();
 
+    /// Compute live intervals for all virtual registers on \p Threads
+    /// threads, each with its own LiveRangeCalc and VNInfo allocator. The
+    /// intervals are the same as those of computeVirtRegs().
+    void computeVirtRegsInParallel(unsigned Threads);
+
     /// Compute RegMaskSlots and RegMaskBits.
     void computeRegMasks();
 
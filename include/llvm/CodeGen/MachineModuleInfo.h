@@ -38,6 +38,7 @@
 #include "llvm/MC/MCSymbol.h"
 #include "llvm/Pass.h"
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -141,6 +142,12 @@ class MachineModuleInfo : public ImmutablePass {
   unsigned NextFnNum = 0;
   const Function *LastRequest = nullptr; ///< Used for shortcut/cache.
   MachineFunction *LastResult = nullptr; ///< Used for shortcut/cache.
+  /// Guards the map above and its cache: the machine functions of a module
+  /// may be compiled on several threads.
+  mutable std::mutex MachineFunctionsMutex;
+
+  /// See getIRMutex().
+  std::mutex IRMutex;
 
 public:
   static char ID; // Pass identification, replacement for typeid
@@ -169,6 +176,12 @@ public:
   /// Machine Function map.
   void deleteMachineFunctionFor(Function &F);
 
+  /// Returns the mutex that machine function passes hold while they change
+  /// the IR or create constants and types, which live in the LLVMContext
+  /// shared by all the functions of the module. Several functions are
+  /// compiled at once with -machine-function-threads.
+  std::mutex &getIRMutex() { return IRMutex; }
+
   /// Keep track of various per-function pieces of information for backends
   /// that would like to do so.
   template<typename Ty>
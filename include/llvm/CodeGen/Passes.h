@@ -430,6 +430,11 @@ namespace llvm {
   /// printing assembly.
   ModulePass *createMachineOutlinerPass(bool RunOnAllFunctions = true);
 
+  /// This pass runs the machine passes of the codegen pipeline on the
+  /// functions of the module, on NumThreads worker threads. See
+  /// TargetPassConfig::addParallelMachinePasses.
+  ModulePass *createParallelMachinePassesPass(unsigned NumThreads);
+
   /// This pass expands the experimental reduction intrinsics into sequences of
   /// shuffles.
   FunctionPass *createExpandReductionsPass();
@@ -46,7 +46,7 @@
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MachineValueType.h"
-#include "llvm/Support/RecyclingAllocator.h"
+#include "llvm/Support/Recycler.h"
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
@@ -245,23 +245,22 @@ class SelectionDAG {
   /// A linked list of nodes in the current DAG.
   ilist<SDNode> AllNodes;
 
-  /// The AllocatorType for allocating SDNodes. We use
-  /// pool allocation with recycling.
-  using NodeAllocatorType = RecyclingAllocator<BumpPtrAllocator, SDNode,
-                                               sizeof(LargestSDNode),
-                                               alignof(MostAlignedSDNode)>;
+  /// Pool allocation for nodes, their operands and shuffle masks. Nodes and
+  /// operands come from one arena, so that a node created after its operands
+  /// sits next to them in memory, and the arena is reset with the DAG.
+  BumpPtrAllocator NodeAllocator;
 
-  /// Pool allocation for nodes.
-  NodeAllocatorType NodeAllocator;
+  /// Recycling of deleted nodes, all in slots of the size of the largest one.
+  Recycler<SDNode, sizeof(LargestSDNode), alignof(MostAlignedSDNode)>
+      NodeRecycler;
+
+  /// Recycling of operand lists, by capacity.
+  ArrayRecycler<SDUse> OperandRecycler;
 
   /// This structure is used to memoize nodes, automatically performing
   /// CSE with existing nodes when a duplicate is requested.
   FoldingSet<SDNode> CSEMap;
 
-  /// Pool allocation for machine-opcode SDNode operands.
-  BumpPtrAllocator OperandAllocator;
-  ArrayRecycler<SDUse> OperandRecycler;
-
   /// Pool allocation for misc. objects that are created once per SelectionDAG.
   BumpPtrAllocator Allocator;
 
@@ -333,7 +332,7 @@ private:
 
   template <typename SDNodeT, typename... ArgTypes>
   SDNodeT *newSDNode(ArgTypes &&... Args) {
-    return new (NodeAllocator.template Allocate<SDNodeT>())
+    return new (NodeRecycler.template Allocate<SDNodeT>(NodeAllocator))
         SDNodeT(std::forward<ArgTypes>(Args)...);
   }
 
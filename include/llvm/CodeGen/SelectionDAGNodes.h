@@ -574,6 +574,7 @@ protected:
 
 private:
   friend class SelectionDAG;
+  friend struct FoldingSetTrait<SDNode>;
   // TODO: unfriend HandleSDNode once we fix its operand handling.
   friend class HandleSDNode;
 
@@ -604,6 +605,10 @@ private:
   /// Source line information.
   DebugLoc debugLoc;
 
+  /// The hash of the profile of this node in the CSE map, or 0 if it hasn't
+  /// been computed since the node was last added to the map.
+  mutable unsigned CSEHash = 0;
+
   /// Return a pointer to the specified value type.
   static const EVT *getValueTypeList(EVT VT);
 
@@ -1068,6 +1073,30 @@ protected:
   void DropOperands();
 };
 
+/// Specialize FoldingSetTrait for SDNode to compare the hashes of the profiles
+/// of nodes, cached in the nodes, before the profiles themselves. Looking up a
+/// node in the CSE map then only builds the profile of the nodes of its bucket
+/// that have the same hash, rather than of all of them.
+template <> struct FoldingSetTrait<SDNode> : DefaultFoldingSetTrait<SDNode> {
+  static bool Equals(const SDNode &X, const FoldingSetNodeID &ID,
+                     unsigned IDHash, FoldingSetNodeID &TempID) {
+    if (X.CSEHash && X.CSEHash != IDHash)
+      return false;
+    X.Profile(TempID);
+    if (!X.CSEHash)
+      X.CSEHash = TempID.ComputeHash();
+    return TempID == ID;
+  }
+
+  static unsigned ComputeHash(const SDNode &X, FoldingSetNodeID &TempID) {
+    if (!X.CSEHash) {
+      X.Profile(TempID);
+      X.CSEHash = TempID.ComputeHash();
+    }
+    return X.CSEHash;
+  }
+};
+
 /// Wrapper class for IR location info (IR ordering and DebugLoc) to be passed
 /// into SDNode creation functions.
 /// When an SDNode is created from the DAGBuilder, the DebugLoc is extracted
@@ -1444,7 +1473,7 @@ public:
 /// An index of -1 is treated as undef, such that the code generator may put
 /// any value in the corresponding element of the result.
 class ShuffleVectorSDNode : public SDNode {
-  // The memory for Mask is owned by the SelectionDAG's OperandAllocator, and
+  // The memory for Mask is owned by the SelectionDAG's NodeAllocator, and
   // is freed when the SelectionDAG object is destroyed.
   const int *Mask;
 
@@ -352,6 +352,10 @@ class raw_ostream;
     /// and MBB id.
     SmallVector<IdxMBBPair, 8> idx2MBBMap;
 
+    /// The number of entries given a new index by local renumberings since the
+    /// analysis ran.
+    uint64_t NumRenumberedEntries = 0;
+
     IndexListEntry* createEntry(MachineInstr *mi, unsigned index) {
       IndexListEntry *entry =
           static_cast<IndexListEntry *>(ileAllocator.Allocate(
@@ -362,7 +366,9 @@ class raw_ostream;
       return entry;
     }
 
-    /// Renumber locally after inserting curItr.
+    /// Renumber locally after inserting curItr. When that would take a long
+    /// run of renumbered indexes, relabel the smallest range of indexes
+    /// around it that has room for it instead.
     void renumberIndexes(IndexList::iterator curItr);
 
   public:
@@ -388,6 +394,11 @@ class raw_ostream;
     /// Renumber the index list, providing space for new instructions.
     void renumberIndexes();
 
+    /// Returns the number of entries that local renumberings, after
+    /// instructions were inserted without a free index, have given new
+    /// indexes since the analysis ran.
+    uint64_t getNumRenumberedEntries() const { return NumRenumberedEntries; }
+
     /// Repair indexes after adding and removing instructions.
     void repairIndexesInRange(MachineBasicBlock *MBB,
                               MachineBasicBlock::iterator Begin,
@@ -122,6 +122,11 @@ protected:
   /// callers.
   bool RequireCodeGenSCCOrder = false;
 
+  /// Allow -machine-function-threads to run the machine passes on several
+  /// functions at once. Temporary labels are then numbered in a different
+  /// order, so this is only set when their names do not reach the output.
+  bool AllowParallelMachinePasses = false;
+
   /// Add the actual instruction selection passes. This does not include
   /// preparation passes on IR.
   bool addCoreISelPasses();
@@ -169,6 +174,10 @@ public:
     setOpt(RequireCodeGenSCCOrder, Enable);
   }
 
+  void setAllowParallelMachinePasses(bool Allow) {
+    setOpt(AllowParallelMachinePasses, Allow);
+  }
+
   /// Allow the target to override a specific pass without overriding the pass
   /// pipeline. When passes are added to the standard pipeline at the
   /// point where StandardID is expected, add TargetID in its place.
@@ -264,6 +273,18 @@ public:
   /// Fully developed targets will not generally override this.
   virtual void addMachinePasses();
 
+  /// Add the passes that -machine-function-threads runs on its worker
+  /// threads: the machine passes that addMachinePasses adds from instruction
+  /// selected code up to the machine outliner, along with the IR analyses they
+  /// use. This is called on a pass configuration created for each worker.
+  void addParallelMachinePasses();
+
+  /// Return true if this target's machine passes may run on several functions
+  /// at once with -machine-function-threads. They must not create constants
+  /// or globals, or otherwise change the LLVMContext, without holding the IR
+  /// mutex. Targets opt in once their passes have been audited for this.
+  virtual bool supportsParallelMachinePasses() const { return false; }
+
   /// Create an instance of ScheduleDAGInstrs to be run within the standard
   /// MachineScheduler pass for this function and target at the current
   /// optimization level.
@@ -419,6 +440,15 @@ protected:
   /// addMachinePasses helper to create the target-selected or overriden
   /// regalloc pass.
   FunctionPass *createRegAllocPass(bool Optimized);
+
+private:
+  /// Add the alias analyses used by the codegen passes.
+  void addAliasAnalysisPasses();
+
+  /// Mark the beginning and the end of the passes of addMachinePasses that can
+  /// run on several functions at once, see -machine-function-threads.
+  void beginParallelMachinePasses();
+  void endParallelMachinePasses();
 };
 
 } // end namespace llvm
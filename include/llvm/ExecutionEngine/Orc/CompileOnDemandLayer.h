@@ -62,7 +62,7 @@ namespace orc {
 
 class ExtractingIRMaterializationUnit;
 
-class CompileOnDemandLayer : public IRLayer {
+class CompileOnDemandLayer : public IRLayer, public ResourceManager {
   friend class PartitioningIRMaterializationUnit;
 
 public:
@@ -89,13 +89,37 @@ public:
                         LazyCallThroughManager &LCTMgr,
                         IndirectStubsManagerBuilder BuildIndirectStubsManager);
 
+  ~CompileOnDemandLayer() override;
+
   /// Sets the partition function.
   void setPartitionFunction(PartitionFunction Partition);
 
+  /// Sets the maximum number of functions that may be speculatively compiled
+  /// at any one time. A limit of zero (the default) disables speculation.
+  ///
+  /// When speculation is enabled, each time a partition is emitted the
+  /// not-yet-compiled functions it calls directly are looked up with
+  /// ExecutionSession::speculate, so that they are compiled before their
+  /// first call. If the module carries profile data, callees with the highest
+  /// entry counts are speculated first and callees with an entry count of
+  /// zero are never speculated.
+  void setSpeculationLimit(unsigned MaxSpeculativeFunctions);
+
+  /// Points the stub for function Name at NewAddr, so that later calls
+  /// through the stub go to NewAddr instead of the body this layer compiled.
+  /// ImplD is the implementation dylib that the body was emitted to (the
+  /// target dylib of the base layer's MaterializationResponsibility).
+  Error redirect(JITDylib &ImplD, const SymbolStringPtr &Name,
+                 JITTargetAddress NewAddr);
+
   /// Emits the given module. This should not be called by clients: it will be
   /// called by the JIT when a definition added via the add method is requested.
   void emit(MaterializationResponsibility R, ThreadSafeModule TSM) override;
 
+  /// Frees the stubs that were created for the functions of the module with
+  /// key K. Called by the ExecutionSession when the module is removed.
+  Error removeResources(VModuleKey K) override;
+
 private:
   struct PerDylibResources {
   public:
@@ -118,6 +142,12 @@ private:
 
   void expandPartition(GlobalValueSet &Partition);
 
+  std::vector<std::string>
+  findSpeculationCandidates(const GlobalValueSet &Partition);
+
+  void speculate(JITDylib &ImplD, const DataLayout &DL,
+                 std::vector<std::string> Candidates);
+
   void emitPartition(MaterializationResponsibility R, ThreadSafeModule TSM,
                      IRMaterializationUnit::SymbolNameToDefinitionMap Defs);
 
@@ -127,8 +157,15 @@ private:
   LazyCallThroughManager &LCTMgr;
   IndirectStubsManagerBuilder BuildIndirectStubsManager;
   PerDylibResourcesMap DylibResources;
+  // Names of the stubs that may have been created for each module's
+  // functions, and the stubs manager they were created in.
+  std::map<VModuleKey,
+           std::vector<std::pair<IndirectStubsManager *, SymbolNameSet>>>
+      ModuleStubs;
   PartitionFunction Partition = compileRequested;
   SymbolLinkagePromoter PromoteSymbols;
+  unsigned SpeculationLimit = 0;
+  unsigned SpeculationsInFlight = 0;
 };
 
 /// Compile-on-demand layer.
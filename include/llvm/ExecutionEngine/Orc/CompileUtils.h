@@ -80,6 +80,7 @@ public:
 
     // TODO: Actually report errors helpfully.
     consumeError(Obj.takeError());
+    notifyObjectCompileFailed(M);
     return nullptr;
   }
 
@@ -97,6 +98,11 @@ private:
       ObjCache->notifyObjectCompiled(&M, ObjBuffer.getMemBufferRef());
   }
 
+  void notifyObjectCompileFailed(const Module &M) {
+    if (ObjCache)
+      ObjCache->notifyObjectCompileFailed(&M);
+  }
+
   TargetMachine &TM;
   ObjectCache *ObjCache = nullptr;
 };
@@ -19,6 +19,7 @@
 #include "llvm/ExecutionEngine/Orc/SymbolStringPool.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/RWMutex.h"
 
 #include <memory>
 #include <vector>
@@ -263,6 +264,9 @@ public:
   /// Return the set of symbols that this source provides.
   const SymbolFlagsMap &getSymbols() const { return SymbolFlags; }
 
+  /// Returns the VModuleKey for this instance.
+  VModuleKey getVModuleKey() const { return K; }
+
   /// Called by materialization dispatchers (see
   /// ExecutionSession::DispatchMaterializationFunction) to trigger
   /// materialization of this MaterializationUnit.
@@ -468,6 +472,10 @@ public:
   /// This should only be called if all symbols covered by this query are ready.
   void handleFullyReady();
 
+  /// Returns true if this query was issued by ExecutionSession::speculate,
+  /// i.e. nothing is actually blocked waiting for it.
+  bool isSpeculative() const { return Speculative; }
+
 private:
   void addQueryDependence(JITDylib &JD, SymbolStringPtr Name);
 
@@ -482,9 +490,11 @@ private:
   SymbolsResolvedCallback NotifySymbolsResolved;
   SymbolsReadyCallback NotifySymbolsReady;
   SymbolDependenceMap QueryRegistrations;
+  SymbolDependenceMap BlockedOn;
   SymbolMap ResolvedSymbols;
   size_t NotYetResolvedCount;
   size_t NotYetReadyCount;
+  bool Speculative = false;
 };
 
 /// A symbol table that supports asynchoronous symbol queries.
@@ -635,6 +645,40 @@ private:
 
   using MaterializingInfosMap = DenseMap<SymbolStringPtr, MaterializingInfo>;
 
+  /// A copy of the Symbols table that can be read without holding the
+  /// session lock. It is split into stripes, each guarded by its own
+  /// reader/writer lock, so that concurrent lookups rarely touch the same
+  /// lock.
+  ///
+  /// Writers must hold the session lock. The table has an entry for every
+  /// symbol in the Symbols table, but entries are only updated when a symbol
+  /// is added, becomes ready or is removed: the flags of an entry are only
+  /// meaningful once neither Lazy nor Materializing is set.
+  class ReadySymbolTable {
+  public:
+    void update(const SymbolStringPtr &Name, JITEvaluatedSymbol Sym);
+    void erase(const SymbolStringPtr &Name);
+
+    /// Returns false if Name is not defined. Otherwise sets Sym to the
+    /// symbol's entry.
+    bool find(const SymbolStringPtr &Name, JITEvaluatedSymbol &Sym) const;
+
+  private:
+    static const unsigned NumStripes = 32;
+
+    struct Stripe {
+      mutable sys::RWMutex Mutex;
+      SymbolMap Symbols;
+    };
+
+    Stripe &getStripe(const SymbolStringPtr &Name) const {
+      return Stripes[DenseMapInfo<SymbolStringPtr>::getHashValue(Name) %
+                     NumStripes];
+    }
+
+    mutable Stripe Stripes[NumStripes];
+  };
+
   using LookupImplActionFlags = enum {
     None = 0,
     NotifyFullyResolved = 1 << 0U,
@@ -669,10 +713,18 @@ private:
                                        const SymbolStringPtr &DependantName,
                                        MaterializingInfo &EmittedMI);
 
-  Error defineMaterializing(const SymbolFlagsMap &SymbolFlags);
+  Error defineMaterializing(const SymbolFlagsMap &SymbolFlags, VModuleKey K);
 
   void replace(std::unique_ptr<MaterializationUnit> MU);
 
+  void setSymbolKey(const SymbolStringPtr &Name, VModuleKey K);
+
+  void eraseSymbolKey(const SymbolStringPtr &Name);
+
+  void eraseFromModuleSymbols(const SymbolStringPtr &Name, VModuleKey K);
+
+  SymbolNameSet getSymbolsForModule(VModuleKey K) const;
+
   SymbolNameSet getRequestedSymbols(const SymbolFlagsMap &SymbolFlags) const;
 
   void addDependencies(const SymbolStringPtr &Name,
@@ -684,15 +736,41 @@ private:
 
   void notifyFailed(const SymbolNameSet &FailedSymbols);
 
+  bool lookupReady(const SymbolStringPtr &Name, bool MatchNonExported,
+                   JITEvaluatedSymbol &Sym, bool &Found) const;
+
   ExecutionSession &ES;
   std::string JITDylibName;
   SymbolMap Symbols;
+  ReadySymbolTable ReadySymbols;
   UnmaterializedInfosMap UnmaterializedInfos;
   MaterializingInfosMap MaterializingInfos;
+  DenseMap<SymbolStringPtr, VModuleKey> SymbolKeys;
+  DenseMap<VModuleKey, SymbolNameSet> ModuleSymbols;
   GeneratorFunction DefGenerator;
   JITDylibSearchList SearchOrder;
 };
 
+/// Owns resources (memory, stubs, bookkeeping) that were allocated on behalf
+/// of the modules added to an ExecutionSession.
+///
+/// Layers that hold on to per-module resources after materialization should
+/// register with the ExecutionSession, which will call removeResources when
+/// a module is removed (see ExecutionSession::removeModule).
+class ResourceManager {
+public:
+  virtual ~ResourceManager();
+
+  /// Release all resources associated with the given key. This is only
+  /// called once the symbols defined by the module have been removed from
+  /// their JITDylibs, and must succeed (as a no-op) if there are no resources
+  /// associated with the key.
+  virtual Error removeResources(VModuleKey K) = 0;
+
+private:
+  virtual void anchor();
+};
+
 /// An ExecutionSession represents a running JIT program.
 class ExecutionSession {
   // FIXME: Remove this when we remove the old ORC layers.
@@ -706,6 +784,11 @@ public:
   using DispatchMaterializationFunction = std::function<void(
       JITDylib &JD, std::unique_ptr<MaterializationUnit> MU)>;
 
+  /// For telling a dispatcher that a query is waiting on symbols that were
+  /// already being materialized when the query was issued.
+  using NotifyQueryBlockedFunction =
+      std::function<void(const SymbolDependenceMap &Symbols)>;
+
   /// Construct an ExecutionSession.
   ///
   /// SymbolStringPools may be shared between ExecutionSessions.
@@ -742,6 +825,26 @@ public:
   void releaseVModule(VModuleKey Key) { /* FIXME: Recycle keys */
   }
 
+  /// Register a ResourceManager to be notified when modules are removed.
+  void registerResourceManager(ResourceManager &RM);
+
+  /// Deregister a ResourceManager. This must be called before the resource
+  /// manager is destroyed.
+  void deregisterResourceManager(ResourceManager &RM);
+
+  /// Remove the module with the given key from the JIT.
+  ///
+  /// All symbols whose definitions were provided by a MaterializationUnit
+  /// with key K are removed from their JITDylibs (unmaterialized definitions
+  /// are discarded), then each registered ResourceManager is asked to release
+  /// the resources it holds for K.
+  ///
+  /// If any of the module's symbols are currently being materialized this
+  /// method returns a SymbolsCouldNotBeRemoved error and nothing is removed.
+  /// It is the client's responsibility to ensure that no code from the
+  /// module is still running, and that no other code will call into it.
+  Error removeModule(VModuleKey K);
+
   /// Set the error reporter function.
   ExecutionSession &setErrorReporter(ErrorReporter ReportError) {
     this->ReportError = std::move(ReportError);
@@ -760,6 +863,25 @@ public:
     return *this;
   }
 
+  /// Set the function to call when a query starts waiting on symbols whose
+  /// materialization was dispatched before the query was issued. It is called
+  /// without the session lock held. Dispatchers can use this to raise the
+  /// priority of queued units that a lookup is now blocked on.
+  ExecutionSession &
+  setNotifyQueryBlocked(NotifyQueryBlockedFunction NotifyQueryBlocked) {
+    this->NotifyQueryBlocked = std::move(NotifyQueryBlocked);
+    return *this;
+  }
+
+  /// Set the dispatch function for materializations triggered by speculate.
+  /// If no speculative dispatch function is set, speculate does nothing.
+  ExecutionSession &setDispatchSpeculativeMaterialization(
+      DispatchMaterializationFunction DispatchSpeculativeMaterialization) {
+    this->DispatchSpeculativeMaterialization =
+        std::move(DispatchSpeculativeMaterialization);
+    return *this;
+  }
+
   void legacyFailQuery(AsynchronousSymbolQuery &Q, Error Err);
 
   using LegacyAsyncLookupFunction = std::function<SymbolNameSet(
@@ -798,6 +920,23 @@ public:
               SymbolsResolvedCallback OnResolve, SymbolsReadyCallback OnReady,
               RegisterDependenciesFunction RegisterDependencies);
 
+  /// Start materializing the given symbols ahead of any lookup that needs
+  /// them.
+  ///
+  /// This behaves like an asynchronous lookup with no dependencies to
+  /// register, except that the query is marked speculative and the
+  /// MaterializationUnits it triggers are passed to the speculative dispatch
+  /// function (see setDispatchSpeculativeMaterialization). OnDone is called
+  /// once all symbols are ready, or with an error if any symbol can not be
+  /// found or fails to materialize.
+  ///
+  /// Without a speculative dispatch function the materializers would run
+  /// synchronously on the calling thread, delaying it by as much as the
+  /// speculation could save. In that case nothing is looked up and OnDone is
+  /// called immediately.
+  void speculate(const JITDylibSearchList &SearchOrder, SymbolNameSet Symbols,
+                 SymbolsReadyCallback OnDone);
+
   /// Blocking version of lookup above. Returns the resolved symbol map.
   /// If WaitUntilReady is true (the default), will not return until all
   /// requested symbols are ready (or an error occurs). If WaitUntilReady is
@@ -855,14 +994,26 @@ private:
 
   void runOutstandingMUs();
 
+  bool lookupReady(const JITDylibSearchList &SearchOrder,
+                   const SymbolNameSet &Symbols, SymbolMap &Result);
+
+  void lodgeLookup(const JITDylibSearchList &SearchOrder,
+                   SymbolNameSet Symbols, SymbolsResolvedCallback OnResolve,
+                   SymbolsReadyCallback OnReady,
+                   RegisterDependenciesFunction RegisterDependencies,
+                   bool Speculative);
+
   mutable std::recursive_mutex SessionMutex;
   std::shared_ptr<SymbolStringPool> SSP;
   VModuleKey LastKey = 0;
   ErrorReporter ReportError = logErrorsToStdErr;
   DispatchMaterializationFunction DispatchMaterialization =
       materializeOnCurrentThread;
+  NotifyQueryBlockedFunction NotifyQueryBlocked;
+  DispatchMaterializationFunction DispatchSpeculativeMaterialization;
 
   std::vector<std::unique_ptr<JITDylib>> JDs;
+  std::vector<ResourceManager *> ResourceManagers;
 
   // FIXME: Remove this (and runOutstandingMUs) once the linking layer works
   //        with callbacks from asynchronous queries.
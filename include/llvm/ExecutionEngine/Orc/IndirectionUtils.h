@@ -284,6 +284,13 @@ public:
   /// Change the value of the implementation pointer for the stub.
   virtual Error updatePointer(StringRef Name, JITTargetAddress NewAddr) = 0;
 
+  /// Remove the stub with the given name, making its slot available for
+  ///        reuse by later createStub calls. The stub must not be called after
+  ///        it has been removed.
+  ///
+  ///   The default implementation returns an error: stub removal is optional.
+  virtual Error removeStub(StringRef Name);
+
 private:
   virtual void anchor();
 };
@@ -358,6 +365,17 @@ public:
     return Error::success();
   }
 
+  Error removeStub(StringRef Name) override {
+    std::lock_guard<std::mutex> Lock(StubsMutex);
+    auto I = StubIndexes.find(Name);
+    if (I == StubIndexes.end())
+      return make_error<StringError>("No stub for " + Name,
+                                     inconvertibleErrorCode());
+    FreeStubs.push_back(I->second.first);
+    StubIndexes.erase(I);
+    return Error::success();
+  }
+
 private:
   Error reserveStubs(unsigned NumStubs) {
     if (NumStubs <= FreeStubs.size())
@@ -20,10 +20,11 @@
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
 #include "llvm/ExecutionEngine/Orc/IRTransformLayer.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/ExecutionEngine/Orc/MaterializationDispatcher.h"
 #include "llvm/ExecutionEngine/Orc/ObjectTransformLayer.h"
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
-#include "llvm/Support/ThreadPool.h"
+#include "llvm/ExecutionEngine/Orc/TieredCompileLayer.h"
 
 namespace llvm {
 namespace orc {
@@ -39,9 +40,13 @@ public:
   /// Create an LLJIT instance.
   /// If NumCompileThreads is not equal to zero, creates a multi-threaded
   /// LLJIT with the given number of compile threads.
+  /// If ObjCache is non-null it is queried before each module is compiled and
+  /// notified of each newly compiled object. The cache must outlive the JIT
+  /// and, for multi-threaded instances, be thread-safe (see
+  /// LocalObjectCache).
   static Expected<std::unique_ptr<LLJIT>>
   Create(JITTargetMachineBuilder JTMB, DataLayout DL,
-         unsigned NumCompileThreads = 0);
+         unsigned NumCompileThreads = 0, ObjectCache *ObjCache = nullptr);
 
   /// Returns the ExecutionSession for this instance.
   ExecutionSession &getExecutionSession() { return *ES; }
@@ -60,7 +65,14 @@ public:
   /// Convenience method for defining an
 
   /// Adds an IR module to the given JITDylib.
-  Error addIRModule(JITDylib &JD, ThreadSafeModule TSM);
+  Error addIRModule(JITDylib &JD, ThreadSafeModule TSM) {
+    return addIRModule(JD, std::move(TSM), ES->allocateVModule());
+  }
+
+  /// Adds an IR module to the given JITDylib under key K. K can later be
+  /// passed to removeModule to remove the module's definitions and free the
+  /// memory for its code.
+  Error addIRModule(JITDylib &JD, ThreadSafeModule TSM, VModuleKey K);
 
   /// Adds an IR module to the Main JITDylib.
   Error addIRModule(ThreadSafeModule TSM) {
@@ -68,13 +80,28 @@ public:
   }
 
   /// Adds an object file to the given JITDylib.
-  Error addObjectFile(JITDylib &JD, std::unique_ptr<MemoryBuffer> Obj);
+  Error addObjectFile(JITDylib &JD, std::unique_ptr<MemoryBuffer> Obj) {
+    return addObjectFile(JD, std::move(Obj), ES->allocateVModule());
+  }
+
+  /// Adds an object file to the given JITDylib under key K (see removeModule).
+  Error addObjectFile(JITDylib &JD, std::unique_ptr<MemoryBuffer> Obj,
+                      VModuleKey K);
 
   /// Adds an object file to the given JITDylib.
   Error addObjectFile(std::unique_ptr<MemoryBuffer> Obj) {
     return addObjectFile(Main, std::move(Obj));
   }
 
+  /// Allocate a key to add a module under.
+  VModuleKey allocateVModule() { return ES->allocateVModule(); }
+
+  /// Removes all definitions added under key K and frees the memory for
+  /// their code (see ExecutionSession::removeModule). No code from the module
+  /// may be running, or be called, once this returns. Constructors and
+  /// destructors of the module should be run (if at all) before removing it.
+  Error removeModule(VModuleKey K) { return ES->removeModule(K); }
+
   /// Look up a symbol in JITDylib JD by the symbol's linker-mangled name (to
   /// look up symbols based on their IR name use the lookup function instead).
   Expected<JITEvaluatedSymbol> lookupLinkerMangled(JITDylib &JD,
@@ -106,15 +133,21 @@ public:
   /// Returns a reference to the ObjLinkingLayer
   RTDyldObjectLinkingLayer &getObjLinkingLayer() { return ObjLinkingLayer; }
 
+  /// Returns the dispatcher that runs materializations on the compile
+  /// threads, or null for a single-threaded instance.
+  MaterializationDispatcher *getMaterializationDispatcher() {
+    return CompileThreads.get();
+  }
+
 protected:
 
   /// Create an LLJIT instance with a single compile thread.
   LLJIT(std::unique_ptr<ExecutionSession> ES, std::unique_ptr<TargetMachine> TM,
-        DataLayout DL);
+        DataLayout DL, ObjectCache *ObjCache);
 
   /// Create an LLJIT instance with multiple compile threads.
   LLJIT(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
-        DataLayout DL, unsigned NumCompileThreads);
+        DataLayout DL, unsigned NumCompileThreads, ObjectCache *ObjCache);
 
   std::string mangle(StringRef UnmangledName);
 
@@ -126,7 +159,7 @@ protected:
   JITDylib &Main;
 
   DataLayout DL;
-  std::unique_ptr<ThreadPool> CompileThreads;
+  std::unique_ptr<MaterializationDispatcher> CompileThreads;
 
   RTDyldObjectLinkingLayer ObjLinkingLayer;
   IRCompileLayer CompileLayer;
@@ -139,12 +172,20 @@ protected:
 class LLLazyJIT : public LLJIT {
 public:
 
+  /// Destruct this instance. Waits for all compile threads to complete first,
+  /// since in-flight recompilations refer to the lazy layers.
+  ~LLLazyJIT();
+
   /// Create an LLLazyJIT instance.
   /// If NumCompileThreads is not equal to zero, creates a multi-threaded
   /// LLLazyJIT with the given number of compile threads.
+  /// ObjCache is used as for LLJIT::Create. Lazily compiled functions are
+  /// extracted into modules of their own, and each of these is cached
+  /// separately.
   static Expected<std::unique_ptr<LLLazyJIT>>
   Create(JITTargetMachineBuilder JTMB, DataLayout DL,
-         JITTargetAddress ErrorAddr, unsigned NumCompileThreads = 0);
+         JITTargetAddress ErrorAddr, unsigned NumCompileThreads = 0,
+         ObjectCache *ObjCache = nullptr);
 
   /// Set an IR transform (e.g. pass manager pipeline) to run on each function
   /// when it is compiled.
@@ -158,8 +199,39 @@ public:
     CODLayer.setPartitionFunction(std::move(Partition));
   }
 
+  /// Sets the maximum number of functions that may be speculatively compiled
+  /// at any one time (see CompileOnDemandLayer::setSpeculationLimit).
+  /// Speculative compiles run on the compile threads, so this has no effect
+  /// on single-threaded instances.
+  void setSpeculationLimit(unsigned MaxSpeculativeFunctions) {
+    CODLayer.setSpeculationLimit(MaxSpeculativeFunctions);
+  }
+
+  /// Enable tiered compilation. Functions are first compiled with a compiler
+  /// built from FastJTMB (typically at CodeGenOpt::None with FastISel), and
+  /// recompiled in the background with this instance's own compiler and lazy
+  /// compile transform once they have been called HotThreshold times.
+  /// Only modules added after this call are tiered.
+  ///
+  /// Returns an error for single-threaded instances, which have no compile
+  /// threads to recompile on.
+  Error enableTieredCompilation(JITTargetMachineBuilder FastJTMB,
+                                unsigned HotThreshold);
+
+  /// Returns the number of functions recompiled by tiered compilation so far.
+  unsigned getNumTieredUpFunctions() const {
+    return TieringLayer.getNumTieredUp();
+  }
+
   /// Add a module to be lazily compiled to JITDylib JD.
-  Error addLazyIRModule(JITDylib &JD, ThreadSafeModule M);
+  Error addLazyIRModule(JITDylib &JD, ThreadSafeModule M) {
+    return addLazyIRModule(JD, std::move(M), ES->allocateVModule());
+  }
+
+  /// Add a module to be lazily compiled to JITDylib JD under key K (see
+  /// LLJIT::removeModule). Removing the module also frees the stubs of its
+  /// functions, but not their lazy call-through trampolines.
+  Error addLazyIRModule(JITDylib &JD, ThreadSafeModule M, VModuleKey K);
 
   /// Add a module to be lazily compiled to the main JITDylib.
   Error addLazyIRModule(ThreadSafeModule M) {
@@ -171,12 +243,13 @@ private:
   // Create a single-threaded LLLazyJIT instance.
   LLLazyJIT(std::unique_ptr<ExecutionSession> ES,
             std::unique_ptr<TargetMachine> TM, DataLayout DL,
+            ObjectCache *ObjCache,
             std::unique_ptr<LazyCallThroughManager> LCTMgr,
             std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder);
 
   // Create a multi-threaded LLLazyJIT instance.
   LLLazyJIT(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
-            DataLayout DL, unsigned NumCompileThreads,
+            DataLayout DL, unsigned NumCompileThreads, ObjectCache *ObjCache,
             std::unique_ptr<LazyCallThroughManager> LCTMgr,
             std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder);
 
@@ -184,6 +257,8 @@ private:
   std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder;
 
   IRTransformLayer TransformLayer;
+  std::unique_ptr<IRCompileLayer> FastCompileLayer;
+  TieredCompileLayer TieringLayer;
   CompileOnDemandLayer CODLayer;
 };
 
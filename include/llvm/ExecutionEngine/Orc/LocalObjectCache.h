@@ -0,0 +1,87 @@
+//===- LocalObjectCache.h - Disk-backed object cache for ORC ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that persists compiled objects in a local directory.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Error.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+
+class TargetMachine;
+
+namespace orc {
+
+/// An ObjectCache that stores compiled objects in a directory on disk so that
+/// they can be reused by later processes.
+///
+/// Entries are keyed on a hash of the module's bitcode together with the
+/// target triple, CPU, features and code generation options of the
+/// TargetMachine that the cache was created for, so one directory can safely
+/// be shared by JITs with different configurations. Entries follow the
+/// "llvmcache-" naming scheme of the LTO cache and are size-bounded by
+/// llvm::pruneCache.
+///
+/// getObject and notifyObjectCompiled may be called concurrently, so one
+/// instance can be shared by all the compile threads of a ConcurrentIRCompiler.
+class LocalObjectCache : public ObjectCache {
+public:
+  /// Create a cache in CacheDir for objects produced by TM. The directory is
+  /// created if it does not exist and is pruned according to Policy.
+  static Expected<std::unique_ptr<LocalObjectCache>>
+  Create(StringRef CacheDir, const TargetMachine &TM,
+         CachePruningPolicy Policy = CachePruningPolicy());
+
+  /// Prunes the cache directory according to the pruning policy.
+  ~LocalObjectCache() override;
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+
+  void notifyObjectCompileFailed(const Module *M) override;
+
+  /// Prune the cache directory according to the pruning policy. Returns false
+  /// if the directory could not be pruned.
+  bool prune();
+
+private:
+  LocalObjectCache(std::string CacheDir, std::string TargetKey,
+                   CachePruningPolicy Policy);
+
+  std::string computeKey(const Module &M) const;
+  std::string getEntryPath(StringRef Key) const;
+
+  std::string CacheDir;
+  std::string TargetKey;
+  CachePruningPolicy Policy;
+
+  // Keys of modules that missed in getObject. Code generation may modify the
+  // module before notifyObjectCompiled is called, so the key has to be
+  // computed up front. Entries are dropped once the compile finishes, whether
+  // or not it succeeded, so a later module at the same address never picks up
+  // a stale key.
+  std::mutex PendingKeysMutex;
+  DenseMap<const Module *, std::string> PendingKeys;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
@@ -0,0 +1,158 @@
+//===- MaterializationDispatcher.h - Prioritized MU dispatch ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// A thread-pool based materialization dispatcher that runs units blocking a
+// lookup before speculative ones.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_MATERIALIZATIONDISPATCHER_H
+#define LLVM_EXECUTIONENGINE_ORC_MATERIALIZATIONDISPATCHER_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/Support/ThreadPool.h"
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+namespace llvm {
+
+class raw_ostream;
+
+namespace orc {
+
+/// Runs MaterializationUnits on a pool of compile threads.
+///
+/// Units are queued in one of two tiers. Units dispatched through
+/// dispatch() (the ExecutionSession's dispatch function, see
+/// getDispatchFunction) are materialized because a lookup needs them and are
+/// run first, oldest first. Units dispatched through dispatchSpeculative are
+/// only run when no demanded unit is queued, unless a lookup starts waiting
+/// on one of their symbols while they are queued, in which case they are
+/// promoted to the demanded tier. The session reports such lookups through
+/// the function returned by getNotifyQueryBlockedFunction.
+///
+/// The dispatcher also keeps track of queue depth and of the time each unit
+/// spent queued and materializing.
+class MaterializationDispatcher {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Dispatch statistics.
+  struct Statistics {
+    /// Number of units dispatched, including speculative ones.
+    unsigned NumDispatched = 0;
+    /// Number of units dispatched speculatively.
+    unsigned NumSpeculative = 0;
+    /// Number of speculative units that were promoted because a lookup
+    /// started waiting on them.
+    unsigned NumPromoted = 0;
+    /// Number of units materialized so far.
+    unsigned NumMaterialized = 0;
+    /// Largest number of units queued at any time.
+    unsigned MaxQueueDepth = 0;
+    /// Total and largest time between dispatch and start of materialization.
+    Clock::duration TotalQueueLatency = Clock::duration::zero();
+    Clock::duration MaxQueueLatency = Clock::duration::zero();
+    /// Total and largest time spent materializing a single unit.
+    Clock::duration TotalMaterializeLatency = Clock::duration::zero();
+    Clock::duration MaxMaterializeLatency = Clock::duration::zero();
+  };
+
+  /// Create a dispatcher with NumThreads compile threads.
+  MaterializationDispatcher(unsigned NumThreads);
+
+  /// Waits for all queued units to be materialized.
+  ~MaterializationDispatcher();
+
+  /// Returns a function that can be passed to
+  /// ExecutionSession::setDispatchMaterialization.
+  ExecutionSession::DispatchMaterializationFunction getDispatchFunction() {
+    return [this](JITDylib &JD, std::unique_ptr<MaterializationUnit> MU) {
+      dispatch(JD, std::move(MU));
+    };
+  }
+
+  /// Returns a function that can be passed to
+  /// ExecutionSession::setNotifyQueryBlocked.
+  ExecutionSession::NotifyQueryBlockedFunction
+  getNotifyQueryBlockedFunction() {
+    return [this](const SymbolDependenceMap &Symbols) {
+      notifyQueryBlocked(Symbols);
+    };
+  }
+
+  /// Returns a function that can be passed to
+  /// ExecutionSession::setDispatchSpeculativeMaterialization.
+  ExecutionSession::DispatchMaterializationFunction
+  getSpeculativeDispatchFunction() {
+    return [this](JITDylib &JD, std::unique_ptr<MaterializationUnit> MU) {
+      dispatchSpeculative(JD, std::move(MU));
+    };
+  }
+
+  /// Queue MU for materialization because a lookup needs one of its symbols.
+  void dispatch(JITDylib &JD, std::unique_ptr<MaterializationUnit> MU) {
+    enqueue(JD, std::move(MU), false);
+  }
+
+  /// Queue MU for speculative materialization.
+  void dispatchSpeculative(JITDylib &JD,
+                           std::unique_ptr<MaterializationUnit> MU) {
+    enqueue(JD, std::move(MU), true);
+  }
+
+  /// Promote any queued speculative unit that provides one of the given
+  /// symbols, because a lookup is waiting on it.
+  void notifyQueryBlocked(const SymbolDependenceMap &Symbols);
+
+  /// Block until all queued units have been materialized.
+  void wait();
+
+  /// Returns the number of units that are queued but not yet running.
+  size_t getQueueDepth() const;
+
+  /// Returns a snapshot of the dispatch statistics.
+  Statistics getStatistics() const;
+
+  /// Print the dispatch statistics to OS.
+  void printStatistics(raw_ostream &OS) const;
+
+private:
+  struct QueuedUnit {
+    JITDylib *JD;
+    std::unique_ptr<MaterializationUnit> MU;
+    Clock::time_point DispatchTime;
+  };
+
+  void enqueue(JITDylib &JD, std::unique_ptr<MaterializationUnit> MU,
+               bool Speculative);
+  void forgetSpeculativeSymbols(const QueuedUnit &QU);
+  std::shared_ptr<QueuedUnit> takeNextUnit();
+  void runNextUnit();
+
+  mutable std::mutex QueueMutex;
+  std::deque<std::shared_ptr<QueuedUnit>> DemandedUnits;
+  std::deque<std::shared_ptr<QueuedUnit>> SpeculativeUnits;
+  // The units in SpeculativeUnits, by symbol.
+  DenseMap<JITDylib *, DenseMap<SymbolStringPtr, QueuedUnit *>>
+      SpeculativeSymbols;
+  Statistics Stats;
+
+  // Each queued unit gets one pool task, but a task runs whichever queued unit
+  // has the highest priority when it starts, not necessarily the one it was
+  // created for.
+  ThreadPool CompileThreads;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_MATERIALIZATIONDISPATCHER_H
@@ -36,7 +36,8 @@ enum class OrcErrorCode : int {
   UnexpectedRPCCall,
   UnexpectedRPCResponse,
   UnknownErrorCodeFromRemote,
-  UnknownResourceHandle
+  UnknownResourceHandle,
+  RemoteSharedMemoryUnavailable
 };
 
 std::error_code orcError(OrcErrorCode ErrCode);
@@ -27,6 +27,7 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Memory.h"
@@ -34,7 +35,9 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -63,6 +66,8 @@ public:
   public:
     ~RemoteRTDyldMemoryManager() {
       Client.destroyRemoteAllocator(Id);
+      for (auto &Block : SharedBlocks)
+        Client.releaseSharedMem(Block);
       LLVM_DEBUG(dbgs() << "Destroyed remote allocator " << Id << "\n");
     }
 
@@ -75,7 +80,11 @@ public:
     uint8_t *allocateCodeSection(uintptr_t Size, unsigned Alignment,
                                  unsigned SectionID,
                                  StringRef SectionName) override {
-      Unmapped.back().CodeAllocs.emplace_back(Size, Alignment);
+      if (Unmapped.back().Shared)
+        allocateShared(Unmapped.back().CodeAllocs, Unmapped.back().SharedCode,
+                       Size, Alignment);
+      else
+        Unmapped.back().CodeAllocs.emplace_back(Size, Alignment);
       uint8_t *Alloc = reinterpret_cast<uint8_t *>(
           Unmapped.back().CodeAllocs.back().getLocalAddress());
       LLVM_DEBUG(dbgs() << "Allocator " << Id << " allocated code for "
@@ -88,7 +97,11 @@ public:
                                  unsigned SectionID, StringRef SectionName,
                                  bool IsReadOnly) override {
       if (IsReadOnly) {
-        Unmapped.back().RODataAllocs.emplace_back(Size, Alignment);
+        if (Unmapped.back().Shared)
+          allocateShared(Unmapped.back().RODataAllocs,
+                         Unmapped.back().SharedROData, Size, Alignment);
+        else
+          Unmapped.back().RODataAllocs.emplace_back(Size, Alignment);
         uint8_t *Alloc = reinterpret_cast<uint8_t *>(
             Unmapped.back().RODataAllocs.back().getLocalAddress());
         LLVM_DEBUG(dbgs() << "Allocator " << Id << " allocated ro-data for "
@@ -97,7 +110,11 @@ public:
         return Alloc;
       } // else...
 
-      Unmapped.back().RWDataAllocs.emplace_back(Size, Alignment);
+      if (Unmapped.back().Shared)
+        allocateShared(Unmapped.back().RWDataAllocs,
+                       Unmapped.back().SharedRWData, Size, Alignment);
+      else
+        Unmapped.back().RWDataAllocs.emplace_back(Size, Alignment);
       uint8_t *Alloc = reinterpret_cast<uint8_t *>(
           Unmapped.back().RWDataAllocs.back().getLocalAddress());
       LLVM_DEBUG(dbgs() << "Allocator " << Id << " allocated rw-data for "
@@ -112,6 +129,10 @@ public:
                                 uint32_t RWDataAlign) override {
       Unmapped.push_back(ObjectAllocs());
 
+      if (Client.SharedMem &&
+          reserveSharedSpace(CodeSize, RODataSize, RWDataSize))
+        return;
+
       LLVM_DEBUG(dbgs() << "Allocator " << Id << " reserved:\n");
 
       if (CodeSize != 0) {
@@ -182,14 +203,16 @@ public:
 
       for (auto &ObjAllocs : Unfinalized) {
         if (copyAndProtect(ObjAllocs.CodeAllocs, ObjAllocs.RemoteCodeAddr,
+                           ObjAllocs.SharedCode,
                            sys::Memory::MF_READ | sys::Memory::MF_EXEC))
           return true;
 
         if (copyAndProtect(ObjAllocs.RODataAllocs, ObjAllocs.RemoteRODataAddr,
-                           sys::Memory::MF_READ))
+                           ObjAllocs.SharedROData, sys::Memory::MF_READ))
           return true;
 
         if (copyAndProtect(ObjAllocs.RWDataAllocs, ObjAllocs.RemoteRWDataAddr,
+                           ObjAllocs.SharedRWData,
                            sys::Memory::MF_READ | sys::Memory::MF_WRITE))
           return true;
       }
@@ -219,6 +242,10 @@ public:
       Alloc(uint64_t Size, unsigned Align)
           : Size(Size), Align(Align), Contents(new char[Size + Align - 1]) {}
 
+      /// Create an allocation at SharedAddr, in memory shared with the remote.
+      Alloc(uint64_t Size, unsigned Align, char *SharedAddr)
+          : Size(Size), Align(Align), SharedAddr(SharedAddr) {}
+
       Alloc(const Alloc &) = delete;
       Alloc &operator=(const Alloc &) = delete;
       Alloc(Alloc &&) = default;
@@ -228,7 +255,11 @@ public:
 
       unsigned getAlign() const { return Align; }
 
+      bool isShared() const { return SharedAddr != nullptr; }
+
       char *getLocalAddress() const {
+        if (SharedAddr)
+          return SharedAddr;
         uintptr_t LocalAddr = reinterpret_cast<uintptr_t>(Contents.get());
         LocalAddr = alignTo(LocalAddr, Align);
         return reinterpret_cast<char *>(LocalAddr);
@@ -244,6 +275,7 @@ public:
       uint64_t Size;
       unsigned Align;
       std::unique_ptr<char[]> Contents;
+      char *SharedAddr = nullptr;
       JITTargetAddress RemoteAddr = 0;
     };
 
@@ -258,6 +290,11 @@ public:
       JITTargetAddress RemoteRODataAddr = 0;
       JITTargetAddress RemoteRWDataAddr = 0;
       std::vector<Alloc> CodeAllocs, RODataAllocs, RWDataAllocs;
+
+      // Set if the object's sections are placed directly in memory shared
+      // with the remote, in the blocks below, rather than copied.
+      bool Shared = false;
+      sys::MemoryBlock SharedCode, SharedROData, SharedRWData;
     };
 
     RemoteRTDyldMemoryManager(OrcRemoteTargetClient &Client,
@@ -266,11 +303,81 @@ public:
       LLVM_DEBUG(dbgs() << "Created remote allocator " << Id << "\n");
     }
 
+    // Reserves one block of shared memory per non-empty segment of the object
+    // being loaded. Returns false, without reserving anything, if the shared
+    // memory is too full.
+    bool reserveSharedSpace(uint64_t CodeSize, uint64_t RODataSize,
+                            uint64_t RWDataSize) {
+      auto &ObjAllocs = Unmapped.back();
+      bool Reserved = Client.reserveSharedMem(CodeSize, ObjAllocs.SharedCode) &&
+                      Client.reserveSharedMem(RODataSize,
+                                              ObjAllocs.SharedROData) &&
+                      Client.reserveSharedMem(RWDataSize,
+                                              ObjAllocs.SharedRWData);
+      for (auto *Block : {&ObjAllocs.SharedCode, &ObjAllocs.SharedROData,
+                          &ObjAllocs.SharedRWData}) {
+        if (!Block->base())
+          continue;
+        if (Reserved)
+          SharedBlocks.push_back(*Block);
+        else {
+          Client.releaseSharedMem(*Block);
+          *Block = sys::MemoryBlock();
+        }
+      }
+      if (!Reserved) {
+        LLVM_DEBUG(dbgs() << "Allocator " << Id
+                          << " falling back to copying: shared memory full\n");
+        return false;
+      }
+
+      ObjAllocs.Shared = true;
+      ObjAllocs.RemoteCodeAddr = Client.getSharedRemoteAddress(
+          ObjAllocs.SharedCode.base());
+      ObjAllocs.RemoteRODataAddr = Client.getSharedRemoteAddress(
+          ObjAllocs.SharedROData.base());
+      ObjAllocs.RemoteRWDataAddr = Client.getSharedRemoteAddress(
+          ObjAllocs.SharedRWData.base());
+
+      LLVM_DEBUG(dbgs() << "Allocator " << Id << " reserved shared:\n"
+                        << "  code: " << ObjAllocs.SharedCode.base() << " -> "
+                        << format("0x%016" PRIx64, ObjAllocs.RemoteCodeAddr)
+                        << " (" << CodeSize << " bytes)\n"
+                        << "  ro-data: " << ObjAllocs.SharedROData.base()
+                        << " -> "
+                        << format("0x%016" PRIx64, ObjAllocs.RemoteRODataAddr)
+                        << " (" << RODataSize << " bytes)\n"
+                        << "  rw-data: " << ObjAllocs.SharedRWData.base()
+                        << " -> "
+                        << format("0x%016" PRIx64, ObjAllocs.RemoteRWDataAddr)
+                        << " (" << RWDataSize << " bytes)\n");
+      return true;
+    }
+
+    // Places a section after the previous one in the shared block reserved
+    // for its segment.
+    void allocateShared(std::vector<Alloc> &Allocs,
+                        const sys::MemoryBlock &Block, uintptr_t Size,
+                        unsigned Alignment) {
+      uintptr_t Addr = reinterpret_cast<uintptr_t>(Block.base());
+      if (!Allocs.empty())
+        Addr = reinterpret_cast<uintptr_t>(Allocs.back().getLocalAddress()) +
+               Allocs.back().getSize();
+      Addr = alignTo(Addr, Alignment);
+      assert(Addr + Size <=
+                 reinterpret_cast<uintptr_t>(Block.base()) + Block.size() &&
+             "Section does not fit in the reserved shared memory");
+      Allocs.emplace_back(Size, Alignment, reinterpret_cast<char *>(Addr));
+    }
+
     // Maps all allocations in Allocs to aligned blocks
     void mapAllocsToRemoteAddrs(RuntimeDyld &Dyld, std::vector<Alloc> &Allocs,
                                 JITTargetAddress NextAddr) {
       for (auto &Alloc : Allocs) {
-        NextAddr = alignTo(NextAddr, Alloc.getAlign());
+        if (Alloc.isShared())
+          NextAddr = Client.getSharedRemoteAddress(Alloc.getLocalAddress());
+        else
+          NextAddr = alignTo(NextAddr, Alloc.getAlign());
         Dyld.mapSectionAddress(Alloc.getLocalAddress(), NextAddr);
         LLVM_DEBUG(
             dbgs() << "     " << static_cast<void *>(Alloc.getLocalAddress())
@@ -288,10 +395,22 @@ public:
     // segment.
     bool copyAndProtect(const std::vector<Alloc> &Allocs,
                         JITTargetAddress RemoteSegmentAddr,
+                        const sys::MemoryBlock &SharedSegment,
                         unsigned Permissions) {
       if (RemoteSegmentAddr) {
         assert(!Allocs.empty() && "No sections in allocated segment");
 
+        // Sections in shared memory were written in place: only the
+        // permissions need to be set.
+        if (SharedSegment.base()) {
+          LLVM_DEBUG(dbgs() << "  setting permissions on shared block: "
+                            << format("0x%016" PRIx64, RemoteSegmentAddr)
+                            << " (" << SharedSegment.size() << " bytes)\n");
+          return Client.setSharedProtections(RemoteSegmentAddr,
+                                             SharedSegment.size(),
+                                             Permissions);
+        }
+
         for (auto &Alloc : Allocs) {
           LLVM_DEBUG(dbgs() << "  copying section: "
                             << static_cast<void *>(Alloc.getLocalAddress())
@@ -321,6 +440,7 @@ public:
     ResourceIdMgr::ResourceId Id;
     std::vector<ObjectAllocs> Unmapped;
     std::vector<ObjectAllocs> Unfinalized;
+    std::vector<sys::MemoryBlock> SharedBlocks;
 
     struct EHFrame {
       JITTargetAddress Addr;
@@ -578,6 +698,34 @@ public:
     return callB<utils::GetSymbolAddress>(Name);
   }
 
+  /// Place the sections of objects loaded from now on directly in memory
+  /// shared with the remote, so that only control messages go over the
+  /// channel. FD must be a file descriptor for a file of at least Size bytes
+  /// (e.g. a memfd) that the remote process can access under the descriptor
+  /// it was given with OrcRemoteTargetServer::enableSharedMemory. Objects that
+  /// do not fit in the remaining shared memory are copied as before.
+  Error enableSharedMemory(int FD, uint64_t Size) {
+    assert(!SharedMem && "Shared memory already enabled");
+    std::error_code EC;
+    auto Mapping = llvm::make_unique<sys::fs::mapped_file_region>(
+        FD, sys::fs::mapped_file_region::readwrite, Size, 0, EC);
+    if (EC)
+      return errorCodeToError(EC);
+
+    auto RemoteAddrOrErr = callB<mem::MapSharedMem>(Size);
+    if (!RemoteAddrOrErr)
+      return RemoteAddrOrErr.takeError();
+
+    LLVM_DEBUG(dbgs() << "Shared " << Size << " bytes: "
+                      << static_cast<void *>(Mapping->data()) << " -> "
+                      << format("0x%016" PRIx64, *RemoteAddrOrErr) << "\n");
+    SharedMem = std::move(Mapping);
+    SharedMemRemoteAddr = *RemoteAddrOrErr;
+    std::lock_guard<std::mutex> Lock(SharedMemMutex);
+    SharedMemFreeRanges[0] = alignDown(Size, RemotePageSize);
+    return Error::success();
+  }
+
   /// Get the triple for the remote target.
   const std::string &getTargetTriple() const { return RemoteTargetTriple; }
 
@@ -681,6 +829,70 @@ private:
     return callB<mem::WritePtr>(Addr, PtrVal);
   }
 
+  // Takes a page-aligned block of at least Size bytes from the shared memory,
+  // first fit. A Size of zero gives an empty block.
+  bool reserveSharedMem(uint64_t Size, sys::MemoryBlock &Block) {
+    Block = sys::MemoryBlock();
+    if (Size == 0)
+      return true;
+
+    Size = alignTo(Size, RemotePageSize);
+    std::lock_guard<std::mutex> Lock(SharedMemMutex);
+    auto I = find_if(SharedMemFreeRanges,
+                     [&](const std::pair<const uint64_t, uint64_t> &Range) {
+                       return Range.second >= Size;
+                     });
+    if (I == SharedMemFreeRanges.end())
+      return false;
+
+    uint64_t Offset = I->first;
+    uint64_t Available = I->second;
+    SharedMemFreeRanges.erase(I);
+    if (Available > Size)
+      SharedMemFreeRanges[Offset + Size] = Available - Size;
+    Block = sys::MemoryBlock(SharedMem->data() + Offset, Size);
+    return true;
+  }
+
+  // Returns a block to the shared memory, merging it with its free
+  // neighbours.
+  void releaseSharedMem(const sys::MemoryBlock &Block) {
+    uint64_t Offset = static_cast<char *>(Block.base()) - SharedMem->data();
+    uint64_t Size = Block.size();
+
+    std::lock_guard<std::mutex> Lock(SharedMemMutex);
+    auto Next = SharedMemFreeRanges.lower_bound(Offset);
+    if (Next != SharedMemFreeRanges.end() && Offset + Size == Next->first) {
+      Size += Next->second;
+      Next = SharedMemFreeRanges.erase(Next);
+    }
+    if (Next != SharedMemFreeRanges.begin()) {
+      auto Prev = std::prev(Next);
+      if (Prev->first + Prev->second == Offset) {
+        Prev->second += Size;
+        return;
+      }
+    }
+    SharedMemFreeRanges[Offset] = Size;
+  }
+
+  JITTargetAddress getSharedRemoteAddress(const void *LocalAddr) const {
+    if (!LocalAddr)
+      return 0;
+    return SharedMemRemoteAddr +
+           (static_cast<const char *>(LocalAddr) - SharedMem->data());
+  }
+
+  bool setSharedProtections(JITTargetAddress RemoteAddr, uint64_t Size,
+                            unsigned ProtFlags) {
+    if (auto Err =
+            callB<mem::SetSharedProtections>(RemoteAddr, Size, ProtFlags)) {
+      ES.reportError(std::move(Err));
+      return true;
+    }
+    return false;
+  }
+
   static Error doNothing() { return Error::success(); }
 
   ExecutionSession &ES;
@@ -692,6 +904,15 @@ private:
   uint32_t RemoteIndirectStubSize = 0;
   ResourceIdMgr AllocatorIds, IndirectStubOwnerIds;
   Optional<RemoteCompileCallbackManager> CallbackManager;
+
+  // Memory shared with the remote, if enabled, with the address it is mapped
+  // at there and its free ranges (offset -> size). Every memory manager
+  // reserves and releases blocks, possibly from different compile threads,
+  // so the free ranges are guarded by SharedMemMutex.
+  std::unique_ptr<sys::fs::mapped_file_region> SharedMem;
+  JITTargetAddress SharedMemRemoteAddr = 0;
+  std::mutex SharedMemMutex;
+  std::map<uint64_t, uint64_t> SharedMemFreeRanges;
 };
 
 } // end namespace remote
@@ -275,6 +275,24 @@ namespace mem {
     static const char *getName() { return "WritePtr"; }
   };
 
+  /// Map the memory shared between the client and the remote (see
+  /// OrcRemoteTargetClient::enableSharedMemory) into the remote's address
+  /// space. Returns the address it was mapped at.
+  class MapSharedMem
+      : public rpc::Function<MapSharedMem, JITTargetAddress(uint64_t Size)> {
+  public:
+    static const char *getName() { return "MapSharedMem"; }
+  };
+
+  /// Set the memory protection on a page-aligned range of shared memory.
+  class SetSharedProtections
+      : public rpc::Function<SetSharedProtections,
+                             void(JITTargetAddress Dst, uint64_t Size,
+                                  uint32_t ProtFlags)> {
+  public:
+    static const char *getName() { return "SetSharedProtections"; }
+  };
+
 } // end namespace mem
 
 /// RPC functions for remote stub and trampoline management.
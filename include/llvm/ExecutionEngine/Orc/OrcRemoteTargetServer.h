@@ -20,6 +20,7 @@
 #include "llvm/ExecutionEngine/Orc/OrcRemoteTargetRPCAPI.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/Memory.h"
@@ -74,6 +75,9 @@ public:
     addHandler<mem::SetProtections>(*this, &ThisT::handleSetProtections);
     addHandler<mem::WriteMem>(*this, &ThisT::handleWriteMem);
     addHandler<mem::WritePtr>(*this, &ThisT::handleWritePtr);
+    addHandler<mem::MapSharedMem>(*this, &ThisT::handleMapSharedMem);
+    addHandler<mem::SetSharedProtections>(*this,
+                                          &ThisT::handleSetSharedProtections);
     addHandler<eh::RegisterEHFrames>(*this, &ThisT::handleRegisterEHFrames);
     addHandler<eh::DeregisterEHFrames>(*this, &ThisT::handleDeregisterEHFrames);
     addHandler<stubs::CreateIndirectStubsOwner>(
@@ -104,6 +108,12 @@ public:
 
   bool receivedTerminate() const { return TerminateFlag; }
 
+  /// Allow the client to place code and data directly in the memory shared
+  /// with it through the file descriptor FD (e.g. a memfd inherited from the
+  /// client process), instead of sending it over the channel. The file is
+  /// mapped when the client asks for it; FD must stay open until then.
+  void enableSharedMemory(int FD) { SharedMemFD = FD; }
+
 private:
   struct Allocator {
     Allocator() = default;
@@ -395,6 +405,44 @@ private:
     return AllocAddr;
   }
 
+  Expected<JITTargetAddress> handleMapSharedMem(uint64_t Size) {
+    if (SharedMemFD < 0 || SharedMem)
+      return errorCodeToError(
+               orcError(OrcErrorCode::RemoteSharedMemoryUnavailable));
+
+    std::error_code EC;
+    auto Mapping = llvm::make_unique<sys::fs::mapped_file_region>(
+        SharedMemFD, sys::fs::mapped_file_region::readwrite, Size, 0, EC);
+    if (EC)
+      return errorCodeToError(EC);
+    SharedMem = std::move(Mapping);
+
+    LLVM_DEBUG(dbgs() << "  Mapped " << Size << " bytes of shared memory at "
+                      << static_cast<void *>(SharedMem->data()) << "\n");
+
+    return static_cast<JITTargetAddress>(
+        reinterpret_cast<uintptr_t>(SharedMem->data()));
+  }
+
+  Error handleSetSharedProtections(JITTargetAddress Addr, uint64_t Size,
+                                   uint32_t Flags) {
+    char *LocalAddr = reinterpret_cast<char *>(static_cast<uintptr_t>(Addr));
+    if (!SharedMem || LocalAddr < SharedMem->data() ||
+        Size > SharedMem->size() ||
+        static_cast<uint64_t>(LocalAddr - SharedMem->data()) >
+            SharedMem->size() - Size)
+      return errorCodeToError(
+               orcError(OrcErrorCode::RemoteMProtectAddrUnrecognized));
+    LLVM_DEBUG(dbgs() << "  Set shared memory permissions on "
+                      << static_cast<void *>(LocalAddr) << " (" << Size
+                      << " bytes) to "
+                      << (Flags & sys::Memory::MF_READ ? 'R' : '-')
+                      << (Flags & sys::Memory::MF_WRITE ? 'W' : '-')
+                      << (Flags & sys::Memory::MF_EXEC ? 'X' : '-') << "\n");
+    return errorCodeToError(sys::Memory::protectMappedMemory(
+        sys::MemoryBlock(LocalAddr, Size), Flags));
+  }
+
   Error handleSetProtections(ResourceIdMgr::ResourceId Id,
                              JITTargetAddress Addr, uint32_t Flags) {
     auto I = Allocators.find(Id);
@@ -438,6 +486,8 @@ private:
   std::map<ResourceIdMgr::ResourceId, ISBlockOwnerList> IndirectStubsOwners;
   sys::OwningMemoryBlock ResolverBlock;
   std::vector<sys::OwningMemoryBlock> TrampolineBlocks;
+  int SharedMemFD = -1;
+  std::unique_ptr<sys::fs::mapped_file_region> SharedMem;
   bool TerminateFlag = false;
 };
 
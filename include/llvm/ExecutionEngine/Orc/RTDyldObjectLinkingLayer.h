@@ -28,6 +28,7 @@
 #include <cassert>
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -36,7 +37,7 @@
 namespace llvm {
 namespace orc {
 
-class RTDyldObjectLinkingLayer : public ObjectLayer {
+class RTDyldObjectLinkingLayer : public ObjectLayer, public ResourceManager {
 public:
   /// Functor for receiving object-loaded notifications.
   using NotifyLoadedFunction =
@@ -56,6 +57,8 @@ public:
       NotifyLoadedFunction NotifyLoaded = NotifyLoadedFunction(),
       NotifyEmittedFunction NotifyEmitted = NotifyEmittedFunction());
 
+  ~RTDyldObjectLinkingLayer() override;
+
   /// Emit the object.
   void emit(MaterializationResponsibility R,
             std::unique_ptr<MemoryBuffer> O) override;
@@ -71,6 +74,17 @@ public:
     return *this;
   }
 
+  /// Set the 'ResolveRelocationsInParallel' flag.
+  ///
+  /// If set to true, the relocations of each object are resolved on multiple
+  /// threads where RuntimeDyld supports it (see
+  /// RuntimeDyld::setResolveRelocationsInParallel).
+  RTDyldObjectLinkingLayer &
+  setResolveRelocationsInParallel(bool ResolveRelocationsInParallel) {
+    this->ResolveRelocationsInParallel = ResolveRelocationsInParallel;
+    return *this;
+  }
+
   /// Instructs this RTDyldLinkingLayer2 instance to override the symbol flags
   /// returned by RuntimeDyld for any given object file with the flags supplied
   /// by the MaterializationResponsibility instance. This is a workaround to
@@ -102,6 +116,11 @@ public:
     return *this;
   }
 
+  /// Deregisters the EH frames of, and destroys, the memory managers of all
+  /// objects emitted with key K, freeing their memory. Called by the
+  /// ExecutionSession when the module is removed.
+  Error removeResources(VModuleKey K) override;
+
 private:
   Error onObjLoad(VModuleKey K, MaterializationResponsibility &R,
                   object::ObjectFile &Obj,
@@ -116,9 +135,12 @@ private:
   NotifyLoadedFunction NotifyLoaded;
   NotifyEmittedFunction NotifyEmitted;
   bool ProcessAllSections = false;
+  bool ResolveRelocationsInParallel = false;
   bool OverrideObjectFlags = false;
   bool AutoClaimObjectSymbols = false;
-  std::vector<std::unique_ptr<RuntimeDyld::MemoryManager>> MemMgrs;
+  std::map<VModuleKey,
+           std::vector<std::unique_ptr<RuntimeDyld::MemoryManager>>>
+      MemMgrs;
 };
 
 class LegacyRTDyldObjectLinkingLayerBase {
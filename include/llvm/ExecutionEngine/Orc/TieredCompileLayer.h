@@ -0,0 +1,125 @@
+//===- TieredCompileLayer.h - Recompile hot functions -----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// An IR layer that compiles functions quickly at first, then recompiles the
+// ones that turn out to be hot with a slower, optimizing layer.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
+#define LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/Orc/Layer.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace llvm {
+
+class Function;
+
+namespace orc {
+
+/// Two-tier IR compile layer.
+///
+///   Until enableTiering is called, modules are passed straight through to
+/// the optimizing layer. Once tiering is enabled, each function is first
+/// emitted to the fast layer with a counter that is incremented on every
+/// call. When a function's counter reaches the hot threshold, a copy of the
+/// original (uninstrumented) function is compiled by the optimizing layer in
+/// the background, under the name <function>.tier1, and the redirect function
+/// is called to point callers at the new body.
+///
+///   Hot functions are only redirected, not removed: calls that are already
+/// executing, or that reach the tier-0 body directly, keep running tier-0
+/// code. This layer is intended to sit below a CompileOnDemandLayer, whose
+/// stubs every call goes through (see CompileOnDemandLayer::redirect).
+///
+///   Functions are recompiled in a module of their own, so modules that
+/// still contain local symbols (e.g. whole modules emitted by a
+/// CompileOnDemandLayer using compileWholeModule) can not be tiered, and are
+/// emitted to the optimizing layer directly.
+class TieredCompileLayer : public IRLayer, public ResourceManager {
+public:
+  /// Called with the implementation JITDylib, the linker-mangled name of a hot
+  /// function and the address of its optimized body.
+  using RedirectFunction = std::function<Error(
+      JITDylib &JD, const SymbolStringPtr &Name, JITTargetAddress NewAddr)>;
+
+  /// Construct a TieredCompileLayer. Modules are emitted to OptimizingLayer
+  /// until enableTiering is called.
+  TieredCompileLayer(ExecutionSession &ES, IRLayer &OptimizingLayer,
+                     RedirectFunction Redirect);
+
+  ~TieredCompileLayer() override;
+
+  /// Emit functions to FastLayer first, and recompile them with the
+  /// optimizing layer once they have been called HotThreshold times. This
+  /// only affects modules emitted after the call.
+  ///
+  /// Recompilation is requested with ExecutionSession::speculate, so clients
+  /// should set a (speculative) dispatch function that runs materialization
+  /// on compile threads; otherwise hot functions are recompiled on the
+  /// JIT'd program's thread when they cross the threshold.
+  void enableTiering(IRLayer &FastLayer, unsigned HotThreshold);
+
+  /// Returns the number of functions that have been recompiled by the
+  /// optimizing layer.
+  unsigned getNumTieredUp() const { return NumTieredUp; }
+
+  /// Emits the given module. This should not be called by clients: it will be
+  /// called by the JIT when a definition added via the add method is requested.
+  void emit(MaterializationResponsibility R, ThreadSafeModule TSM) override;
+
+  /// Forgets the functions of the module with key K, along with the source
+  /// copies kept for them. Called by the ExecutionSession when the module is
+  /// removed.
+  Error removeResources(VModuleKey K) override;
+
+private:
+  friend class TierUpMaterializationUnit;
+
+  struct TieredFunction {
+    VModuleKey K;
+    JITDylib *ImplD;
+    std::string IRName;
+    SymbolStringPtr Name;
+    SymbolStringPtr Tier1Name;
+    // An uninstrumented copy of the module the function was emitted in, shared
+    // between all functions of that module. Null for functions that are not
+    // (or no longer) known to the layer.
+    std::shared_ptr<ThreadSafeModule> Source;
+  };
+
+  static void tierUpEntry(TieredCompileLayer *Layer, uint64_t FunctionId);
+
+  void instrument(Function &F, uint64_t FunctionId);
+  void tierUp(uint64_t FunctionId);
+  void emitOptimized(MaterializationResponsibility R, uint64_t FunctionId);
+  TieredFunction getTieredFunction(uint64_t FunctionId);
+
+  IRLayer &OptimizingLayer;
+  IRLayer *FastLayer = nullptr;
+  RedirectFunction Redirect;
+  unsigned HotThreshold = 0;
+
+  std::mutex TieredFunctionsMutex;
+  uint64_t NextFunctionId = 0;
+  DenseMap<uint64_t, TieredFunction> TieredFunctions;
+  DenseMap<VModuleKey, std::vector<uint64_t>> ModuleFunctionIds;
+  std::atomic<unsigned> NumTieredUp{0};
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
@@ -230,6 +230,19 @@ public:
     this->ProcessAllSections = ProcessAllSections;
   }
 
+  /// Passing 'true' to this method allows RuntimeDyld to resolve relocations
+  /// that target different sections on separate threads, for targets whose
+  /// relocation processing supports it (currently x86-64 and AArch64 ELF, and
+  /// x86-64 MachO). This only pays off for objects with many thousands of
+  /// relocations.
+  ///
+  /// Must be called before the first object file is loaded.
+  void setResolveRelocationsInParallel(bool ResolveRelocationsInParallel) {
+    assert(!Dyld && "setResolveRelocationsInParallel must be called before "
+                    "loadObject.");
+    this->ResolveRelocationsInParallel = ResolveRelocationsInParallel;
+  }
+
   /// Perform all actions needed to make the code owned by this RuntimeDyld
   /// instance executable:
   ///
@@ -254,7 +267,7 @@ private:
   jitLinkForORC(object::ObjectFile &Obj,
                 std::unique_ptr<MemoryBuffer> UnderlyingBuffer,
                 RuntimeDyld::MemoryManager &MemMgr, JITSymbolResolver &Resolver,
-                bool ProcessAllSections,
+                bool ProcessAllSections, bool ResolveRelocationsInParallel,
                 std::function<Error(std::unique_ptr<LoadedObjectInfo>,
                                     std::map<StringRef, JITEvaluatedSymbol>)>
                     OnLoaded,
@@ -266,6 +279,7 @@ private:
   MemoryManager &MemMgr;
   JITSymbolResolver &Resolver;
   bool ProcessAllSections;
+  bool ResolveRelocationsInParallel;
   RuntimeDyldCheckerImpl *Checker;
 };
 
@@ -279,6 +293,7 @@ void jitLinkForORC(object::ObjectFile &Obj,
                    std::unique_ptr<MemoryBuffer> UnderlyingBuffer,
                    RuntimeDyld::MemoryManager &MemMgr,
                    JITSymbolResolver &Resolver, bool ProcessAllSections,
+                   bool ResolveRelocationsInParallel,
                    std::function<Error(std::unique_ptr<LoadedObjectInfo>,
                                        std::map<StringRef, JITEvaluatedSymbol>)>
                        OnLoaded,
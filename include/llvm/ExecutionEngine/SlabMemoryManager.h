@@ -0,0 +1,199 @@
+//===- SlabMemoryManager.h - Slab-based memory manager for RtDyld -*- C++ -*-=//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares a memory manager that packs the sections of many
+// objects into a few large slabs of memory.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_SLABMEMORYMANAGER_H
+#define LLVM_EXECUTIONENGINE_SLABMEMORYMANAGER_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ExecutionEngine/RTDyldMemoryManager.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/Support/Memory.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace llvm {
+
+/// A memory manager that allocates section memory from large, shared slabs.
+///
+/// SectionMemoryManager maps fresh pages for (nearly) every object and changes
+/// permissions one section at a time, which scatters JIT'd code across the
+/// address space. SlabMemoryManager instead reserves address space in large
+/// slabs, one set per purpose (code, read-only data, read-write data), owned
+/// by a SlabPool that many memory managers can share: with the ORC
+/// RTDyldObjectLinkingLayer, which creates a memory manager per object, the
+/// code of all objects then ends up packed into the same few slabs.
+///
+/// Each memory manager takes one contiguous, page-aligned block per purpose
+/// from the pool, sized by RuntimeDyld's reserveAllocationSpace call, so that
+/// finalizeMemory needs at most one permission change for code and one for
+/// read-only data. When a memory manager is destroyed its blocks are returned
+/// to the pool for reuse, which makes it possible to unload code by
+/// destroying the memory manager of the object that contained it.
+class SlabMemoryManager : public RTDyldMemoryManager {
+public:
+  using AllocationPurpose = SectionMemoryManager::AllocationPurpose;
+
+  /// Slabs of memory shared between SlabMemoryManagers. All methods are
+  /// thread-safe.
+  class SlabPool {
+  public:
+    /// Size of a huge page, to which slabs are aligned and rounded when huge
+    /// pages are requested.
+    static const size_t HugePageSize = 2 * 1024 * 1024;
+
+    /// Default amount of address space to reserve per slab.
+    static const size_t DefaultSlabSize = 64 * 1024 * 1024;
+
+    struct Statistics {
+      /// Number of slabs mapped, including those for oversized blocks.
+      unsigned NumSlabs = 0;
+      /// Total size of all mapped slabs.
+      size_t BytesMapped = 0;
+      /// Total size of the blocks currently handed out.
+      size_t BytesInUse = 0;
+      /// Number of permission changes made.
+      unsigned NumProtectCalls = 0;
+    };
+
+    /// Create a pool that maps slabs of SlabSize bytes. If UseHugePages is
+    /// set, slabs are aligned to huge page boundaries and the operating system
+    /// is asked to back them with huge pages (see sys::Memory::MF_HUGE_HINT).
+    /// Permission changes still happen at normal page granularity and may
+    /// split huge pages.
+    SlabPool(size_t SlabSize = DefaultSlabSize, bool UseHugePages = false);
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    /// Unmaps all slabs. All memory managers using the pool must have been
+    /// destroyed first.
+    ~SlabPool();
+
+    /// Allocates a read-write, page-aligned block of at least NumBytes bytes
+    /// for Purpose. Blocks for the same purpose are carved out of the same
+    /// slabs, in address order where possible.
+    sys::MemoryBlock allocate(AllocationPurpose Purpose, size_t NumBytes,
+                              std::error_code &EC);
+
+    /// Changes the permissions of Block, which must have been returned by
+    /// allocate.
+    std::error_code protect(const sys::MemoryBlock &Block, unsigned Flags);
+
+    /// Returns Block to the pool. Its permissions are reset to read-write if
+    /// they were changed.
+    std::error_code release(AllocationPurpose Purpose, sys::MemoryBlock Block,
+                            bool WasProtected);
+
+    /// Returns a snapshot of the pool's statistics.
+    Statistics getStatistics() const;
+
+  private:
+    struct SlabGroup {
+      // Original mappings, as returned by sys::Memory.
+      std::vector<sys::MemoryBlock> Slabs;
+      // Free, page-aligned ranges (start -> size), coalesced on release.
+      std::map<uintptr_t, size_t> FreeRanges;
+    };
+
+    SlabGroup &getGroup(AllocationPurpose Purpose);
+    std::error_code mapSlab(SlabGroup &Group, size_t MinSize);
+
+    mutable std::mutex PoolMutex;
+    size_t SlabSize;
+    bool UseHugePages;
+    SlabGroup CodeSlabs, RODataSlabs, RWDataSlabs;
+    // The most recently mapped slab, used as a hint to keep slabs together.
+    sys::MemoryBlock LastSlab;
+    Statistics Stats;
+  };
+
+  /// Creates a SlabMemoryManager that allocates from Pool. If Pool is null
+  /// the memory manager creates a pool of its own.
+  SlabMemoryManager(std::shared_ptr<SlabPool> Pool = nullptr);
+  SlabMemoryManager(const SlabMemoryManager &) = delete;
+  void operator=(const SlabMemoryManager &) = delete;
+
+  /// Deregisters this memory manager's EH frames and returns its memory to
+  /// the pool.
+  ~SlabMemoryManager() override;
+
+  /// Returns the pool this memory manager allocates from.
+  SlabPool &getPool() { return *Pool; }
+
+  bool needsToReserveAllocationSpace() override { return true; }
+
+  /// Takes one block per purpose from the pool, large enough for all
+  /// sections of the object about to be loaded.
+  void reserveAllocationSpace(uintptr_t CodeSize, uint32_t CodeAlign,
+                              uintptr_t RODataSize, uint32_t RODataAlign,
+                              uintptr_t RWDataSize,
+                              uint32_t RWDataAlign) override;
+
+  /// Allocates a memory block of (at least) the given size suitable for
+  /// executable code.
+  ///
+  /// The value of \p Alignment must be a power of two.  If \p Alignment is zero
+  /// a default alignment of 16 will be used.
+  uint8_t *allocateCodeSection(uintptr_t Size, unsigned Alignment,
+                               unsigned SectionID,
+                               StringRef SectionName) override;
+
+  /// Allocates a memory block of (at least) the given size suitable for data.
+  ///
+  /// The value of \p Alignment must be a power of two.  If \p Alignment is zero
+  /// a default alignment of 16 will be used.
+  uint8_t *allocateDataSection(uintptr_t Size, unsigned Alignment,
+                               unsigned SectionID, StringRef SectionName,
+                               bool IsReadOnly) override;
+
+  /// Makes code executable and read-only data read-only, with one permission
+  /// change per block, and invalidates the instruction cache for the code.
+  ///
+  /// \returns true if an error occurred, false otherwise.
+  bool finalizeMemory(std::string *ErrMsg = nullptr) override;
+
+private:
+  struct Block {
+    sys::MemoryBlock Memory;
+    bool Protected = false;
+  };
+
+  struct MemoryGroup {
+    SmallVector<Block, 2> Blocks;
+    // Allocation cursor in the last block, and its end. Allocations never
+    // continue in a block once it has been protected.
+    uintptr_t Cur = 0;
+    uintptr_t End = 0;
+  };
+
+  MemoryGroup &getGroup(AllocationPurpose Purpose);
+  bool addBlock(AllocationPurpose Purpose, size_t NumBytes);
+  uint8_t *allocateSection(AllocationPurpose Purpose, uintptr_t Size,
+                           unsigned Alignment);
+  std::error_code applyPermissions(MemoryGroup &Group, unsigned Permissions);
+
+  std::shared_ptr<SlabPool> Pool;
+  MemoryGroup CodeMem;
+  MemoryGroup RODataMem;
+  MemoryGroup RWDataMem;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_SLABMEMORYMANAGER_H
@@ -73,6 +73,11 @@ void computeLTOCacheKey(
     const std::set<GlobalValue::GUID> &CfiFunctionDefs = {},
     const std::set<GlobalValue::GUID> &CfiFunctionDecls = {});
 
+/// Computes a unique hash for a regular LTO code generation partition, given
+/// the bitcode of its optimized module. The hash is produced in \p Key.
+void computeLTOPartitionCacheKey(SmallString<40> &Key,
+                                 const lto::Config &Conf, StringRef Bitcode);
+
 namespace lto {
 
 /// Given the original \p Path to an output file, replace any path
@@ -226,6 +231,9 @@ ThinBackend createInProcessThinBackend(unsigned ParallelismLevel);
 /// the final ThinLTO linking. Can be nullptr.
 /// OnWrite is callback which receives module identifier and notifies LTO user
 /// that index file for the module (and optionally imports file) was created.
+/// The index files of different modules are written concurrently, so OnWrite
+/// may be called from any thread, in any module order, but never concurrently
+/// with itself.
 using IndexWriteCallback = std::function<void(const std::string &)>;
 ThinBackend createWriteIndexesThinBackend(std::string OldPrefix,
                                           std::string NewPrefix,
@@ -396,7 +404,7 @@ private:
   Error addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
                    const SymbolResolution *&ResI, const SymbolResolution *ResE);
 
-  Error runRegularLTO(AddStreamFn AddStream);
+  Error runRegularLTO(AddStreamFn AddStream, NativeObjectCache Cache);
   Error runThinLTO(AddStreamFn AddStream, NativeObjectCache Cache);
 
   mutable bool CalledGetMaxTasks = false;
@@ -36,9 +36,20 @@ namespace lto {
 
 /// Runs a regular LTO backend. The regular LTO backend can also act as the
 /// regular LTO phase of ThinLTO, which may need to access the combined index.
+///
+/// If Cache is supplied and partition caching is enabled with
+/// -lto-cache-codegen-partitions, the native object for each code generation
+/// partition is looked up in and added to Cache, keyed on the partition's
+/// optimized IR, so that partitions left unchanged by an edit are not
+/// recompiled by later links. Only code generation is skipped: the whole-module
+/// optimization pipeline still runs on every link. The number of partitions is
+/// still ParallelCodeGenParallelismLevel, and with the default of one partition
+/// any edit invalidates the single cache entry, so callers that want reuse
+/// should ask for several partitions.
 Error backend(Config &C, AddStreamFn AddStream,
               unsigned ParallelCodeGenParallelismLevel,
-              std::unique_ptr<Module> M, ModuleSummaryIndex &CombinedIndex);
+              std::unique_ptr<Module> M, ModuleSummaryIndex &CombinedIndex,
+              NativeObjectCache Cache = nullptr);
 
 /// Runs a ThinLTO backend.
 Error thinBackend(Config &C, unsigned Task, AddStreamFn AddStream, Module &M,
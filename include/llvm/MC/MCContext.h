@@ -27,6 +27,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -184,6 +185,11 @@ namespace llvm {
     bool AllowTemporaryLabels = true;
     bool UseNamesOnTempLabels = true;
 
+    /// Whether symbols can be created by several threads at once, in which
+    /// case SymbolsLock is held while they are created or looked up.
+    bool ThreadSafeSymbols = false;
+    mutable sys::SmartMutex<true> SymbolsLock;
+
     /// The Compile Unit ID that we are currently processing.
     unsigned DwarfCompileUnitID = 0;
 
@@ -301,6 +307,11 @@ namespace llvm {
     void setAllowTemporaryLabels(bool Value) { AllowTemporaryLabels = Value; }
     void setUseNamesOnTempLabels(bool Value) { UseNamesOnTempLabels = Value; }
 
+    /// Allow symbols to be created and looked up by several threads at once,
+    /// as when machine functions are compiled in parallel. Symbols are not
+    /// destroyed, and the other members are not synchronized.
+    void setThreadSafeSymbols(bool Value) { ThreadSafeSymbols = Value; }
+
     /// \name Module Lifetime Management
     /// @{
 
@@ -349,6 +349,11 @@ struct FileContents {
   Reader TheReader;
 };
 
+/// Returns whether the bitcode file has an irsymtab that readBitcode can use
+/// as is, i.e. one written in the current format by the current producer.
+/// Otherwise readBitcode has to create the irsymtab from the modules.
+bool hasCurrentSymtab(const BitcodeFileContents &BFC);
+
 /// Reads the contents of a bitcode file, creating its irsymtab if necessary.
 Expected<FileContents> readBitcode(const BitcodeFileContents &BFC);
 
@@ -0,0 +1,81 @@
+//===- llvm/Support/SuffixArray.h - Array for finding repeats ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a suffix array with its longest common prefix array. It
+// finds the same repeated substrings as a SuffixTree, in a small fraction of
+// the memory.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_SUFFIXARRAY_H
+#define LLVM_SUPPORT_SUFFIXARRAY_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/SuffixTree.h"
+#include <vector>
+
+namespace llvm {
+
+/// The suffixes of a string in sorted order, and the length of the common
+/// prefix of each pair of neighbours in that order.
+///
+/// Both arrays are built in time linear in the length of the string: the
+/// suffix array with the SA-IS algorithm of Nong, Zhang and Chan ("Two
+/// Efficient Algorithms for Linear Time Suffix Array Construction"), and the
+/// longest common prefix (LCP) array with the algorithm of Kasai et al.
+/// ("Linear-Time Longest-Common-Prefix Computation in Suffix Arrays and Its
+/// Applications"). They take two integers per element of the string, where a
+/// \p SuffixTree allocates a node, with a map of its children, for each leaf
+/// and each branch.
+///
+/// The intervals of the suffix array whose suffixes share a prefix longer than
+/// their neighbours do are the internal nodes of the suffix tree of the same
+/// string, so the array can be queried for the same repeated substrings.
+///
+/// As for \p SuffixTree, the string must not contain the empty and tombstone
+/// keys of \p DenseMapInfo<unsigned>.
+class SuffixArray {
+public:
+  /// The string the arrays are built for.
+  ArrayRef<unsigned> Str;
+
+  /// Construct the suffix array and LCP array of \p Str.
+  SuffixArray(ArrayRef<unsigned> Str);
+
+  /// The start indices of the suffixes of \p Str, sorted.
+  ///
+  /// The elements of \p Str are renumbered in the order in which they first
+  /// occur before the suffixes are compared, so this is not the order of the
+  /// suffixes by the values of their elements.
+  ArrayRef<unsigned> getSuffixes() const { return Suffixes; }
+
+  /// The length of the longest common prefix of each suffix in
+  /// \p getSuffixes() and the one before it. The first element is 0.
+  ArrayRef<unsigned> getLCPs() const { return LCPs; }
+
+  /// Call \p Fn on each substring of at least \p MinLength elements that
+  /// iterating over a \p SuffixTree of \p Str would produce: one for each
+  /// internal node with at least two leaf children, with the start indices of
+  /// those leaves, in increasing order.
+  ///
+  /// Each substring is passed to \p Fn as soon as it is found, and the
+  /// memory used by the walk is bounded by the length of \p Str.
+  void forEachRepeatedSubstring(
+      function_ref<void(const RepeatedSubstring &)> Fn,
+      unsigned MinLength = 2) const;
+
+private:
+  std::vector<unsigned> Suffixes;
+  std::vector<unsigned> LCPs;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_SUFFIXARRAY_H
@@ -26,6 +26,12 @@ class Module;
 /// Splits the module M into N linkable partitions. The function ModuleCallback
 /// is called N times passing each individual partition as the MPart argument.
 ///
+/// If CostBalanced is true, globals are distributed so that the partitions have
+/// roughly equal estimated code generation cost (based on instruction counts),
+/// and functions in the same call graph SCC are kept in the same partition.
+/// Otherwise externally visible globals are distributed by the hash of their
+/// name.
+///
 /// FIXME: This function does not deal with the somewhat subtle symbol
 /// visibility issues around module splitting, including (but not limited to):
 ///
@@ -36,7 +42,7 @@ class Module;
 void SplitModule(
     std::unique_ptr<Module> M, unsigned N,
     function_ref<void(std::unique_ptr<Module> MPart)> ModuleCallback,
-    bool PreserveLocals = false);
+    bool PreserveLocals = false, bool CostBalanced = false);
 
 } // end namespace llvm
 
@@ -16,9 +16,11 @@
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/CodeGen/Analysis.h"
 #include "llvm/CodeGen/GlobalISel/CallLowering.h"
+#include "llvm/CodeGen/GlobalISel/InstructionSelector.h"
 #include "llvm/CodeGen/LowLevelType.h"
 #include "llvm/CodeGen/MachineBasicBlock.h"
 #include "llvm/CodeGen/MachineFrameInfo.h"
@@ -56,6 +58,7 @@
 #include "llvm/Pass.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CodeGen.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/LowLevelTypeImpl.h"
@@ -75,6 +78,14 @@
 
 using namespace llvm;
 
+static cl::opt<bool>
+    EnableFusedSelect("global-isel-fused-select", cl::Hidden,
+                      cl::desc("At -O0, let the target select the simplest "
+                               "instructions while they are translated"),
+                      cl::init(false));
+
+STATISTIC(NumFusedSelected, "Number of instructions selected on translation");
+
 char IRTranslator::ID = 0;
 
 INITIALIZE_PASS_BEGIN(IRTranslator, DEBUG_TYPE, "IRTranslator LLVM IR -> MI",
@@ -185,15 +196,12 @@ IRTranslator::allocateVRegs(const Value &Val) {
 }
 
 ArrayRef<unsigned> IRTranslator::getOrCreateVRegs(const Value &Val) {
-  auto VRegsIt = VMap.findVRegs(Val);
-  if (VRegsIt != VMap.vregs_end())
-    return *VRegsIt->second;
-
-  if (Val.getType()->isVoidTy())
-    return *VMap.getVRegs(Val);
+  auto VRegsAndInserted = VMap.getOrInsertVRegs(Val);
+  auto *VRegs = VRegsAndInserted.first;
+  if (!VRegsAndInserted.second || Val.getType()->isVoidTy())
+    return *VRegs;
 
   // Create entry for this type.
-  auto *VRegs = VMap.getVRegs(Val);
   auto *Offsets = VMap.getOffsets(Val);
 
   assert(Val.getType()->isSized() &&
@@ -314,6 +322,8 @@ bool IRTranslator::translateBinaryOp(unsigned Opcode, const User &U,
     MachineInstr *FBinOpMI = FBinOp.getInstr();
     const Instruction &I = cast<Instruction>(U);
     FBinOpMI->copyIRFlags(I);
+    if (FusedISel && FusedISel->selectDuringTranslation(*FBinOpMI))
+      ++NumFusedSelected;
   }
   return true;
 }
@@ -1651,11 +1661,14 @@ bool IRTranslator::runOnMachineFunction(MachineFunction &CurMF) {
   if (F.empty())
     return false;
   CLI = MF->getSubtarget().getCallLowering();
+  TPC = &getAnalysis<TargetPassConfig>();
+  FusedISel = EnableFusedSelect && TPC->getOptLevel() == CodeGenOpt::None
+                  ? MF->getSubtarget().getInstructionSelector()
+                  : nullptr;
   CurBuilder.setMF(*MF);
   EntryBuilder.setMF(*MF);
   MRI = &MF->getRegInfo();
   DL = &F.getParent()->getDataLayout();
-  TPC = &getAnalysis<TargetPassConfig>();
   ORE = llvm::make_unique<OptimizationRemarkEmitter>(&F);
 
   assert(PendingPHIs.empty() && "stale PHIs");
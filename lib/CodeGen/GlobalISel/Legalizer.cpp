@@ -14,11 +14,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/CodeGen/GlobalISel/Legalizer.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/GlobalISel/GISelWorkList.h"
 #include "llvm/CodeGen/GlobalISel/LegalizationArtifactCombiner.h"
 #include "llvm/CodeGen/GlobalISel/LegalizerHelper.h"
+#include "llvm/CodeGen/GlobalISel/LegalizerInfo.h"
 #include "llvm/CodeGen/GlobalISel/Utils.h"
 #include "llvm/CodeGen/MachineOptimizationRemarkEmitter.h"
 #include "llvm/CodeGen/MachineRegisterInfo.h"
@@ -32,6 +35,9 @@
 
 using namespace llvm;
 
+STATISTIC(NumAlreadyLegalFunctions,
+          "Number of functions found legal without the worklists");
+
 char Legalizer::ID = 0;
 INITIALIZE_PASS_BEGIN(Legalizer, DEBUG_TYPE,
                       "Legalize the Machine IR a function's Machine IR", false,
@@ -82,9 +88,9 @@ bool Legalizer::runOnMachineFunction(MachineFunction &MF) {
   const size_t NumBlocks = MF.size();
   MachineRegisterInfo &MRI = MF.getRegInfo();
 
-  // Populate Insts
-  GISelWorkList<256> InstList;
-  GISelWorkList<128> ArtifactList;
+  // Collect the generic instructions.
+  SmallVector<MachineInstr *, 256> Insts;
+  bool HasArtifacts = false;
   ReversePostOrderTraversal<MachineFunction *> RPOT(&MF);
   // Perform legalization bottom up so we can DCE as we legalize.
   // Traverse BB in RPOT and within each basic block, add insts top down,
@@ -97,12 +103,52 @@ bool Legalizer::runOnMachineFunction(MachineFunction &MF) {
       // and are assumed to be legal.
       if (!isPreISelGenericOpcode(MI.getOpcode()))
         continue;
-      if (isArtifact(MI))
-        ArtifactList.insert(&MI);
-      else
-        InstList.insert(&MI);
+      HasArtifacts |= isArtifact(MI);
+      Insts.push_back(&MI);
+    }
+  }
+
+  // Code from a fast instruction selection pipeline is often legal as it is.
+  // Without artifacts to combine, go through the instructions in the same
+  // order as the worklists would, and only set those up from the first
+  // instruction that needs to change.
+  // The action found for the first such instruction is kept so that the
+  // worklist does not query it again.
+  const LegalizerInfo &LInfo(Helper.getLegalizerInfo());
+  MachineInstr *FirstIllegalMI = nullptr;
+  Optional<LegalizeActionStep> FirstIllegalStep;
+  if (!HasArtifacts) {
+    while (!Insts.empty()) {
+      MachineInstr &MI = *Insts.back();
+      if (isTriviallyDead(MI, MRI)) {
+        LLVM_DEBUG(dbgs() << MI << "Is dead; erasing.\n");
+        MI.eraseFromParentAndMarkDBGValuesForRemoval();
+      } else {
+        LegalizeActionStep Step = LInfo.getAction(MI, MRI);
+        if (Step.Action != LegalizeActions::Legal) {
+          FirstIllegalMI = &MI;
+          FirstIllegalStep = Step;
+          break;
+        }
+      }
+      Insts.pop_back();
+    }
+    if (Insts.empty()) {
+      LLVM_DEBUG(dbgs() << "All instructions are legal\n");
+      ++NumAlreadyLegalFunctions;
+      return false;
     }
   }
+
+  // Populate the worklists with the instructions left.
+  GISelWorkList<256> InstList;
+  GISelWorkList<128> ArtifactList;
+  for (MachineInstr *MI : Insts) {
+    if (isArtifact(*MI))
+      ArtifactList.insert(MI);
+    else
+      InstList.insert(MI);
+  }
   Helper.MIRBuilder.recordInsertions([&](MachineInstr *MI) {
     // Only legalize pre-isel generic instructions.
     // Legalization process could generate Target specific pseudo
@@ -115,7 +161,6 @@ bool Legalizer::runOnMachineFunction(MachineFunction &MF) {
     }
     LLVM_DEBUG(dbgs() << ".. .. New MI: " << *MI;);
   });
-  const LegalizerInfo &LInfo(Helper.getLegalizerInfo());
   LegalizationArtifactCombiner ArtCombiner(Helper.MIRBuilder, MF.getRegInfo(), LInfo);
   auto RemoveDeadInstFromLists = [&InstList,
                                   &ArtifactList](MachineInstr *DeadMI) {
@@ -133,8 +178,12 @@ bool Legalizer::runOnMachineFunction(MachineFunction &MF) {
         continue;
       }
 
-      // Do the legalization for this instruction.
-      auto Res = Helper.legalizeInstrStep(MI);
+      // Do the legalization for this instruction. The first instruction off
+      // the list is the one the early exit stopped at, if any.
+      auto Res = &MI == FirstIllegalMI
+                     ? Helper.legalizeInstrStep(MI, *FirstIllegalStep)
+                     : Helper.legalizeInstrStep(MI);
+      FirstIllegalMI = nullptr;
       // Error out if we couldn't legalize this instruction. We may want to
       // fall back to DAG ISel instead in the future.
       if (Res == LegalizerHelper::UnableToLegalize) {
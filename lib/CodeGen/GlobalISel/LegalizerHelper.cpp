@@ -40,9 +40,14 @@ LegalizerHelper::LegalizerHelper(MachineFunction &MF, const LegalizerInfo &LI)
 }
 LegalizerHelper::LegalizeResult
 LegalizerHelper::legalizeInstrStep(MachineInstr &MI) {
+  return legalizeInstrStep(MI, LI.getAction(MI, MRI));
+}
+
+LegalizerHelper::LegalizeResult
+LegalizerHelper::legalizeInstrStep(MachineInstr &MI,
+                                   const LegalizeActionStep &Step) {
   LLVM_DEBUG(dbgs() << "Legalizing: "; MI.print(dbgs()));
 
-  auto Step = LI.getAction(MI, MRI);
   switch (Step.Action) {
   case Legal:
     LLVM_DEBUG(dbgs() << ".. Already legal\n");
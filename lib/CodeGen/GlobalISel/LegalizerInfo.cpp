@@ -19,6 +19,7 @@
 
 #include "llvm/CodeGen/GlobalISel/LegalizerInfo.h"
 #include "llvm/ADT/SmallBitVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/MachineInstr.h"
 #include "llvm/CodeGen/MachineOperand.h"
 #include "llvm/CodeGen/MachineRegisterInfo.h"
@@ -37,6 +38,10 @@ using namespace LegalizeActions;
 
 #define DEBUG_TYPE "legalizer-info"
 
+STATISTIC(NumDecisionsReused,
+          "Number of legality queries answered by a previous decision");
+STATISTIC(NumDecisionsMade, "Number of legality queries run through the rules");
+
 cl::opt<bool> llvm::DisableGISelLegalityCheck(
     "disable-gisel-legality-check",
     cl::desc("Don't verify that MIR is fully legal between GlobalISel passes"),
@@ -143,6 +148,7 @@ LegalizerInfo::LegalizerInfo() : TablesInitialized(false) {
 
 void LegalizerInfo::computeTables() {
   assert(TablesInitialized == false);
+  Decisions.clear();
 
   for (unsigned OpcodeIdx = 0; OpcodeIdx <= LastOp - FirstOp; ++OpcodeIdx) {
     const unsigned Opcode = FirstOp + OpcodeIdx;
@@ -291,6 +297,7 @@ LegalizeRuleSet &LegalizerInfo::getActionDefinitionsBuilder(unsigned Opcode) {
   unsigned OpcodeIdx = getActionDefinitionsIdx(Opcode);
   auto &Result = RulesForOpcode[OpcodeIdx];
   assert(!Result.isAliasedByAnother() && "Modifying this opcode will modify aliases");
+  Decisions.clear();
   return Result;
 }
 
@@ -315,10 +322,59 @@ void LegalizerInfo::aliasActionDefinitions(unsigned OpcodeTo,
   assert(OpcodeTo >= FirstOp && OpcodeTo <= LastOp && "Unsupported opcode");
   const unsigned OpcodeFromIdx = getOpcodeIdxForOpcode(OpcodeFrom);
   RulesForOpcode[OpcodeFromIdx].aliasTo(OpcodeTo);
+  Decisions.clear();
+}
+
+bool LegalizerInfo::Decision::matches(const LegalityQuery &Query) const {
+  if (Opcode != Query.Opcode || NumTypes != Query.Types.size() ||
+      NumMMOs != Query.MMODescrs.size())
+    return false;
+  for (unsigned I = 0; I != NumTypes; ++I)
+    if (Types[I] != Query.Types[I])
+      return false;
+  return NumMMOs == 0 || (MMO.SizeInBits == Query.MMODescrs[0].SizeInBits &&
+                          MMO.Ordering == Query.MMODescrs[0].Ordering);
 }
 
 LegalizeActionStep
 LegalizerInfo::getAction(const LegalityQuery &Query) const {
+  if (Query.Types.size() > MaxDecisionTypes || Query.MMODescrs.size() > 1)
+    return decideAction(Query);
+
+  // The rules are pure functions of the query, so a decision holds for every
+  // query with the same opcode, types and memory operand.
+  unsigned Hash = Query.Opcode;
+  for (const LLT &Ty : Query.Types)
+    Hash = Hash * 37 + DenseMapInfo<LLT>::getHashValue(Ty);
+  for (const auto &MMO : Query.MMODescrs)
+    Hash = Hash * 37 + unsigned(MMO.SizeInBits) * 8 + unsigned(MMO.Ordering);
+  Hash ^= Hash >> 16;
+
+  if (Decisions.empty())
+    Decisions.resize(NumDecisions);
+  Decision &D = Decisions[Hash % NumDecisions];
+  if (D.matches(Query)) {
+    LLVM_DEBUG(dbgs() << ".. decided before: " << (unsigned)D.Step.Action
+                      << ", " << D.Step.TypeIdx << ", " << D.Step.NewType
+                      << "\n");
+    ++NumDecisionsReused;
+    return D.Step;
+  }
+
+  LegalizeActionStep Step = decideAction(Query);
+  ++NumDecisionsMade;
+  D.Opcode = Query.Opcode;
+  D.NumTypes = Query.Types.size();
+  D.NumMMOs = Query.MMODescrs.size();
+  std::copy(Query.Types.begin(), Query.Types.end(), D.Types);
+  if (D.NumMMOs)
+    D.MMO = Query.MMODescrs[0];
+  D.Step = Step;
+  return Step;
+}
+
+LegalizeActionStep
+LegalizerInfo::decideAction(const LegalityQuery &Query) const {
   LegalizeActionStep Step = getActionDefinitions(Query.Opcode).apply(Query);
   if (Step.Action != LegalizeAction::UseLegacyRules) {
     return Step;
@@ -344,7 +400,6 @@ LegalizerInfo::getAction(const MachineInstr &MI,
   SmallVector<LLT, 2> Types;
   SmallBitVector SeenTypes(8);
   const MCOperandInfo *OpInfo = MI.getDesc().OpInfo;
-  // FIXME: probably we'll need to cache the results here somehow?
   for (unsigned i = 0; i < MI.getDesc().getNumOperands(); ++i) {
     if (!OpInfo[i].isGenericType())
       continue;
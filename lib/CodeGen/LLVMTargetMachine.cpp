@@ -97,12 +97,17 @@ LLVMTargetMachine::getTargetTransformInfo(const Function &F) {
 /// addPassesToX helper drives creation and initialization of TargetPassConfig.
 static TargetPassConfig *
 addPassesToGenerateCode(LLVMTargetMachine &TM, PassManagerBase &PM,
-                        bool DisableVerify, MachineModuleInfo &MMI) {
+                        bool DisableVerify, bool NamesTempLabels,
+                        MachineModuleInfo &MMI) {
   // Targets may override createPassConfig to provide a target-specific
   // subclass.
   TargetPassConfig *PassConfig = TM.createPassConfig(PM);
   // Set PassConfig options provided by TargetMachine.
   PassConfig->setDisableVerify(DisableVerify);
+  // Functions compiled in parallel number their temporary labels in a
+  // different order, which only shows when the labels keep their names.
+  PassConfig->setAllowParallelMachinePasses(
+      !NamesTempLabels && !TM.Options.MCOptions.MCSaveTempLabels);
   PM.add(PassConfig);
   PM.add(&MMI);
 
@@ -196,8 +201,8 @@ bool LLVMTargetMachine::addPassesToEmitFile(PassManagerBase &PM,
   // Add common CodeGen passes.
   if (!MMI)
     MMI = new MachineModuleInfo(this);
-  TargetPassConfig *PassConfig =
-      addPassesToGenerateCode(*this, PM, DisableVerify, *MMI);
+  TargetPassConfig *PassConfig = addPassesToGenerateCode(
+      *this, PM, DisableVerify, FileType == CGFT_AssemblyFile, *MMI);
   if (!PassConfig)
     return true;
 
@@ -220,8 +225,8 @@ bool LLVMTargetMachine::addPassesToEmitMC(PassManagerBase &PM, MCContext *&Ctx,
                                           bool DisableVerify) {
   // Add common CodeGen passes.
   MachineModuleInfo *MMI = new MachineModuleInfo(this);
-  TargetPassConfig *PassConfig =
-      addPassesToGenerateCode(*this, PM, DisableVerify, *MMI);
+  TargetPassConfig *PassConfig = addPassesToGenerateCode(
+      *this, PM, DisableVerify, /*NamesTempLabels=*/false, *MMI);
   if (!PassConfig)
     return true;
   assert(TargetPassConfig::willCompleteCodeGenPipeline() &&
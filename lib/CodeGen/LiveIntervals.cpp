@@ -20,6 +20,7 @@
 #include "llvm/ADT/DepthFirstIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/CodeGen/LiveInterval.h"
@@ -46,8 +47,10 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <iterator>
@@ -58,6 +61,9 @@ using namespace llvm;
 
 #define DEBUG_TYPE "regalloc"
 
+STATISTIC(NumParallelVirtRegs,
+          "Number of virtual register intervals computed in parallel");
+
 char LiveIntervals::ID = 0;
 char &llvm::LiveIntervalsID = LiveIntervals::ID;
 INITIALIZE_PASS_BEGIN(LiveIntervals, "liveintervals",
@@ -76,6 +82,11 @@ static cl::opt<bool> EnablePrecomputePhysRegs(
 static bool EnablePrecomputePhysRegs = false;
 #endif // NDEBUG
 
+static cl::opt<unsigned> LiveIntervalThreads(
+    "live-interval-threads", cl::Hidden, cl::init(0),
+    cl::desc("Number of threads that compute the live intervals of virtual "
+             "registers (0 or 1 computes them on the calling thread)"));
+
 namespace llvm {
 
 cl::opt<bool> UseSegmentSetForPhysRegs(
@@ -121,6 +132,8 @@ void LiveIntervals::releaseMemory() {
 
   // Release VNInfo memory regions, VNInfo objects don't need to be dtor'd.
   VNInfoAllocator.Reset();
+  for (auto &Alloc : ThreadVNInfoAllocators)
+    Alloc->Reset();
 }
 
 bool LiveIntervals::runOnMachineFunction(MachineFunction &fn) {
@@ -201,6 +214,11 @@ void LiveIntervals::computeVirtRegInterval(LiveInterval &LI) {
 }
 
 void LiveIntervals::computeVirtRegs() {
+  unsigned Threads =
+      std::min<unsigned>(LiveIntervalThreads, MRI->getNumVirtRegs());
+  if (Threads > 1)
+    return computeVirtRegsInParallel(Threads);
+
   for (unsigned i = 0, e = MRI->getNumVirtRegs(); i != e; ++i) {
     unsigned Reg = TargetRegisterInfo::index2VirtReg(i);
     if (MRI->reg_nodbg_empty(Reg))
@@ -209,6 +227,55 @@ void LiveIntervals::computeVirtRegs() {
   }
 }
 
+void LiveIntervals::computeVirtRegsInParallel(unsigned Threads) {
+  // Create the intervals up front, so that the threads only fill them in.
+  std::vector<LiveInterval *> Intervals;
+  for (unsigned i = 0, e = MRI->getNumVirtRegs(); i != e; ++i) {
+    unsigned Reg = TargetRegisterInfo::index2VirtReg(i);
+    if (!MRI->reg_nodbg_empty(Reg))
+      Intervals.push_back(&createEmptyInterval(Reg));
+  }
+
+  // The threads only read the function, the slot indexes and the dominator
+  // tree, apart from the kill flags of the operands of their own registers.
+  // Apply any pending updates to the tree before they look at it.
+  DomTree->getBase();
+
+  while (ThreadVNInfoAllocators.size() < Threads)
+    ThreadVNInfoAllocators.emplace_back(new VNInfo::Allocator());
+
+  // Hand out the registers in chunks, so that a thread that finds large live
+  // ranges doesn't hold up the others.
+  const unsigned ChunkSize = 32;
+  std::atomic<unsigned> NextChunk(0);
+  {
+    ThreadPool Pool(Threads);
+    for (unsigned T = 0; T != Threads; ++T)
+      Pool.async([&, T]() {
+        LiveRangeCalc Calc;
+        for (;;) {
+          unsigned Begin = NextChunk.fetch_add(ChunkSize);
+          if (Begin >= Intervals.size())
+            break;
+          unsigned End =
+              std::min<unsigned>(Begin + ChunkSize, Intervals.size());
+          for (unsigned i = Begin; i != End; ++i) {
+            LiveInterval &LI = *Intervals[i];
+            Calc.reset(MF, Indexes, DomTree, ThreadVNInfoAllocators[T].get());
+            Calc.calculate(LI, MRI->shouldTrackSubRegLiveness(LI.reg));
+          }
+        }
+      });
+    Pool.wait();
+  }
+
+  // Marking dead defs changes the flags of instructions, so it happens here,
+  // in register order.
+  for (LiveInterval *LI : Intervals)
+    computeDeadValues(*LI, nullptr);
+  NumParallelVirtRegs += Intervals.size();
+}
+
 void LiveIntervals::computeRegMasks() {
   RegMaskBlocks.resize(MF->getNumBlockIDs());
 
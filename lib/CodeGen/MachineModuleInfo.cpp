@@ -261,12 +261,15 @@ void MachineModuleInfo::addPersonality(const Function *Personality) {
 
 MachineFunction *
 MachineModuleInfo::getMachineFunction(const Function &F) const {
+  std::lock_guard<std::mutex> Lock(MachineFunctionsMutex);
   auto I = MachineFunctions.find(&F);
   return I != MachineFunctions.end() ? I->second.get() : nullptr;
 }
 
 MachineFunction &
 MachineModuleInfo::getOrCreateMachineFunction(const Function &F) {
+  std::lock_guard<std::mutex> Lock(MachineFunctionsMutex);
+
   // Shortcut for the common case where a sequence of MachineFunctionPasses
   // all query for the same Function.
   if (LastRequest == &F)
@@ -291,6 +294,7 @@ MachineModuleInfo::getOrCreateMachineFunction(const Function &F) {
 }
 
 void MachineModuleInfo::deleteMachineFunctionFor(Function &F) {
+  std::lock_guard<std::mutex> Lock(MachineFunctionsMutex);
   MachineFunctions.erase(&F);
   LastRequest = nullptr;
   LastResult = nullptr;
@@ -56,6 +56,7 @@
 ///
 //===----------------------------------------------------------------------===//
 #include "llvm/CodeGen/MachineOutliner.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Twine.h"
@@ -72,9 +73,13 @@
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/SuffixArray.h"
+#include "llvm/Support/SuffixTree.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <functional>
 #include <map>
+#include <numeric>
 #include <sstream>
 #include <tuple>
 #include <vector>
@@ -99,510 +104,35 @@ static cl::opt<bool> EnableLinkOnceODROutlining(
     cl::desc("Enable the machine outliner on linkonceodr functions"),
     cl::init(false));
 
-namespace {
-
-/// Represents an undefined index in the suffix tree.
-const unsigned EmptyIdx = -1;
-
-/// A node in a suffix tree which represents a substring or suffix.
-///
-/// Each node has either no children or at least two children, with the root
-/// being a exception in the empty tree.
-///
-/// Children are represented as a map between unsigned integers and nodes. If
-/// a node N has a child M on unsigned integer k, then the mapping represented
-/// by N is a proper prefix of the mapping represented by M. Note that this,
-/// although similar to a trie is somewhat different: each node stores a full
-/// substring of the full mapping rather than a single character state.
-///
-/// Each internal node contains a pointer to the internal node representing
-/// the same string, but with the first character chopped off. This is stored
-/// in \p Link. Each leaf node stores the start index of its respective
-/// suffix in \p SuffixIdx.
-struct SuffixTreeNode {
-
-  /// The children of this node.
-  ///
-  /// A child existing on an unsigned integer implies that from the mapping
-  /// represented by the current node, there is a way to reach another
-  /// mapping by tacking that character on the end of the current string.
-  DenseMap<unsigned, SuffixTreeNode *> Children;
-
-  /// The start index of this node's substring in the main string.
-  unsigned StartIdx = EmptyIdx;
-
-  /// The end index of this node's substring in the main string.
-  ///
-  /// Every leaf node must have its \p EndIdx incremented at the end of every
-  /// step in the construction algorithm. To avoid having to update O(N)
-  /// nodes individually at the end of every step, the end index is stored
-  /// as a pointer.
-  unsigned *EndIdx = nullptr;
-
-  /// For leaves, the start index of the suffix represented by this node.
-  ///
-  /// For all other nodes, this is ignored.
-  unsigned SuffixIdx = EmptyIdx;
-
-  /// For internal nodes, a pointer to the internal node representing
-  /// the same sequence with the first character chopped off.
-  ///
-  /// This acts as a shortcut in Ukkonen's algorithm. One of the things that
-  /// Ukkonen's algorithm does to achieve linear-time construction is
-  /// keep track of which node the next insert should be at. This makes each
-  /// insert O(1), and there are a total of O(N) inserts. The suffix link
-  /// helps with inserting children of internal nodes.
-  ///
-  /// Say we add a child to an internal node with associated mapping S. The
-  /// next insertion must be at the node representing S - its first character.
-  /// This is given by the way that we iteratively build the tree in Ukkonen's
-  /// algorithm. The main idea is to look at the suffixes of each prefix in the
-  /// string, starting with the longest suffix of the prefix, and ending with
-  /// the shortest. Therefore, if we keep pointers between such nodes, we can
-  /// move to the next insertion point in O(1) time. If we don't, then we'd
-  /// have to query from the root, which takes O(N) time. This would make the
-  /// construction algorithm O(N^2) rather than O(N).
-  SuffixTreeNode *Link = nullptr;
-
-  /// The length of the string formed by concatenating the edge labels from the
-  /// root to this node.
-  unsigned ConcatLen = 0;
-
-  /// Returns true if this node is a leaf.
-  bool isLeaf() const { return SuffixIdx != EmptyIdx; }
-
-  /// Returns true if this node is the root of its owning \p SuffixTree.
-  bool isRoot() const { return StartIdx == EmptyIdx; }
-
-  /// Return the number of elements in the substring associated with this node.
-  size_t size() const {
-
-    // Is it the root? If so, it's the empty string so return 0.
-    if (isRoot())
-      return 0;
-
-    assert(*EndIdx != EmptyIdx && "EndIdx is undefined!");
-
-    // Size = the number of elements in the string.
-    // For example, [0 1 2 3] has length 4, not 3. 3-0 = 3, so we have 3-0+1.
-    return *EndIdx - StartIdx + 1;
-  }
-
-  SuffixTreeNode(unsigned StartIdx, unsigned *EndIdx, SuffixTreeNode *Link)
-      : StartIdx(StartIdx), EndIdx(EndIdx), Link(Link) {}
-
-  SuffixTreeNode() {}
-};
-
-/// A data structure for fast substring queries.
-///
-/// Suffix trees represent the suffixes of their input strings in their leaves.
-/// A suffix tree is a type of compressed trie structure where each node
-/// represents an entire substring rather than a single character. Each leaf
-/// of the tree is a suffix.
-///
-/// A suffix tree can be seen as a type of state machine where each state is a
-/// substring of the full string. The tree is structured so that, for a string
-/// of length N, there are exactly N leaves in the tree. This structure allows
-/// us to quickly find repeated substrings of the input string.
-///
-/// In this implementation, a "string" is a vector of unsigned integers.
-/// These integers may result from hashing some data type. A suffix tree can
-/// contain 1 or many strings, which can then be queried as one large string.
-///
-/// The suffix tree is implemented using Ukkonen's algorithm for linear-time
-/// suffix tree construction. Ukkonen's algorithm is explained in more detail
-/// in the paper by Esko Ukkonen "On-line construction of suffix trees. The
-/// paper is available at
-///
-/// https://www.cs.helsinki.fi/u/ukkonen/SuffixT1withFigs.pdf
-class SuffixTree {
-public:
-  /// Each element is an integer representing an instruction in the module.
-  ArrayRef<unsigned> Str;
-
-  /// A repeated substring in the tree.
-  struct RepeatedSubstring {
-    /// The length of the string.
-    unsigned Length;
-
-    /// The start indices of each occurrence.
-    std::vector<unsigned> StartIndices;
-  };
-
-private:
-  /// Maintains each node in the tree.
-  SpecificBumpPtrAllocator<SuffixTreeNode> NodeAllocator;
-
-  /// The root of the suffix tree.
-  ///
-  /// The root represents the empty string. It is maintained by the
-  /// \p NodeAllocator like every other node in the tree.
-  SuffixTreeNode *Root = nullptr;
-
-  /// Maintains the end indices of the internal nodes in the tree.
-  ///
-  /// Each internal node is guaranteed to never have its end index change
-  /// during the construction algorithm; however, leaves must be updated at
-  /// every step. Therefore, we need to store leaf end indices by reference
-  /// to avoid updating O(N) leaves at every step of construction. Thus,
-  /// every internal node must be allocated its own end index.
-  BumpPtrAllocator InternalEndIdxAllocator;
-
-  /// The end index of each leaf in the tree.
-  unsigned LeafEndIdx = -1;
-
-  /// Helper struct which keeps track of the next insertion point in
-  /// Ukkonen's algorithm.
-  struct ActiveState {
-    /// The next node to insert at.
-    SuffixTreeNode *Node;
-
-    /// The index of the first character in the substring currently being added.
-    unsigned Idx = EmptyIdx;
-
-    /// The length of the substring we have to add at the current step.
-    unsigned Len = 0;
-  };
-
-  /// The point the next insertion will take place at in the
-  /// construction algorithm.
-  ActiveState Active;
-
-  /// Allocate a leaf node and add it to the tree.
-  ///
-  /// \param Parent The parent of this node.
-  /// \param StartIdx The start index of this node's associated string.
-  /// \param Edge The label on the edge leaving \p Parent to this node.
-  ///
-  /// \returns A pointer to the allocated leaf node.
-  SuffixTreeNode *insertLeaf(SuffixTreeNode &Parent, unsigned StartIdx,
-                             unsigned Edge) {
-
-    assert(StartIdx <= LeafEndIdx && "String can't start after it ends!");
-
-    SuffixTreeNode *N = new (NodeAllocator.Allocate())
-        SuffixTreeNode(StartIdx, &LeafEndIdx, nullptr);
-    Parent.Children[Edge] = N;
-
-    return N;
-  }
-
-  /// Allocate an internal node and add it to the tree.
-  ///
-  /// \param Parent The parent of this node. Only null when allocating the root.
-  /// \param StartIdx The start index of this node's associated string.
-  /// \param EndIdx The end index of this node's associated string.
-  /// \param Edge The label on the edge leaving \p Parent to this node.
-  ///
-  /// \returns A pointer to the allocated internal node.
-  SuffixTreeNode *insertInternalNode(SuffixTreeNode *Parent, unsigned StartIdx,
-                                     unsigned EndIdx, unsigned Edge) {
-
-    assert(StartIdx <= EndIdx && "String can't start after it ends!");
-    assert(!(!Parent && StartIdx != EmptyIdx) &&
-           "Non-root internal nodes must have parents!");
-
-    unsigned *E = new (InternalEndIdxAllocator) unsigned(EndIdx);
-    SuffixTreeNode *N = new (NodeAllocator.Allocate())
-        SuffixTreeNode(StartIdx, E, Root);
-    if (Parent)
-      Parent->Children[Edge] = N;
-
-    return N;
-  }
-
-  /// Set the suffix indices of the leaves to the start indices of their
-  /// respective suffixes.
-  ///
-  /// \param[in] CurrNode The node currently being visited.
-  /// \param CurrNodeLen The concatenation of all node sizes from the root to
-  /// this node. Used to produce suffix indices.
-  void setSuffixIndices(SuffixTreeNode &CurrNode, unsigned CurrNodeLen) {
-
-    bool IsLeaf = CurrNode.Children.size() == 0 && !CurrNode.isRoot();
-
-    // Store the concatenation of lengths down from the root.
-    CurrNode.ConcatLen = CurrNodeLen;
-    // Traverse the tree depth-first.
-    for (auto &ChildPair : CurrNode.Children) {
-      assert(ChildPair.second && "Node had a null child!");
-      setSuffixIndices(*ChildPair.second,
-                       CurrNodeLen + ChildPair.second->size());
-    }
-
-    // Is this node a leaf? If it is, give it a suffix index.
-    if (IsLeaf)
-      CurrNode.SuffixIdx = Str.size() - CurrNodeLen;
-  }
-
-  /// Construct the suffix tree for the prefix of the input ending at
-  /// \p EndIdx.
-  ///
-  /// Used to construct the full suffix tree iteratively. At the end of each
-  /// step, the constructed suffix tree is either a valid suffix tree, or a
-  /// suffix tree with implicit suffixes. At the end of the final step, the
-  /// suffix tree is a valid tree.
-  ///
-  /// \param EndIdx The end index of the current prefix in the main string.
-  /// \param SuffixesToAdd The number of suffixes that must be added
-  /// to complete the suffix tree at the current phase.
-  ///
-  /// \returns The number of suffixes that have not been added at the end of
-  /// this step.
-  unsigned extend(unsigned EndIdx, unsigned SuffixesToAdd) {
-    SuffixTreeNode *NeedsLink = nullptr;
-
-    while (SuffixesToAdd > 0) {
-
-      // Are we waiting to add anything other than just the last character?
-      if (Active.Len == 0) {
-        // If not, then say the active index is the end index.
-        Active.Idx = EndIdx;
-      }
-
-      assert(Active.Idx <= EndIdx && "Start index can't be after end index!");
-
-      // The first character in the current substring we're looking at.
-      unsigned FirstChar = Str[Active.Idx];
-
-      // Have we inserted anything starting with FirstChar at the current node?
-      if (Active.Node->Children.count(FirstChar) == 0) {
-        // If not, then we can just insert a leaf and move too the next step.
-        insertLeaf(*Active.Node, EndIdx, FirstChar);
-
-        // The active node is an internal node, and we visited it, so it must
-        // need a link if it doesn't have one.
-        if (NeedsLink) {
-          NeedsLink->Link = Active.Node;
-          NeedsLink = nullptr;
-        }
-      } else {
-        // There's a match with FirstChar, so look for the point in the tree to
-        // insert a new node.
-        SuffixTreeNode *NextNode = Active.Node->Children[FirstChar];
-
-        unsigned SubstringLen = NextNode->size();
-
-        // Is the current suffix we're trying to insert longer than the size of
-        // the child we want to move to?
-        if (Active.Len >= SubstringLen) {
-          // If yes, then consume the characters we've seen and move to the next
-          // node.
-          Active.Idx += SubstringLen;
-          Active.Len -= SubstringLen;
-          Active.Node = NextNode;
-          continue;
-        }
-
-        // Otherwise, the suffix we're trying to insert must be contained in the
-        // next node we want to move to.
-        unsigned LastChar = Str[EndIdx];
-
-        // Is the string we're trying to insert a substring of the next node?
-        if (Str[NextNode->StartIdx + Active.Len] == LastChar) {
-          // If yes, then we're done for this step. Remember our insertion point
-          // and move to the next end index. At this point, we have an implicit
-          // suffix tree.
-          if (NeedsLink && !Active.Node->isRoot()) {
-            NeedsLink->Link = Active.Node;
-            NeedsLink = nullptr;
-          }
-
-          Active.Len++;
-          break;
-        }
-
-        // The string we're trying to insert isn't a substring of the next node,
-        // but matches up to a point. Split the node.
-        //
-        // For example, say we ended our search at a node n and we're trying to
-        // insert ABD. Then we'll create a new node s for AB, reduce n to just
-        // representing C, and insert a new leaf node l to represent d. This
-        // allows us to ensure that if n was a leaf, it remains a leaf.
-        //
-        //   | ABC  ---split--->  | AB
-        //   n                    s
-        //                     C / \ D
-        //                      n   l
-
-        // The node s from the diagram
-        SuffixTreeNode *SplitNode =
-            insertInternalNode(Active.Node, NextNode->StartIdx,
-                               NextNode->StartIdx + Active.Len - 1, FirstChar);
-
-        // Insert the new node representing the new substring into the tree as
-        // a child of the split node. This is the node l from the diagram.
-        insertLeaf(*SplitNode, EndIdx, LastChar);
-
-        // Make the old node a child of the split node and update its start
-        // index. This is the node n from the diagram.
-        NextNode->StartIdx += Active.Len;
-        SplitNode->Children[Str[NextNode->StartIdx]] = NextNode;
-
-        // SplitNode is an internal node, update the suffix link.
-        if (NeedsLink)
-          NeedsLink->Link = SplitNode;
-
-        NeedsLink = SplitNode;
-      }
-
-      // We've added something new to the tree, so there's one less suffix to
-      // add.
-      SuffixesToAdd--;
-
-      if (Active.Node->isRoot()) {
-        if (Active.Len > 0) {
-          Active.Len--;
-          Active.Idx = EndIdx - SuffixesToAdd + 1;
-        }
-      } else {
-        // Start the next phase at the next smallest suffix.
-        Active.Node = Active.Node->Link;
-      }
-    }
-
-    return SuffixesToAdd;
-  }
-
-public:
-  /// Construct a suffix tree from a sequence of unsigned integers.
-  ///
-  /// \param Str The string to construct the suffix tree for.
-  SuffixTree(const std::vector<unsigned> &Str) : Str(Str) {
-    Root = insertInternalNode(nullptr, EmptyIdx, EmptyIdx, 0);
-    Active.Node = Root;
-
-    // Keep track of the number of suffixes we have to add of the current
-    // prefix.
-    unsigned SuffixesToAdd = 0;
-    Active.Node = Root;
-
-    // Construct the suffix tree iteratively on each prefix of the string.
-    // PfxEndIdx is the end index of the current prefix.
-    // End is one past the last element in the string.
-    for (unsigned PfxEndIdx = 0, End = Str.size(); PfxEndIdx < End;
-         PfxEndIdx++) {
-      SuffixesToAdd++;
-      LeafEndIdx = PfxEndIdx; // Extend each of the leaves.
-      SuffixesToAdd = extend(PfxEndIdx, SuffixesToAdd);
-    }
-
-    // Set the suffix indices of each leaf.
-    assert(Root && "Root node can't be nullptr!");
-    setSuffixIndices(*Root, 0);
-  }
-
-
-  /// Iterator for finding all repeated substrings in the suffix tree.
-  struct RepeatedSubstringIterator {
-    private:
-    /// The current node we're visiting.
-    SuffixTreeNode *N = nullptr;
-
-    /// The repeated substring associated with this node.
-    RepeatedSubstring RS;
-
-    /// The nodes left to visit.
-    std::vector<SuffixTreeNode *> ToVisit;
-
-    /// The minimum length of a repeated substring to find.
-    /// Since we're outlining, we want at least two instructions in the range.
-    /// FIXME: This may not be true for targets like X86 which support many
-    /// instruction lengths.
-    const unsigned MinLength = 2;
-
-    /// Move the iterator to the next repeated substring.
-    void advance() {
-      // Clear the current state. If we're at the end of the range, then this
-      // is the state we want to be in.
-      RS = RepeatedSubstring();
-      N = nullptr;
-
-      // Continue visiting nodes until we find one which repeats more than once.
-      while (!ToVisit.empty()) {
-        SuffixTreeNode *Curr = ToVisit.back();
-        ToVisit.pop_back();
-
-        // Keep track of the length of the string associated with the node. If
-        // it's too short, we'll quit.
-        unsigned Length = Curr->ConcatLen;
-
-        // Each leaf node represents a repeat of a string.
-        std::vector<SuffixTreeNode *> LeafChildren;
-
-        // Iterate over each child, saving internal nodes for visiting, and
-        // leaf nodes in LeafChildren. Internal nodes represent individual
-        // strings, which may repeat.
-        for (auto &ChildPair : Curr->Children) {
-          // Save all of this node's children for processing.
-          if (!ChildPair.second->isLeaf())
-            ToVisit.push_back(ChildPair.second);
-
-          // It's not an internal node, so it must be a leaf. If we have a
-          // long enough string, then save the leaf children.
-          else if (Length >= MinLength)
-            LeafChildren.push_back(ChildPair.second);
-        }
-
-        // The root never represents a repeated substring. If we're looking at
-        // that, then skip it.
-        if (Curr->isRoot())
-          continue;
-
-        // Do we have any repeated substrings?
-        if (LeafChildren.size() >= 2) {
-          // Yes. Update the state to reflect this, and then bail out.
-          N = Curr;
-          RS.Length = Length;
-          for (SuffixTreeNode *Leaf : LeafChildren)
-            RS.StartIndices.push_back(Leaf->SuffixIdx);
-          break;
-        }
-      }
-
-      // At this point, either NewRS is an empty RepeatedSubstring, or it was
-      // set in the above loop. Similarly, N is either nullptr, or the node
-      // associated with NewRS.
-    }
-
-  public:
-    /// Return the current repeated substring.
-    RepeatedSubstring &operator*() { return RS; }
-
-    RepeatedSubstringIterator &operator++() {
-      advance();
-      return *this;
-    }
-
-    RepeatedSubstringIterator operator++(int I) {
-      RepeatedSubstringIterator It(*this);
-      advance();
-      return It;
-    }
-
-    bool operator==(const RepeatedSubstringIterator &Other) {
-      return N == Other.N;
-    }
-    bool operator!=(const RepeatedSubstringIterator &Other) {
-      return !(*this == Other);
-    }
+// Set to true to find the repeated sequences of instructions with a suffix
+// array rather than a suffix tree. Both find the same sequences, but the suffix
+// array is built in a fraction of the memory, which matters when outlining
+// whole programs in LTO.
+static cl::opt<bool> UseSuffixArray(
+    "outliner-use-suffix-array", cl::Hidden,
+    cl::desc("Find outlining candidates with a suffix array"),
+    cl::init(false));
 
-    RepeatedSubstringIterator(SuffixTreeNode *N) : N(N) {
-      // Do we have a non-null node?
-      if (N) {
-        // Yes. At the first step, we need to visit all of N's children.
-        // Note: This means that we visit N last.
-        ToVisit.push_back(N);
-        advance();
-      }
-    }
-};
+// The number of times to outline from the module. Each round outlines from the
+// code the previous ones left, outlined functions included, so it can find
+// sequences that only repeat once others were replaced by calls, or that
+// contain such calls.
+static cl::opt<unsigned> OutlinerRounds(
+    "outliner-rounds", cl::Hidden,
+    cl::desc("Number of rounds of outlining to run; stops after the first "
+             "round that outlines nothing"),
+    cl::init(1));
+
+// Set to true to choose between overlapping candidates by the benefit of their
+// whole functions, most beneficial first, rather than pairwise as they are
+// found. A function loses the call overhead of the occurrences it gives up, and
+// is dropped if what is left of it no longer pays for its frame.
+static cl::opt<bool> RankByBenefit(
+    "outliner-rank-by-benefit", cl::Hidden,
+    cl::desc("Outline the functions that save the most bytes first"),
+    cl::init(false));
 
-  typedef RepeatedSubstringIterator iterator;
-  iterator begin() { return iterator(Root); }
-  iterator end() { return iterator(nullptr); }
-};
+namespace {
 
 /// Maps \p MachineInstrs to unsigned integers and stores the mappings.
 struct InstructionMapper {
@@ -852,6 +382,10 @@ struct MachineOutliner : public ModulePass {
   /// Set when the pass is constructed in TargetPassConfig.
   bool RunOnAllFunctions = true;
 
+  /// The round of outlining being run, from 0. Functions outlined after the
+  /// first round have the round in their names, to keep them unique.
+  unsigned OutlineRound = 0;
+
   StringRef getPassName() const override { return "Machine Outliner"; }
 
   void getAnalysisUsage(AnalysisUsage &AU) const override {
@@ -874,6 +408,10 @@ struct MachineOutliner : public ModulePass {
   /// Remark output explaining that a function was outlined.
   void emitOutlinedFunctionRemark(OutlinedFunction &OF);
 
+  /// Remark output summarizing what a round of outlining saved, for the
+  /// functions of \p FunctionList that were created.
+  void emitOutliningRoundRemark(std::vector<OutlinedFunction> &FunctionList);
+
   /// Find all repeated substrings that satisfy the outlining cost model.
   ///
   /// If a substring appears at least twice, then it must be represented by
@@ -883,7 +421,8 @@ struct MachineOutliner : public ModulePass {
   /// internal node represents a beneficial substring, then we use each of
   /// its leaf children to find the locations of its substring.
   ///
-  /// \param ST A suffix tree to query.
+  /// \param Repeats The internal nodes of the suffix tree of the mapping,
+  /// with the start indices of their leaf children.
   /// \param Mapper Contains outlining mapping information.
   /// \param[out] CandidateList Filled with candidates representing each
   /// beneficial substring.
@@ -892,7 +431,7 @@ struct MachineOutliner : public ModulePass {
   ///
   /// \returns The length of the longest candidate found.
   unsigned
-  findCandidates(SuffixTree &ST,
+  findCandidates(ArrayRef<RepeatedSubstring> Repeats,
                  InstructionMapper &Mapper,
                  std::vector<std::shared_ptr<Candidate>> &CandidateList,
                  std::vector<OutlinedFunction> &FunctionList);
@@ -952,6 +491,16 @@ struct MachineOutliner : public ModulePass {
                      std::vector<OutlinedFunction> &FunctionList,
                      InstructionMapper &Mapper, unsigned MaxCandidateLen);
 
+  /// Remove overlapping candidates by taking the functions in \p FunctionList
+  /// by decreasing benefit, and keeping the candidates of each one that don't
+  /// overlap the candidates kept before. A function that no longer has any
+  /// benefit once it loses its overlapping candidates loses all of them.
+  ///
+  /// \param[in,out] FunctionList A list of functions to be outlined.
+  /// \param Mapper Contains instruction mapping info for outlining.
+  void pruneByBenefit(std::vector<OutlinedFunction> &FunctionList,
+                      InstructionMapper &Mapper);
+
   /// Construct a suffix tree on the instructions in \p M and outline repeated
   /// strings from that tree.
   bool runOnModule(Module &M) override;
@@ -1064,8 +613,36 @@ void MachineOutliner::emitOutlinedFunctionRemark(OutlinedFunction &OF) {
   MORE.emit(R);
 }
 
+void MachineOutliner::emitOutliningRoundRemark(
+    std::vector<OutlinedFunction> &FunctionList) {
+  unsigned BytesSaved = 0;
+  unsigned NumFunctions = 0;
+  unsigned NumCandidates = 0;
+  MachineFunction *FirstMF = nullptr;
+  for (OutlinedFunction &OF : FunctionList) {
+    if (!OF.MF)
+      continue;
+    if (!FirstMF)
+      FirstMF = OF.MF;
+    BytesSaved += OF.getBenefit();
+    NumFunctions++;
+    NumCandidates += OF.getOccurrenceCount();
+  }
+  if (!FirstMF)
+    return;
+
+  MachineOptimizationRemarkEmitter MORE(*FirstMF, nullptr);
+  MachineOptimizationRemark R(DEBUG_TYPE, "OutliningRound", DiagnosticLocation(),
+                              &FirstMF->front());
+  R << "Round " << NV("Round", OutlineRound + 1) << " saved "
+    << NV("BytesSaved", BytesSaved) << " bytes by outlining "
+    << NV("NumCandidates", NumCandidates) << " sequences into "
+    << NV("NumFunctions", NumFunctions) << " functions";
+  MORE.emit(R);
+}
+
 unsigned MachineOutliner::findCandidates(
-    SuffixTree &ST, InstructionMapper &Mapper,
+    ArrayRef<RepeatedSubstring> Repeats, InstructionMapper &Mapper,
     std::vector<std::shared_ptr<Candidate>> &CandidateList,
     std::vector<OutlinedFunction> &FunctionList) {
   CandidateList.clear();
@@ -1074,8 +651,7 @@ unsigned MachineOutliner::findCandidates(
 
   // First, find dall of the repeated substrings in the tree of minimum length
   // 2.
-  for (auto It = ST.begin(), Et = ST.end(); It != Et; ++It) {
-    SuffixTree::RepeatedSubstring RS = *It;
+  for (const RepeatedSubstring &RS : Repeats) {
     std::vector<Candidate> CandidatesForRepeatedSeq;
     unsigned StringLen = RS.Length;
     for (const unsigned &StartIdx : RS.StartIndices) {
@@ -1142,7 +718,7 @@ unsigned MachineOutliner::findCandidates(
     std::vector<unsigned> Seq;
     unsigned StartIdx = RS.StartIndices[0]; // Grab any start index.
     for (unsigned i = StartIdx; i < StartIdx + StringLen; i++)
-      Seq.push_back(ST.Str[i]);
+      Seq.push_back(Mapper.UnsignedVec[i]);
     OF.Sequence = Seq;
 
     // Is it better to outline this candidate than not?
@@ -1282,18 +858,78 @@ void MachineOutliner::pruneOverlaps(
   }
 }
 
+void MachineOutliner::pruneByBenefit(
+    std::vector<OutlinedFunction> &FunctionList, InstructionMapper &Mapper) {
+  std::vector<unsigned> Order(FunctionList.size());
+  std::iota(Order.begin(), Order.end(), 0);
+  std::stable_sort(Order.begin(), Order.end(),
+                   [&FunctionList](unsigned LHS, unsigned RHS) {
+                     return FunctionList[LHS].getBenefit() >
+                            FunctionList[RHS].getBenefit();
+                   });
+
+  // The instructions covered by the candidates kept so far.
+  BitVector Taken(Mapper.UnsignedVec.size());
+  auto Overlaps = [&Taken](const Candidate &C) {
+    for (unsigned Idx = C.getStartIdx(), E = C.getEndIdx(); Idx <= E; ++Idx)
+      if (Taken[Idx])
+        return true;
+    return false;
+  };
+
+  auto IsPruned = [](const std::shared_ptr<Candidate> &C) {
+    return !C->InCandidateList;
+  };
+
+  for (unsigned FnIdx : Order) {
+    OutlinedFunction &OF = FunctionList[FnIdx];
+    for (std::shared_ptr<Candidate> &C : OF.Candidates)
+      if (C->InCandidateList && Overlaps(*C))
+        prune(*C, FunctionList);
+
+    // Drop the occurrences the function gave up: only the ones it keeps pay
+    // a call overhead, are replaced by calls, and are reported.
+    OF.Candidates.erase(
+        std::remove_if(OF.Candidates.begin(), OF.Candidates.end(), IsPruned),
+        OF.Candidates.end());
+
+    if (OF.getBenefit() < 1) {
+      for (std::shared_ptr<Candidate> &C : OF.Candidates)
+        prune(*C, FunctionList);
+      OF.Candidates.clear();
+      continue;
+    }
+
+    for (std::shared_ptr<Candidate> &C : OF.Candidates)
+      if (C->InCandidateList)
+        Taken.set(C->getStartIdx(), C->getEndIdx() + 1);
+  }
+}
+
 unsigned MachineOutliner::buildCandidateList(
     std::vector<std::shared_ptr<Candidate>> &CandidateList,
     std::vector<OutlinedFunction> &FunctionList,
     InstructionMapper &Mapper) {
-  // Construct a suffix tree and use it to find candidates.
-  SuffixTree ST(Mapper.UnsignedVec);
+  // Find the repeated substrings of the mapping, and use them to find
+  // candidates. The suffix array finds the same substrings as the suffix tree,
+  // but only needs two integers per instruction where the tree allocates a
+  // node and a map of children.
+  std::vector<RepeatedSubstring> Repeats;
+  if (UseSuffixArray) {
+    SuffixArray SA(Mapper.UnsignedVec);
+    SA.forEachRepeatedSubstring(
+        [&Repeats](const RepeatedSubstring &RS) { Repeats.push_back(RS); });
+  } else {
+    SuffixTree ST(Mapper.UnsignedVec);
+    for (auto It = ST.begin(), Et = ST.end(); It != Et; ++It)
+      Repeats.push_back(*It);
+  }
 
   std::vector<unsigned> CandidateSequence; // Current outlining candidate.
   unsigned MaxCandidateLen = 0;            // Length of the longest candidate.
 
   MaxCandidateLen =
-      findCandidates(ST, Mapper, CandidateList, FunctionList);
+      findCandidates(Repeats, Mapper, CandidateList, FunctionList);
 
   // Sort the candidates in decending order. This will simplify the outlining
   // process when we have to remove the candidates from the mapping by
@@ -1306,6 +942,64 @@ unsigned MachineOutliner::buildCandidateList(
   return MaxCandidateLen;
 }
 
+/// Sets up the liveness of the outlined function in \p MBB, so that later
+/// rounds of outlining can outline from it. The registers live into any of the
+/// candidates of \p OF are live into it, and the registers live out of any of
+/// them stay live until it returns, unless it ends in a call of its own.
+static void addOutlinedFunctionLiveness(MachineBasicBlock &MBB,
+                                        const OutlinedFunction &OF) {
+  MachineFunction &MF = *MBB.getParent();
+  const MachineRegisterInfo &MRI = MF.getRegInfo();
+  const TargetSubtargetInfo &STI = MF.getSubtarget();
+  const TargetRegisterInfo &TRI = *STI.getRegisterInfo();
+  LivePhysRegs LiveIns(TRI), LiveOuts(TRI);
+  for (const std::shared_ptr<Candidate> &C : OF.Candidates) {
+    if (!C->InCandidateList)
+      continue;
+    MachineBasicBlock &CandMBB = *C->getMBB();
+    LivePhysRegs CandLiveRegs(TRI);
+    CandLiveRegs.addLiveOuts(CandMBB);
+    MachineBasicBlock::reverse_iterator RI = CandMBB.rbegin();
+    for (MachineBasicBlock::reverse_iterator RE = C->back().getReverse();
+         RI != RE; ++RI)
+      CandLiveRegs.stepBackward(*RI);
+    for (MCPhysReg Reg : CandLiveRegs)
+      LiveOuts.addReg(Reg);
+    for (MachineBasicBlock::reverse_iterator RE =
+             std::next(C->front().getReverse());
+         RI != RE; ++RI)
+      CandLiveRegs.stepBackward(*RI);
+    for (MCPhysReg Reg : CandLiveRegs)
+      LiveIns.addReg(Reg);
+  }
+  // The target may have added live-ins for the frame it built.
+  for (const MachineBasicBlock::RegisterMaskPair &LI : MBB.liveins())
+    LiveIns.addReg(LI.PhysReg);
+  MBB.clearLiveIns();
+  addLiveIns(MBB, LiveIns);
+
+  MachineInstr &Ret = MBB.back();
+  if (Ret.isReturn() && !Ret.isCall()) {
+    // A return copied from a candidate may only have an undef use of the
+    // return address, which the caller's liveness had from its callee-saved
+    // registers.
+    LivePhysRegs RetUses(TRI);
+    RetUses.addUses(Ret);
+    for (MCPhysReg Reg : LiveOuts) {
+      if (MRI.isReserved(Reg) || RetUses.contains(Reg))
+        continue;
+      // Only add the largest live registers.
+      bool ContainsSuperReg = false;
+      for (MCSuperRegIterator SReg(Reg, &TRI); SReg.isValid(); ++SReg)
+        if (LiveOuts.contains(*SReg) && !MRI.isReserved(*SReg))
+          ContainsSuperReg = true;
+      if (!ContainsSuperReg)
+        Ret.addOperand(MF, MachineOperand::CreateReg(Reg, /*isDef=*/false,
+                                                     /*isImp=*/true));
+    }
+  }
+}
+
 MachineFunction *
 MachineOutliner::createOutlinedFunction(Module &M, const OutlinedFunction &OF,
                                         InstructionMapper &Mapper,
@@ -1317,7 +1011,10 @@ MachineOutliner::createOutlinedFunction(Module &M, const OutlinedFunction &OF,
   std::ostringstream NameStream;
   // FIXME: We should have a better naming scheme. This should be stable,
   // regardless of changes to the outliner's cost model/traversal order.
-  NameStream << "OUTLINED_FUNCTION_" << Name;
+  NameStream << "OUTLINED_FUNCTION_";
+  if (OutlineRound > 0)
+    NameStream << OutlineRound + 1 << "_";
+  NameStream << Name;
 
   // Create the function using an IR-level function.
   LLVMContext &C = M.getContext();
@@ -1359,12 +1056,23 @@ MachineOutliner::createOutlinedFunction(Module &M, const OutlinedFunction &OF,
   // Insert the new function into the module.
   MF.insert(MF.begin(), &MBB);
 
+  // Outlined functions shouldn't preserve liveness, unless a later round of
+  // outlining may outline from them. Targets check the property when they
+  // build the frame.
+  bool KeepLiveness = OutlinerRounds > 1;
+  if (!KeepLiveness)
+    MF.getProperties().reset(
+        MachineFunctionProperties::Property::TracksLiveness);
+
   // Copy over the instructions for the function using the integer mappings in
   // its sequence.
   for (unsigned Str : OF.Sequence) {
     MachineInstr *NewMI =
         MF.CloneMachineInstr(Mapper.IntegerInstructionMap.find(Str)->second);
     NewMI->dropMemRefs(MF);
+    // The candidates may differ in where registers die.
+    if (KeepLiveness)
+      NewMI->clearKillInfo();
 
     // Don't keep debug information for outlined instructions.
     NewMI->setDebugLoc(DebugLoc());
@@ -1372,11 +1080,11 @@ MachineOutliner::createOutlinedFunction(Module &M, const OutlinedFunction &OF,
   }
 
   TII.buildOutlinedFrame(MBB, MF, OF);
-
-  // Outlined functions shouldn't preserve liveness.
-  MF.getProperties().reset(MachineFunctionProperties::Property::TracksLiveness);
   MF.getRegInfo().freezeReservedRegs(MF);
 
+  if (KeepLiveness)
+    addOutlinedFunctionLiveness(MBB, OF);
+
   // If there's a DISubprogram associated with this outlined function, then
   // emit debug info for the outlined function.
   if (DISubprogram *SP = getSubprogramOrNull(OF)) {
@@ -1648,19 +1356,6 @@ bool MachineOutliner::runOnModule(Module &M) {
   // If the user specifies that they want to outline from linkonceodrs, set
   // it here.
   OutlineFromLinkOnceODRs = EnableLinkOnceODROutlining;
-  InstructionMapper Mapper;
-
-  // Prepare instruction mappings for the suffix tree.
-  populateMapper(Mapper, M, MMI);
-  std::vector<std::shared_ptr<Candidate>> CandidateList;
-  std::vector<OutlinedFunction> FunctionList;
-
-  // Find all of the outlining candidates.
-  unsigned MaxCandidateLen =
-      buildCandidateList(CandidateList, FunctionList, Mapper);
-
-  // Remove candidates that overlap with other candidates.
-  pruneOverlaps(CandidateList, FunctionList, Mapper, MaxCandidateLen);
 
   // If we've requested size remarks, then collect the MI counts of every
   // function before outlining, and the MI counts after outlining.
@@ -1676,8 +1371,36 @@ bool MachineOutliner::runOnModule(Module &M) {
   if (ShouldEmitSizeRemarks)
     initSizeRemarkInfo(M, MMI, FunctionToInstrCount);
 
-  // Outline each of the candidates and return true if something was outlined.
-  bool OutlinedSomething = outline(M, CandidateList, FunctionList, Mapper);
+  bool OutlinedSomething = false;
+  for (OutlineRound = 0; OutlineRound < OutlinerRounds; OutlineRound++) {
+    InstructionMapper Mapper;
+
+    // Prepare instruction mappings for the suffix tree.
+    populateMapper(Mapper, M, MMI);
+    std::vector<std::shared_ptr<Candidate>> CandidateList;
+    std::vector<OutlinedFunction> FunctionList;
+
+    // Find all of the outlining candidates.
+    unsigned MaxCandidateLen =
+        buildCandidateList(CandidateList, FunctionList, Mapper);
+
+    // Remove candidates that overlap with other candidates.
+    if (RankByBenefit)
+      pruneByBenefit(FunctionList, Mapper);
+    else
+      pruneOverlaps(CandidateList, FunctionList, Mapper, MaxCandidateLen);
+
+    // Outline each of the candidates. Stop once a round has nothing left to
+    // outline: the next one would find the same candidates.
+    if (!outline(M, CandidateList, FunctionList, Mapper))
+      break;
+    OutlinedSomething = true;
+
+    LLVM_DEBUG(dbgs() << "Finished outlining round " << OutlineRound + 1
+                      << "\n");
+    if (OutlinerRounds > 1)
+      emitOutliningRoundRemark(FunctionList);
+  }
 
   // If we outlined something, we definitely changed the MI count of the
   // module. If we've asked for size remarks, then output them.
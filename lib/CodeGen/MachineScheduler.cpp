@@ -19,6 +19,7 @@
 #include "llvm/ADT/PriorityQueue.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/CodeGen/LiveInterval.h"
@@ -73,6 +74,9 @@ using namespace llvm;
 
 #define DEBUG_TYPE "machine-scheduler"
 
+STATISTIC(NumRegionsOverLimit,
+          "Number of scheduling regions left in source order for their size");
+
 namespace llvm {
 
 cl::opt<bool> ForceTopDown("misched-topdown", cl::Hidden,
@@ -126,6 +130,13 @@ static cl::opt<bool> EnableMemOpCluster("misched-cluster", cl::Hidden,
 static cl::opt<bool> VerifyScheduling("verify-misched", cl::Hidden,
   cl::desc("Verify machine instrs before and after machine scheduling"));
 
+/// Building the dependence graph and tracking register pressure dominate the
+/// compile time of large regions, such as fully unrolled loops.
+static cl::opt<unsigned> MaxRegionInstrs("misched-max-region-instrs",
+  cl::Hidden, cl::init(0),
+  cl::desc("Leave regions of more than N instructions in source order "
+           "(0 = unlimited)"));
+
 // DAG subtrees must have at least this many nodes.
 static const unsigned MinSubtreeSize = 8;
 
@@ -566,6 +577,16 @@ void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
         errs() << " " << MBB->getName() << " \n";
       }
 
+      // Keep the source order of regions too large to schedule in reasonable
+      // time, without building their DAG.
+      if (MaxRegionInstrs && NumRegionInstrs > MaxRegionInstrs) {
+        LLVM_DEBUG(dbgs() << "Region exceeds " << MaxRegionInstrs
+                          << " instructions; keeping source order\n");
+        ++NumRegionsOverLimit;
+        Scheduler.exitRegion();
+        continue;
+      }
+
       // Schedule a region: possibly reorder instructions.
       // This invalidates the original region iterators.
       Scheduler.schedule();
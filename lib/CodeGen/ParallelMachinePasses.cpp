@@ -0,0 +1,241 @@
+//===- ParallelMachinePasses.cpp - Run machine passes on several threads --===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the pass that -machine-function-threads puts in the
+// codegen pipeline in place of the machine passes that run on instruction
+// selected code. It runs them on several functions at once: each worker thread
+// has a function pass manager of its own, with copies of those passes built by
+// a TargetPassConfig of its own, and shares the MachineModuleInfo and the other
+// module level analyses of the main pass manager.
+//
+// Instruction selection (and the IR passes before it) runs on the main thread
+// for all functions before this pass, and emission on the main thread, in
+// module order, after it, so the output does not depend on the number of
+// threads.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/CodeGen/GCMetadata.h"
+#include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/Passes.h"
+#include "llvm/CodeGen/TargetPassConfig.h"
+#include "llvm/IR/DiagnosticHandler.h"
+#include "llvm/IR/IRPrintingPasses.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Target/TargetMachine.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace llvm;
+
+#define DEBUG_TYPE "parallel-machine-passes"
+
+STATISTIC(NumParallelFunctions,
+          "Number of functions compiled on worker threads");
+
+namespace {
+
+/// Makes an immutable pass of the main pass manager available in the pass
+/// manager of a worker. It has the ID of that pass and hands it out when it is
+/// queried, but does not own it, nor initialize or finalize it.
+class ImmutablePassRef : public ImmutablePass {
+  ImmutablePass &Target;
+
+public:
+  explicit ImmutablePassRef(ImmutablePass &Target)
+      : ImmutablePass(
+            *const_cast<char *>(static_cast<const char *>(Target.getPassID()))),
+        Target(Target) {}
+
+  void *getAdjustedAnalysisPointer(AnalysisID ID) override {
+    return Target.getAdjustedAnalysisPointer(ID);
+  }
+};
+
+class ParallelMachinePasses : public ModulePass {
+public:
+  static char ID;
+
+  explicit ParallelMachinePasses(unsigned NumThreads = 1)
+      : ModulePass(ID), NumThreads(NumThreads) {
+    initializeParallelMachinePassesPass(*PassRegistry::getPassRegistry());
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<MachineModuleInfo>();
+    AU.addRequired<TargetPassConfig>();
+    AU.addRequired<TargetLibraryInfoWrapperPass>();
+    AU.addRequired<AssumptionCacheTracker>();
+    AU.setPreservesAll();
+  }
+
+  bool runOnModule(Module &M) override;
+
+private:
+  /// A pass manager with the machine passes, and the pass configuration that
+  /// created them.
+  struct Worker {
+    std::unique_ptr<TargetPassConfig> PassConfig;
+    std::unique_ptr<legacy::FunctionPassManager> FPM;
+  };
+
+  unsigned NumThreads;
+
+  std::unique_ptr<Worker> createWorker(Module &M);
+};
+
+} // end anonymous namespace
+
+char ParallelMachinePasses::ID = 0;
+
+INITIALIZE_PASS_BEGIN(ParallelMachinePasses, DEBUG_TYPE,
+                      "Parallel Machine Passes", false, false)
+INITIALIZE_PASS_DEPENDENCY(MachineModuleInfo)
+INITIALIZE_PASS_DEPENDENCY(TargetPassConfig)
+INITIALIZE_PASS_DEPENDENCY(TargetLibraryInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(AssumptionCacheTracker)
+INITIALIZE_PASS_END(ParallelMachinePasses, DEBUG_TYPE,
+                    "Parallel Machine Passes", false, false)
+
+ModulePass *llvm::createParallelMachinePassesPass(unsigned NumThreads) {
+  return new ParallelMachinePasses(NumThreads);
+}
+
+/// Returns true if the machine passes can run on several functions of \p M at
+/// once. Some of the state they update, and the output they print, is shared
+/// by all the functions without being synchronized.
+static bool canCompileInParallel(const Module &M, const TargetMachine &TM) {
+  if (!llvm_is_multithreaded())
+    return false;
+
+  // Debug info metadata is uniqued in the LLVMContext, while GC maps and
+  // split stacks are tracked by module level analyses.
+  if (M.debug_compile_units_begin() != M.debug_compile_units_end())
+    return false;
+  for (const Function &F : M)
+    if (F.hasGC() || F.hasFnAttribute("split-stack"))
+      return false;
+
+  LLVMContext &Ctx = M.getContext();
+  if (Ctx.getDiagnosticsOutputFile() ||
+      Ctx.getDiagHandlerPtr()->isAnyRemarkEnabled())
+    return false;
+  if (TimePassesIsEnabled || TM.Options.PrintMachineCode ||
+      shouldPrintBeforePass() || shouldPrintAfterPass())
+    return false;
+#ifndef NDEBUG
+  if (DebugFlag)
+    return false;
+#endif
+  return true;
+}
+
+std::unique_ptr<ParallelMachinePasses::Worker>
+ParallelMachinePasses::createWorker(Module &M) {
+  auto W = llvm::make_unique<Worker>();
+  W->FPM = llvm::make_unique<legacy::FunctionPassManager>(&M);
+
+  // The machine functions, the options of the pipeline and the library info
+  // are those of the main pass manager, as is the GC metadata.
+  W->FPM->add(new ImmutablePassRef(getAnalysis<MachineModuleInfo>()));
+  W->FPM->add(new ImmutablePassRef(getAnalysis<TargetPassConfig>()));
+  W->FPM->add(
+      new ImmutablePassRef(getAnalysis<TargetLibraryInfoWrapperPass>()));
+  W->FPM->add(new ImmutablePassRef(getAnalysis<AssumptionCacheTracker>()));
+  if (auto *GCMI = getAnalysisIfAvailable<GCModuleInfo>())
+    W->FPM->add(new ImmutablePassRef(*GCMI));
+
+  auto &TM = getAnalysis<TargetPassConfig>().getTM<LLVMTargetMachine>();
+  W->PassConfig.reset(TM.createPassConfig(*W->FPM));
+  W->PassConfig->addParallelMachinePasses();
+  W->PassConfig->setInitialized();
+
+  W->FPM->doInitialization();
+  return W;
+}
+
+bool ParallelMachinePasses::runOnModule(Module &M) {
+  const TargetMachine &TM =
+      getAnalysis<TargetPassConfig>().getTM<LLVMTargetMachine>();
+  MachineModuleInfo &MMI = getAnalysis<MachineModuleInfo>();
+
+  SmallVector<Function *, 64> Functions;
+  for (Function &F : M)
+    if (!F.isDeclaration() && !F.hasAvailableExternallyLinkage())
+      Functions.push_back(&F);
+  if (Functions.empty())
+    return false;
+
+  unsigned Threads = std::min<unsigned>(NumThreads, Functions.size());
+  if (!canCompileInParallel(M, TM))
+    Threads = 1;
+  LLVM_DEBUG(dbgs() << "Compiling " << Functions.size() << " functions on "
+                    << Threads << " threads\n");
+
+  std::vector<std::unique_ptr<Worker>> Workers;
+  for (unsigned I = 0; I != Threads; ++I)
+    Workers.push_back(createWorker(M));
+
+  bool Changed = false;
+  if (Threads == 1) {
+    for (Function *F : Functions)
+      Changed |= Workers.front()->FPM->run(*F);
+  } else {
+    // Alias analysis registers value handles in the LLVMContext when it first
+    // looks at the assumptions of a function: do it here for all of them.
+    auto &ACT = getAnalysis<AssumptionCacheTracker>();
+    for (Function *F : Functions)
+      ACT.getAssumptionCache(*F).assumptions();
+
+    MCContext &Ctx = MMI.getContext();
+    Ctx.setThreadSafeSymbols(true);
+
+    // There are as many workers as threads, so one is always free when a
+    // function starts.
+    std::mutex WorkersMutex;
+    std::vector<Worker *> FreeWorkers;
+    for (auto &W : Workers)
+      FreeWorkers.push_back(W.get());
+
+    ThreadPool Pool(Threads);
+    for (Function *F : Functions)
+      Pool.async([&, F]() {
+        Worker *W;
+        {
+          std::lock_guard<std::mutex> Lock(WorkersMutex);
+          W = FreeWorkers.back();
+          FreeWorkers.pop_back();
+        }
+        bool FunctionChanged = W->FPM->run(*F);
+        std::lock_guard<std::mutex> Lock(WorkersMutex);
+        Changed |= FunctionChanged;
+        FreeWorkers.push_back(W);
+      });
+    Pool.wait();
+
+    Ctx.setThreadSafeSymbols(false);
+    NumParallelFunctions += Functions.size();
+  }
+
+  for (auto &W : Workers)
+    W->FPM->doFinalization();
+  return Changed;
+}
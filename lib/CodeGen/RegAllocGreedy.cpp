@@ -85,6 +85,11 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumIntfQueries,  "Number of interference queries");
+STATISTIC(NumEvictChecks,  "Number of registers checked for eviction");
+STATISTIC(NumSplitCands,   "Number of split candidates evaluated");
+STATISTIC(NumOverBudget,   "Number of functions over the effort budget");
+STATISTIC(NumBudgeted,     "Number of ranges allocated over the budget");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -131,6 +136,13 @@ static cl::opt<unsigned>
                               "high compile time cost in global splitting."),
                      cl::init(5000));
 
+static cl::opt<unsigned> EffortBudget(
+    "regalloc-effort-budget", cl::Hidden,
+    cl::desc("Interference queries, evictions and split candidates the greedy "
+             "register allocator may spend per virtual register of a function "
+             "before it stops evicting and region splitting (0 = unlimited)"),
+    cl::init(0));
+
 // FIXME: Find a good default for this flag and remove the flag.
 static cl::opt<unsigned>
 CSRFirstTimeCost("regalloc-csr-first-time-cost",
@@ -237,6 +249,21 @@ class RAGreedy : public MachineFunctionPass,
 
   uint8_t CutOffInfo;
 
+  /// Work spent on the current function: interference queries, evicted
+  /// ranges, and split candidates weighted by the blocks or gaps they cover.
+  uint64_t Effort;
+
+  /// The effort after which the allocator falls back to cheap strategies, or
+  /// 0 for no limit.
+  uint64_t EffortLimit;
+
+  /// Set once Effort has exceeded EffortLimit. From then on, ranges only get
+  /// free registers, block and instruction splitting, and spilling. Eviction
+  /// is kept for unspillable ranges, which need it to be allocated at all.
+  bool OverBudget;
+
+  void addEffort(uint64_t Units) { Effort += Units; }
+
 #ifndef NDEBUG
   static const char *const StageName[];
 #endif
@@ -761,10 +788,13 @@ unsigned RAGreedy::tryAssign(LiveInterval &VirtReg,
                              SmallVectorImpl<unsigned> &NewVRegs) {
   Order.rewind();
   unsigned PhysReg;
-  while ((PhysReg = Order.next()))
+  while ((PhysReg = Order.next())) {
+    ++NumIntfQueries;
+    addEffort(1);
     if (!Matrix->checkInterference(VirtReg, PhysReg))
       break;
-  if (!PhysReg || Order.isHint())
+  }
+  if (!PhysReg || Order.isHint() || OverBudget)
     return PhysReg;
 
   // PhysReg is available, but there may be a better choice.
@@ -867,6 +897,9 @@ bool RAGreedy::shouldEvict(LiveInterval &A, bool IsHint,
 /// @returns True when interference can be evicted cheaper than MaxCost.
 bool RAGreedy::canEvictInterference(LiveInterval &VirtReg, unsigned PhysReg,
                                     bool IsHint, EvictionCost &MaxCost) {
+  ++NumEvictChecks;
+  ++NumIntfQueries;
+  addEffort(1);
   // It is only possible to evict virtual register interference.
   if (Matrix->checkInterference(VirtReg, PhysReg) > LiveRegMatrix::IK_VirtReg)
     return false;
@@ -1073,6 +1106,7 @@ void RAGreedy::evictInterference(LiveInterval &VirtReg, unsigned PhysReg,
            "Cannot decrease cascade number, illegal eviction");
     ExtraRegInfo[Intf->reg].Cascade = Cascade;
     ++NumEvicted;
+    addEffort(1);
     NewVRegs.push_back(Intf->reg);
   }
 }
@@ -1887,6 +1921,8 @@ unsigned RAGreedy::calculateRegionSplitCost(LiveInterval &VirtReg,
       GlobalCand.resize(NumCands+1);
     GlobalSplitCandidate &Cand = GlobalCand[NumCands];
     Cand.reset(IntfCache, PhysReg);
+    ++NumSplitCands;
+    addEffort(1 + SA->getUseBlocks().size());
 
     SpillPlacer->prepare(Cand.LiveBundles);
     BlockFrequency Cost;
@@ -2300,6 +2336,9 @@ unsigned RAGreedy::tryLocalSplit(LiveInterval &VirtReg, AllocationOrder &Order,
 
   Order.rewind();
   while (unsigned PhysReg = Order.next()) {
+    ++NumSplitCands;
+    addEffort(1 + NumGaps);
+
     // Keep track of the largest spill weight that would need to be evicted in
     // order to make use of PhysReg between UseSlots[i] and UseSlots[i+1].
     calcGapWeights(PhysReg, GapWeight);
@@ -2451,9 +2490,11 @@ unsigned RAGreedy::trySplit(LiveInterval &VirtReg, AllocationOrder &Order,
     NamedRegionTimer T("local_split", "Local Splitting", TimerGroupName,
                        TimerGroupDescription, TimePassesIsEnabled);
     SA->analyze(&VirtReg);
-    unsigned PhysReg = tryLocalSplit(VirtReg, Order, NewVRegs);
-    if (PhysReg || !NewVRegs.empty())
-      return PhysReg;
+    if (!OverBudget) {
+      unsigned PhysReg = tryLocalSplit(VirtReg, Order, NewVRegs);
+      if (PhysReg || !NewVRegs.empty())
+        return PhysReg;
+    }
     return tryInstructionSplit(VirtReg, Order, NewVRegs);
   }
 
@@ -2475,8 +2516,9 @@ unsigned RAGreedy::trySplit(LiveInterval &VirtReg, AllocationOrder &Order,
 
   // First try to split around a region spanning multiple blocks. RS_Split2
   // ranges already made dubious progress with region splitting, so they go
-  // straight to single block splitting.
-  if (getStage(VirtReg) < RS_Split2) {
+  // straight to single block splitting, as do all ranges once the function is
+  // over its effort budget.
+  if (getStage(VirtReg) < RS_Split2 && !OverBudget) {
     unsigned PhysReg = tryRegionSplit(VirtReg, Order, NewVRegs);
     if (PhysReg || !NewVRegs.empty())
       return PhysReg;
@@ -2754,6 +2796,23 @@ bool RAGreedy::tryRecoloringCandidates(PQueue &RecoloringQueue,
 unsigned RAGreedy::selectOrSplit(LiveInterval &VirtReg,
                                  SmallVectorImpl<unsigned> &NewVRegs) {
   CutOffInfo = CO_None;
+  if (EffortLimit && !OverBudget && Effort > EffortLimit) {
+    OverBudget = true;
+    ++NumOverBudget;
+    LLVM_DEBUG(dbgs() << "Effort budget of " << EffortLimit
+                      << " exceeded, no more eviction or region splitting\n");
+    using namespace ore;
+    ORE->emit([&]() {
+      MachineOptimizationRemarkAnalysis R(
+          DEBUG_TYPE, "EffortBudget",
+          DiagnosticLocation(MF->getFunction().getSubprogram()), &MF->front());
+      R << "effort budget of " << NV("Budget", EffortLimit)
+        << " exceeded; using cheaper allocation strategies";
+      return R;
+    });
+  }
+  if (OverBudget)
+    ++NumBudgeted;
   LLVMContext &Ctx = MF->getFunction().getContext();
   SmallVirtRegSet FixedRegisters;
   unsigned Reg = selectOrSplitImpl(VirtReg, NewVRegs, FixedRegisters);
@@ -3043,8 +3102,9 @@ unsigned RAGreedy::selectOrSplitImpl(LiveInterval &VirtReg,
 
   // Try to evict a less worthy live range, but only for ranges from the primary
   // queue. The RS_Split ranges already failed to do this, and they should not
-  // get a second chance until they have been split.
-  if (Stage != RS_Split)
+  // get a second chance until they have been split. Over the effort budget,
+  // only ranges that cannot be spilled evict.
+  if (Stage != RS_Split && (!OverBudget || !VirtReg.isSpillable()))
     if (unsigned PhysReg =
             tryEvict(VirtReg, Order, NewVRegs, CostPerUseLimit)) {
       unsigned Hint = MRI->getSimpleHint(VirtReg.reg);
@@ -3235,6 +3295,9 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
   LastEvicted.clear();
+  Effort = 0;
+  EffortLimit = uint64_t(EffortBudget) * MRI->getNumVirtRegs();
+  OverBudget = false;
 
   allocatePhysRegs();
   tryHintsRecoloring();
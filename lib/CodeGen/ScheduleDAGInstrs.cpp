@@ -29,6 +29,7 @@
 #include "llvm/CodeGen/MachineInstr.h"
 #include "llvm/CodeGen/MachineInstrBundle.h"
 #include "llvm/CodeGen/MachineMemOperand.h"
+#include "llvm/CodeGen/MachineModuleInfo.h"
 #include "llvm/CodeGen/MachineOperand.h"
 #include "llvm/CodeGen/MachineRegisterInfo.h"
 #include "llvm/CodeGen/PseudoSourceValue.h"
@@ -58,6 +59,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -109,13 +111,18 @@ static void dumpSUList(ScheduleDAGInstrs::SUList &L) {
 #endif
 }
 
+/// Returns the value that stands for unanalyzable memory accesses. Constants
+/// are shared with the functions compiled on other threads.
+static UndefValue *getUnknownValue(MachineFunction &MF) {
+  std::lock_guard<std::mutex> Lock(MF.getMMI().getIRMutex());
+  return UndefValue::get(Type::getVoidTy(MF.getFunction().getContext()));
+}
+
 ScheduleDAGInstrs::ScheduleDAGInstrs(MachineFunction &mf,
                                      const MachineLoopInfo *mli,
                                      bool RemoveKillFlags)
     : ScheduleDAG(mf), MLI(mli), MFI(mf.getFrameInfo()),
-      RemoveKillFlags(RemoveKillFlags),
-      UnknownValue(UndefValue::get(
-                             Type::getVoidTy(mf.getFunction().getContext()))) {
+      RemoveKillFlags(RemoveKillFlags), UnknownValue(getUnknownValue(mf)) {
   DbgValues.clear();
 
   const TargetSubtargetInfo &ST = mf.getSubtarget();
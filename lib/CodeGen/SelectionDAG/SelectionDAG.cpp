@@ -752,7 +752,7 @@ void SelectionDAG::DeallocateNode(SDNode *N) {
   // If we have operands, deallocate them.
   removeOperands(N);
 
-  NodeAllocator.Deallocate(AllNodes.remove(N));
+  NodeRecycler.Deallocate(NodeAllocator, AllNodes.remove(N));
 
   // Set the opcode to DELETED_NODE to help catch bugs when node
   // memory is reallocated.
@@ -862,6 +862,8 @@ bool SelectionDAG::RemoveNodeFromCSEMaps(SDNode *N) {
     assert(N->getOpcode() != ISD::DELETED_NODE && "DELETED_NODE in CSEMap!");
     assert(N->getOpcode() != ISD::EntryToken && "EntryToken in CSEMap!");
     Erased = CSEMap.RemoveNode(N);
+    // The node may be changed before it is added back; hash it again then.
+    N->CSEHash = 0;
     break;
   }
 #ifndef NDEBUG
@@ -998,7 +1000,8 @@ void SelectionDAG::init(MachineFunction &NewMF,
 SelectionDAG::~SelectionDAG() {
   assert(!UpdateListeners && "Dangling registered DAGUpdateListeners");
   allnodes_clear();
-  OperandRecycler.clear(OperandAllocator);
+  OperandRecycler.clear(NodeAllocator);
+  NodeRecycler.clear(NodeAllocator);
   delete DbgInfo;
 }
 
@@ -1054,8 +1057,9 @@ SDNode *SelectionDAG::FindNodeOrInsertPos(const FoldingSetNodeID &ID,
 
 void SelectionDAG::clear() {
   allnodes_clear();
-  OperandRecycler.clear(OperandAllocator);
-  OperandAllocator.Reset();
+  OperandRecycler.clear(NodeAllocator);
+  NodeRecycler.clear(NodeAllocator);
+  NodeAllocator.Reset();
   CSEMap.clear();
 
   ExtendedValueTypeNodes.clear();
@@ -1684,7 +1688,7 @@ SDValue SelectionDAG::getVectorShuffle(EVT VT, const SDLoc &dl, SDValue N1,
   // Allocate the mask array for the node out of the BumpPtrAllocator, since
   // SDNode doesn't have access to it.  This memory will be "leaked" when
   // the node is deallocated, but recovered when the NodeAllocator is released.
-  int *MaskAlloc = OperandAllocator.Allocate<int>(NElts);
+  int *MaskAlloc = NodeAllocator.Allocate<int>(NElts);
   llvm::copy(MaskVec, MaskAlloc);
 
   auto *N = newSDNode<ShuffleVectorSDNode>(VT, dl.getIROrder(),
@@ -9032,7 +9036,7 @@ SDNode *SelectionDAG::isConstantFPBuildVectorOrConstantFP(SDValue N) {
 void SelectionDAG::createOperands(SDNode *Node, ArrayRef<SDValue> Vals) {
   assert(!Node->OperandList && "Node already has operands");
   SDUse *Ops = OperandRecycler.allocate(
-    ArrayRecycler<SDUse>::Capacity::get(Vals.size()), OperandAllocator);
+    ArrayRecycler<SDUse>::Capacity::get(Vals.size()), NodeAllocator);
 
   bool IsDivergent = false;
   for (unsigned I = 0; I != Vals.size(); ++I) {
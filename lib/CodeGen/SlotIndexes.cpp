@@ -12,7 +12,11 @@
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 
 using namespace llvm;
 
@@ -24,6 +28,7 @@ INITIALIZE_PASS(SlotIndexes, DEBUG_TYPE,
 
 STATISTIC(NumLocalRenum,  "Number of local renumberings");
 STATISTIC(NumGlobalRenum, "Number of global renumberings");
+STATISTIC(NumRelabeled,   "Number of indexes relabeled by local renumberings");
 
 void SlotIndexes::getAnalysisUsage(AnalysisUsage &au) const {
   au.setPreservesAll();
@@ -52,6 +57,7 @@ bool SlotIndexes::runOnMachineFunction(MachineFunction &fn) {
   // only need to be set up once after the first numbering is computed.
 
   mf = &fn;
+  NumRenumberedEntries = 0;
 
   // Check that the list contains only the sentinal.
   assert(indexList.empty() && "Index list non-empty at initial numbering?");
@@ -159,24 +165,112 @@ void SlotIndexes::renumberIndexes() {
   }
 }
 
+// Indexes are handed out in units of Slot_Count, so that each entry has a slot
+// for every SlotIndex::Slot. There are 2^MaxLevel units.
+static const unsigned MaxLevel = 30;
+
+/// The number of entries an aligned range of 2^Level units may hold without
+/// being relabeled as part of a larger range.
+///
+/// This is the order-maintenance scheme of Bender et al. ("Two Simplified
+/// Algorithms for Maintaining Order in a List"). The allowed density falls
+/// geometrically with the level, so that after a range is relabeled, its
+/// subranges have room for a number of insertions proportional to their size
+/// before they fill up again. That bounds the amortized number of relabeled
+/// entries per insertion by O(log n).
+///
+/// The density falls from 1 to 1/16 at the top level. Ranges of up to 2^15
+/// units allow the density of the initial numbering, 1/4, so relabeling stays
+/// local in blocks of thousands of instructions. A larger range that was
+/// numbered by runOnMachineFunction is spread out the first time it is
+/// relabeled.
+static unsigned getRangeCapacity(unsigned Level) {
+  static const auto Capacities = [] {
+    std::array<unsigned, MaxLevel + 1> C;
+    for (unsigned L = 0; L <= MaxLevel; ++L)
+      C[L] = std::max(1.0, std::floor(std::ldexp(1.0, L) *
+                                      std::pow(16.0, -double(L) / MaxLevel)));
+    return C;
+  }();
+  return Capacities[Level];
+}
+
+/// The most entries renumbered with half the default spacing before a range
+/// is relabeled instead.
+static const unsigned MaxRenumberRun = 1024;
+
 // Renumber indexes locally after curItr was inserted, but failed to get a new
 // index.
 void SlotIndexes::renumberIndexes(IndexList::iterator curItr) {
-  // Number indexes with half the default spacing so we can catch up quickly.
+  IndexList::iterator prevItr = std::prev(curItr);
+
+  // Number indexes with half the default spacing so we can catch up quickly,
+  // if the following indexes are caught up with in a short run. Repeated
+  // insertions at the same point make these runs ever longer.
   const unsigned Space = SlotIndex::InstrDist/2;
   static_assert((Space & 3) == 0, "InstrDist must be a multiple of 2*NUM");
-
-  IndexList::iterator startItr = std::prev(curItr);
-  unsigned index = startItr->getIndex();
+  uint64_t Index = prevItr->getIndex();
+  unsigned Run = 0;
+  IndexList::iterator I = curItr;
   do {
-    curItr->setIndex(index += Space);
-    ++curItr;
-    // If the next index is bigger, we have caught up.
-  } while (curItr != indexList.end() && curItr->getIndex() <= index);
+    Index += Space;
+    ++I;
+    ++Run;
+  } while (I != indexList.end() && I->getIndex() <= Index &&
+           Run < MaxRenumberRun);
+  if (Index < (uint64_t(1) << 32) &&
+      (I == indexList.end() || I->getIndex() > Index)) {
+    unsigned index = prevItr->getIndex();
+    NumRenumberedEntries += Run;
+    for (I = curItr; Run; --Run, ++I)
+      I->setIndex(index += Space);
+    LLVM_DEBUG(dbgs() << "\n*** Renumbered SlotIndexes "
+                      << prevItr->getIndex() << '-' << index << " ***\n");
+    ++NumLocalRenum;
+    return;
+  }
+
+  // Otherwise find the smallest aligned range of units around prevItr that is
+  // sparse enough, counting curItr in it. The entries in a range are contiguous
+  // in the list, so it grows by walking outwards from prevItr and curItr.
+  const unsigned Unit = SlotIndex::Slot_Count;
+  uint64_t Label = prevItr->getIndex() / Unit;
+  IndexList::iterator First = prevItr, Last = curItr;
+  unsigned Count = 2;
+  unsigned Level = 1;
+  uint64_t Begin, Size;
+  for (;; ++Level) {
+    Size = uint64_t(1) << Level;
+    Begin = Label & ~(Size - 1);
+    while (First != indexList.begin() &&
+           std::prev(First)->getIndex() / Unit >= Begin) {
+      --First;
+      ++Count;
+    }
+    while (std::next(Last) != indexList.end() &&
+           std::next(Last)->getIndex() / Unit < Begin + Size) {
+      ++Last;
+      ++Count;
+    }
+    if (Count <= getRangeCapacity(Level) || Level == MaxLevel)
+      break;
+  }
+  if (Count > Size)
+    report_fatal_error("Too many slot indexes in a function");
+
+  // Spread the entries evenly over the range.
+  uint64_t Step = Size / Count;
+  uint64_t NewLabel = Begin;
+  for (IndexList::iterator I = First, E = std::next(Last); I != E; ++I) {
+    I->setIndex(NewLabel * Unit);
+    NewLabel += Step;
+  }
 
-  LLVM_DEBUG(dbgs() << "\n*** Renumbered SlotIndexes " << startItr->getIndex()
-                    << '-' << index << " ***\n");
+  LLVM_DEBUG(dbgs() << "\n*** Renumbered SlotIndexes " << Begin * Unit << '-'
+                    << (Begin + Size) * Unit << " ***\n");
   ++NumLocalRenum;
+  NumRelabeled += Count;
+  NumRenumberedEntries += Count;
 }
 
 // Repair indexes after adding and removing instructions.
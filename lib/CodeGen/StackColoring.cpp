@@ -35,6 +35,7 @@
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineInstr.h"
 #include "llvm/CodeGen/MachineMemOperand.h"
+#include "llvm/CodeGen/MachineModuleInfo.h"
 #include "llvm/CodeGen/MachineOperand.h"
 #include "llvm/CodeGen/Passes.h"
 #include "llvm/CodeGen/SelectionDAGNodes.h"
@@ -59,6 +60,7 @@
 #include <cassert>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 using namespace llvm;
@@ -908,6 +910,10 @@ void StackColoring::remapInstructions(DenseMap<int, int> &SlotRemap) {
   SmallPtrSet<const AllocaInst*, 32> MergedAllocas;
 
   for (const std::pair<int, int> &SI : SlotRemap) {
+    // Constants and value handles are shared with the functions compiled on
+    // other threads.
+    std::lock_guard<std::mutex> Lock(MF->getMMI().getIRMutex());
+
     const AllocaInst *From = MFI->getObjectAllocation(SI.first);
     const AllocaInst *To = MFI->getObjectAllocation(SI.second);
     assert(To && From && "Invalid allocation object");
@@ -14,6 +14,7 @@
 
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
@@ -172,6 +173,15 @@ static cl::opt<CFLAAType> UseCFLAA(
                clEnumValN(CFLAAType::Both, "both",
                           "Enable both variants of CFL-AA")));
 
+// Run the machine passes on several functions at once. The functions are still
+// selected and emitted one after the other, in module order. Only used when
+// emitting object files for targets that support it, see
+// AllowParallelMachinePasses and supportsParallelMachinePasses.
+static cl::opt<unsigned> MachineFunctionThreads(
+    "machine-function-threads", cl::init(0), cl::Hidden,
+    cl::desc("Number of threads that run the machine passes of the "
+             "functions of a module in parallel"));
+
 /// Option names for limiting the codegen pipeline.
 /// Those are used in error reporting and we didn't want
 /// to duplicate their names all over the place.
@@ -280,6 +290,15 @@ char TargetPassConfig::ID = 0;
 
 namespace {
 
+/// Pass manager that only collects the passes added to it, see
+/// beginParallelMachinePasses.
+class PassRecorder : public PassManagerBase {
+public:
+  std::vector<Pass *> Passes;
+
+  void add(Pass *P) override { Passes.push_back(P); }
+};
+
 struct InsertedPass {
   AnalysisID TargetPassID;
   IdentifyingPassPtr InsertedPassID;
@@ -319,6 +338,15 @@ public:
   /// Store the pairs of <AnalysisID, AnalysisID> of which the second pass
   /// is inserted after each instance of the first one.
   SmallVector<InsertedPass, 4> InsertedPasses;
+
+  /// The pass manager that receives the passes between
+  /// beginParallelMachinePasses and endParallelMachinePasses, if they are not
+  /// added to the normal one. PM is swapped with it at both ends.
+  PassManagerBase *ParallelPM = nullptr;
+
+  /// Passes that may run on worker threads, collected by the main pass
+  /// configuration.
+  std::unique_ptr<PassRecorder> ParallelPasses;
 };
 
 } // end namespace llvm
@@ -572,9 +600,7 @@ void TargetPassConfig::addVerifyPass(const std::string &Banner) {
     PM->add(createMachineVerifierPass(Banner));
 }
 
-/// Add common target configurable passes that perform LLVM IR to IR transforms
-/// following machine independent optimization.
-void TargetPassConfig::addIRPasses() {
+void TargetPassConfig::addAliasAnalysisPasses() {
   switch (UseCFLAA) {
   case CFLAAType::Steensgaard:
     addPass(createCFLSteensAAWrapperPass());
@@ -597,6 +623,12 @@ void TargetPassConfig::addIRPasses() {
   addPass(createTypeBasedAAWrapperPass());
   addPass(createScopedNoAliasAAWrapperPass());
   addPass(createBasicAAWrapperPass());
+}
+
+/// Add common target configurable passes that perform LLVM IR to IR transforms
+/// following machine independent optimization.
+void TargetPassConfig::addIRPasses() {
+  addAliasAnalysisPasses();
 
   // Before running any passes, run the verifier to determine if the input
   // coming from the front-end and/or optimizer is valid.
@@ -833,6 +865,8 @@ void TargetPassConfig::addMachinePasses() {
     }
   }
 
+  beginParallelMachinePasses();
+
   // Print the instruction selected machine code...
   printAndVerify("After Instruction Selection");
 
@@ -931,6 +965,8 @@ void TargetPassConfig::addMachinePasses() {
   addPass(&XRayInstrumentationID, false);
   addPass(&PatchableFunctionID, false);
 
+  endParallelMachinePasses();
+
   if (TM->Options.EnableMachineOutliner && getOptLevel() != CodeGenOpt::None &&
       EnableMachineOutliner != NeverOutline) {
     bool RunOnAllFunctions = (EnableMachineOutliner == AlwaysOutline);
@@ -946,6 +982,69 @@ void TargetPassConfig::addMachinePasses() {
   AddingMachinePasses = false;
 }
 
+/// The passes that addMachinePasses adds for the instruction selected code,
+/// up to the module passes at its end, run on each function on its own. With
+/// -machine-function-threads they are collected instead of being added to the
+/// pass manager, and if they are all function passes, a pass that runs copies
+/// of them on worker threads replaces them.
+void TargetPassConfig::beginParallelMachinePasses() {
+  if (!Impl->ParallelPM) {
+    // Interprocedural register allocation needs the callees to be compiled
+    // before their callers.
+    if (MachineFunctionThreads < 2 || !AllowParallelMachinePasses ||
+        !supportsParallelMachinePasses() || hasLimitedCodeGenPipeline() ||
+        requiresCodeGenSCCOrder())
+      return;
+    Impl->ParallelPasses = llvm::make_unique<PassRecorder>();
+    Impl->ParallelPM = Impl->ParallelPasses.get();
+  }
+  std::swap(PM, Impl->ParallelPM);
+}
+
+void TargetPassConfig::endParallelMachinePasses() {
+  if (!Impl->ParallelPM)
+    return;
+  std::swap(PM, Impl->ParallelPM);
+  // Worker configurations keep their passes, see addParallelMachinePasses.
+  if (!Impl->ParallelPasses)
+    return;
+
+  std::vector<Pass *> Passes = std::move(Impl->ParallelPasses->Passes);
+  Impl->ParallelPM = nullptr;
+  Impl->ParallelPasses.reset();
+
+  // A target may have added a pass that works on the whole module.
+  if (!llvm::all_of(Passes, [](Pass *P) {
+        return P->getPassKind() == PT_Function;
+      })) {
+    for (Pass *P : Passes)
+      PM->add(P);
+    return;
+  }
+
+  for (Pass *P : Passes)
+    delete P;
+  PM->add(createParallelMachinePassesPass(MachineFunctionThreads));
+}
+
+void TargetPassConfig::addParallelMachinePasses() {
+  // Alias analysis is the only IR analysis that machine passes query, apart
+  // from the module level ones the workers share with the main pass manager.
+  addPass(createTargetTransformInfoWrapperPass(TM->getTargetIRAnalysis()));
+  addAliasAnalysisPasses();
+
+  // Only keep the passes added between beginParallelMachinePasses and
+  // endParallelMachinePasses.
+  PassRecorder Unused;
+  Impl->ParallelPM = PM;
+  PM = &Unused;
+  addMachinePasses();
+  PM = Impl->ParallelPM;
+  Impl->ParallelPM = nullptr;
+  for (Pass *P : Unused.Passes)
+    delete P;
+}
+
 /// Add passes that optimize machine instructions in SSA form.
 void TargetPassConfig::addMachineSSAOptimization() {
   // Pre-ra tail duplication.
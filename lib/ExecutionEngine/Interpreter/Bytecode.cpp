@@ -0,0 +1,1061 @@
+//===- Bytecode.cpp - Bytecode fast path for the interpreter --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the fast path of the interpreter. Functions that only
+// operate on scalar values (integers of up to 64 bits, floats, doubles and
+// pointers) are decoded, the first time they are called, into a register based
+// bytecode, which is then run with a direct-threaded dispatch loop on unboxed
+// 64-bit registers. Everything else falls back to the instruction walking
+// interpreter in Execution.cpp.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Bytecode.h"
+#include "Interpreter.h"
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/GetElementPtrTypeIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MathExtras.h"
+#include <cmath>
+#include <cstring>
+
+using namespace llvm;
+
+#define DEBUG_TYPE "interpreter"
+
+STATISTIC(NumBytecodeFunctions, "Number of functions compiled to bytecode");
+STATISTIC(NumBytecodeRejected, "Number of functions not compiled to bytecode");
+
+static cl::opt<bool> EnableFastPath(
+    "interpreter-fast-path", cl::Hidden, cl::init(true),
+    cl::desc("Run functions that only operate on scalar values as "
+             "pre-decoded bytecode"));
+
+static cl::opt<unsigned> MaxNativeDepth(
+    "interpreter-fast-path-max-depth", cl::Hidden, cl::init(1000),
+    cl::desc("Maximum number of bytecode calls nested on the native stack "
+             "before calls are interpreted instead"));
+
+// Use labels as values for the dispatch loop where the compiler supports them,
+// and a switch elsewhere.
+#if defined(__GNUC__)
+#define USE_THREADED_DISPATCH
+#endif
+
+#define BYTECODE_OPCODES(X)                                                    \
+  X(Add) X(Sub) X(Mul) X(UDiv) X(SDiv) X(URem) X(SRem)                         \
+  X(Shl) X(LShr) X(AShr) X(And) X(Or) X(Xor)                                   \
+  X(FAdd32) X(FSub32) X(FMul32) X(FDiv32) X(FRem32)                            \
+  X(FAdd64) X(FSub64) X(FMul64) X(FDiv64) X(FRem64)                            \
+  X(ICmpEQ) X(ICmpNE) X(ICmpUGT) X(ICmpUGE) X(ICmpULT) X(ICmpULE)              \
+  X(ICmpSGT) X(ICmpSGE) X(ICmpSLT) X(ICmpSLE) X(FCmp32) X(FCmp64)              \
+  X(Select) X(Copy) X(Mask) X(SExt) X(FPTrunc) X(FPExt)                        \
+  X(UIToF32) X(UIToF64) X(SIToF32) X(SIToF64) X(F32ToInt) X(F64ToInt)          \
+  X(Load8) X(Load16) X(Load32) X(Load64) X(LoadN)                              \
+  X(Store8) X(Store16) X(Store32) X(Store64) X(StoreN)                         \
+  X(Alloca) X(GEP) X(Br) X(CondBr) X(Switch) X(Ret) X(RetVoid) X(Call)         \
+  X(Unreachable)
+
+namespace {
+
+enum BytecodeOpcode : uint16_t {
+#define HANDLE_OPCODE(Name) Name,
+  BYTECODE_OPCODES(HANDLE_OPCODE)
+#undef HANDLE_OPCODE
+};
+
+} // end anonymous namespace
+
+//===----------------------------------------------------------------------===//
+//                     Value conversion helpers
+//===----------------------------------------------------------------------===//
+
+static bool isScalarType(Type *Ty) {
+  return (Ty->isIntegerTy() && Ty->getIntegerBitWidth() <= 64) ||
+         Ty->isFloatTy() || Ty->isDoubleTy() || Ty->isPointerTy();
+}
+
+static unsigned getScalarBitWidth(Type *Ty) {
+  if (Ty->isIntegerTy())
+    return Ty->getIntegerBitWidth();
+  if (Ty->isFloatTy())
+    return 32;
+  return 64;
+}
+
+static uint64_t fromGenericValue(const GenericValue &GV, Type *Ty) {
+  switch (Ty->getTypeID()) {
+  case Type::VoidTyID:
+    return 0;
+  case Type::IntegerTyID:
+    return GV.IntVal.getZExtValue();
+  case Type::FloatTyID:
+    return FloatToBits(GV.FloatVal);
+  case Type::DoubleTyID:
+    return DoubleToBits(GV.DoubleVal);
+  case Type::PointerTyID:
+    return reinterpret_cast<uintptr_t>(GV.PointerVal);
+  default:
+    llvm_unreachable("Type not supported by the bytecode fast path");
+  }
+}
+
+static GenericValue toGenericValue(uint64_t V, Type *Ty) {
+  GenericValue GV;
+  switch (Ty->getTypeID()) {
+  case Type::VoidTyID:
+    memset(&GV.Untyped, 0, sizeof(GV.Untyped));
+    break;
+  case Type::IntegerTyID:
+    GV.IntVal = APInt(Ty->getIntegerBitWidth(), V);
+    break;
+  case Type::FloatTyID:
+    GV.FloatVal = BitsToFloat(V);
+    break;
+  case Type::DoubleTyID:
+    GV.DoubleVal = BitsToDouble(V);
+    break;
+  case Type::PointerTyID:
+    GV.PointerVal = reinterpret_cast<void *>(static_cast<uintptr_t>(V));
+    break;
+  default:
+    llvm_unreachable("Type not supported by the bytecode fast path");
+  }
+  return GV;
+}
+
+// Returns true if the value of C can be computed when the function is decoded,
+// the same way getOperandValue would when the instruction is executed.
+static bool isSupportedConstant(const Constant *C) {
+  if (!isScalarType(C->getType()))
+    return false;
+  if (isa<ConstantInt>(C) || isa<ConstantFP>(C) ||
+      isa<ConstantPointerNull>(C) || isa<UndefValue>(C) ||
+      isa<GlobalValue>(C))
+    return true;
+
+  const auto *CE = dyn_cast<ConstantExpr>(C);
+  if (!CE)
+    return false;
+  switch (CE->getOpcode()) {
+  case Instruction::Trunc:  case Instruction::ZExt:   case Instruction::SExt:
+  case Instruction::FPTrunc: case Instruction::FPExt:
+  case Instruction::UIToFP: case Instruction::SIToFP:
+  case Instruction::FPToUI: case Instruction::FPToSI:
+  case Instruction::PtrToInt: case Instruction::IntToPtr:
+  case Instruction::BitCast: case Instruction::GetElementPtr:
+  case Instruction::ICmp:   case Instruction::FCmp:   case Instruction::Select:
+  case Instruction::Add:    case Instruction::Sub:    case Instruction::Mul:
+  case Instruction::FAdd:   case Instruction::FSub:   case Instruction::FMul:
+  case Instruction::FDiv:   case Instruction::FRem:
+  case Instruction::And:    case Instruction::Or:     case Instruction::Xor:
+  case Instruction::Shl:    case Instruction::LShr:   case Instruction::AShr:
+    break;
+  default:
+    // Division by a constant zero must only trap if it is executed.
+    return false;
+  }
+  return all_of(CE->operands(), [](const Use &U) {
+    return isSupportedConstant(cast<Constant>(U.get()));
+  });
+}
+
+//===----------------------------------------------------------------------===//
+//                     Decoding functions into bytecode
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+class BytecodeCompiler {
+public:
+  BytecodeCompiler(Function &F, const DataLayout &DL,
+                   function_ref<GenericValue(Constant *)> GetConstantValue)
+      : F(F), DL(DL), GetConstantValue(GetConstantValue),
+        BF(llvm::make_unique<BytecodeFunction>()) {}
+
+  std::unique_ptr<BytecodeFunction> compile();
+
+private:
+  bool compileInstruction(Instruction &I);
+  bool compileBinaryOperator(BinaryOperator &I);
+  bool compileCast(CastInst &I);
+  bool compileGEP(GetElementPtrInst &I);
+  bool compileCall(CallInst &I);
+  unsigned addEdge(BasicBlock *From, BasicBlock *To);
+
+  BytecodeInst &emit(BytecodeOpcode Opcode, unsigned Dst = 0, unsigned A = 0,
+                     unsigned B = 0, unsigned C = 0, uint64_t Imm = 0,
+                     unsigned Width = 0) {
+    BF->Code.push_back({nullptr, Opcode, static_cast<uint16_t>(Width), Dst, A,
+                        B, C, Imm});
+    return BF->Code.back();
+  }
+
+  unsigned getReg(Value *V);
+
+  Function &F;
+  const DataLayout &DL;
+  function_ref<GenericValue(Constant *)> GetConstantValue;
+  std::unique_ptr<BytecodeFunction> BF;
+  DenseMap<Value *, unsigned> Regs;
+  DenseMap<BasicBlock *, unsigned> BlockStarts;
+  std::vector<BasicBlock *> EdgeTargets;
+};
+
+} // end anonymous namespace
+
+unsigned BytecodeCompiler::getReg(Value *V) {
+  auto I = Regs.find(V);
+  if (I != Regs.end())
+    return I->second;
+
+  // Arguments and instructions were numbered up front, so this is a constant.
+  auto *C = cast<Constant>(V);
+  unsigned Reg = BF->InitialRegs.size();
+  BF->InitialRegs.push_back(
+      fromGenericValue(GetConstantValue(C), C->getType()));
+  Regs[V] = Reg;
+  return Reg;
+}
+
+unsigned BytecodeCompiler::addEdge(BasicBlock *From, BasicBlock *To) {
+  BytecodeFunction::Edge E;
+  E.Target = 0;
+  E.MovesBegin = BF->Moves.size();
+  for (PHINode &PN : To->phis())
+    BF->Moves.push_back(
+        {getReg(&PN), getReg(PN.getIncomingValueForBlock(From))});
+  E.MovesEnd = BF->Moves.size();
+  BF->NumScratchRegs = std::max(BF->NumScratchRegs, E.MovesEnd - E.MovesBegin);
+
+  BF->Edges.push_back(E);
+  EdgeTargets.push_back(To);
+  return BF->Edges.size() - 1;
+}
+
+std::unique_ptr<BytecodeFunction> BytecodeCompiler::compile() {
+  if (F.isVarArg() || !isScalarType(F.getReturnType()) &&
+                          !F.getReturnType()->isVoidTy())
+    return nullptr;
+
+  // Number the arguments and the instructions first: operands may refer to
+  // instructions further down the function.
+  for (Argument &A : F.args()) {
+    if (!isScalarType(A.getType()))
+      return nullptr;
+    Regs[&A] = BF->InitialRegs.size();
+    BF->InitialRegs.push_back(0);
+  }
+  BF->NumArgs = F.arg_size();
+
+  for (BasicBlock &BB : F)
+    for (Instruction &I : BB) {
+      if (I.getType()->isVoidTy())
+        continue;
+      if (!isScalarType(I.getType())) {
+        LLVM_DEBUG(dbgs() << "Not compiling " << F.getName()
+                          << " to bytecode: " << I << "\n");
+        return nullptr;
+      }
+      Regs[&I] = BF->InitialRegs.size();
+      BF->InitialRegs.push_back(0);
+    }
+
+  for (BasicBlock &BB : F) {
+    BlockStarts[&BB] = BF->Code.size();
+    for (Instruction &I : BB) {
+      if (isa<PHINode>(I))
+        continue;
+      if (!compileInstruction(I)) {
+        LLVM_DEBUG(dbgs() << "Not compiling " << F.getName()
+                          << " to bytecode: " << I << "\n");
+        return nullptr;
+      }
+    }
+  }
+
+  for (unsigned I = 0, E = BF->Edges.size(); I != E; ++I)
+    BF->Edges[I].Target = BlockStarts[EdgeTargets[I]];
+
+  return std::move(BF);
+}
+
+bool BytecodeCompiler::compileInstruction(Instruction &I) {
+  // Every operand has to be a scalar value in a register.
+  for (Value *Op : I.operands()) {
+    if (isa<BasicBlock>(Op) || isa<Function>(Op))
+      continue;
+    if (!isScalarType(Op->getType()))
+      return false;
+    if (auto *C = dyn_cast<Constant>(Op))
+      if (!isSupportedConstant(C))
+        return false;
+  }
+
+  unsigned Dst = I.getType()->isVoidTy() ? 0 : Regs[&I];
+
+  switch (I.getOpcode()) {
+  default:
+    return false;
+
+  case Instruction::Add: case Instruction::Sub: case Instruction::Mul:
+  case Instruction::UDiv: case Instruction::SDiv:
+  case Instruction::URem: case Instruction::SRem:
+  case Instruction::Shl: case Instruction::LShr: case Instruction::AShr:
+  case Instruction::And: case Instruction::Or: case Instruction::Xor:
+  case Instruction::FAdd: case Instruction::FSub: case Instruction::FMul:
+  case Instruction::FDiv: case Instruction::FRem:
+    return compileBinaryOperator(cast<BinaryOperator>(I));
+
+  case Instruction::ICmp: {
+    auto &Cmp = cast<ICmpInst>(I);
+    static const BytecodeOpcode Opcodes[] = {ICmpEQ,  ICmpNE,  ICmpUGT,
+                                             ICmpUGE, ICmpULT, ICmpULE,
+                                             ICmpSGT, ICmpSGE, ICmpSLT,
+                                             ICmpSLE};
+    unsigned Pred = Cmp.getPredicate() - CmpInst::FIRST_ICMP_PREDICATE;
+    emit(Opcodes[Pred], Dst, getReg(Cmp.getOperand(0)),
+         getReg(Cmp.getOperand(1)), 0, 0,
+         getScalarBitWidth(Cmp.getOperand(0)->getType()));
+    return true;
+  }
+
+  case Instruction::FCmp: {
+    auto &Cmp = cast<FCmpInst>(I);
+    emit(Cmp.getOperand(0)->getType()->isFloatTy() ? FCmp32 : FCmp64, Dst,
+         getReg(Cmp.getOperand(0)), getReg(Cmp.getOperand(1)), 0,
+         Cmp.getPredicate());
+    return true;
+  }
+
+  case Instruction::Select:
+    emit(Select, Dst, getReg(I.getOperand(0)), getReg(I.getOperand(1)),
+         getReg(I.getOperand(2)));
+    return true;
+
+  case Instruction::Trunc: case Instruction::ZExt: case Instruction::SExt:
+  case Instruction::FPTrunc: case Instruction::FPExt:
+  case Instruction::UIToFP: case Instruction::SIToFP:
+  case Instruction::FPToUI: case Instruction::FPToSI:
+  case Instruction::PtrToInt: case Instruction::IntToPtr:
+  case Instruction::BitCast:
+    return compileCast(cast<CastInst>(I));
+
+  case Instruction::Load: {
+    auto &LI = cast<LoadInst>(I);
+    if (!LI.isSimple())
+      return false;
+    uint64_t Size = DL.getTypeStoreSize(LI.getType());
+    uint64_t Mask = maskTrailingOnes<uint64_t>(getScalarBitWidth(LI.getType()));
+    if (LI.getType()->isPointerTy()) {
+      Size = sizeof(void *);
+      Mask = maskTrailingOnes<uint64_t>(Size * 8);
+    }
+    BytecodeOpcode Opcode = Size == 1 ? Load8 : Size == 2 ? Load16
+                          : Size == 4 ? Load32 : Size == 8 ? Load64 : LoadN;
+    emit(Opcode, Dst, getReg(LI.getPointerOperand()), 0, 0, Mask, Size);
+    return true;
+  }
+
+  case Instruction::Store: {
+    auto &SI = cast<StoreInst>(I);
+    if (!SI.isSimple())
+      return false;
+    Type *Ty = SI.getValueOperand()->getType();
+    uint64_t Size =
+        Ty->isPointerTy() ? sizeof(void *) : DL.getTypeStoreSize(Ty);
+    BytecodeOpcode Opcode = Size == 1 ? Store8 : Size == 2 ? Store16
+                          : Size == 4 ? Store32 : Size == 8 ? Store64 : StoreN;
+    emit(Opcode, 0, getReg(SI.getValueOperand()),
+         getReg(SI.getPointerOperand()), 0, 0, Size);
+    return true;
+  }
+
+  case Instruction::Alloca: {
+    auto &AI = cast<AllocaInst>(I);
+    emit(Alloca, Dst, getReg(AI.getArraySize()), 0, 0,
+         DL.getTypeAllocSize(AI.getAllocatedType()));
+    return true;
+  }
+
+  case Instruction::GetElementPtr:
+    return compileGEP(cast<GetElementPtrInst>(I));
+
+  case Instruction::Br: {
+    auto &BI = cast<BranchInst>(I);
+    if (BI.isUnconditional()) {
+      emit(Br, 0, 0, 0, 0, addEdge(BI.getParent(), BI.getSuccessor(0)));
+      return true;
+    }
+    emit(CondBr, 0, getReg(BI.getCondition()),
+         addEdge(BI.getParent(), BI.getSuccessor(0)),
+         addEdge(BI.getParent(), BI.getSuccessor(1)));
+    return true;
+  }
+
+  case Instruction::Switch: {
+    auto &SI = cast<SwitchInst>(I);
+    unsigned FirstCase = BF->SwitchCases.size();
+    for (auto &Case : SI.cases())
+      BF->SwitchCases.push_back(
+          {Case.getCaseValue()->getZExtValue(),
+           addEdge(SI.getParent(), Case.getCaseSuccessor())});
+    emit(Switch, 0, getReg(SI.getCondition()), FirstCase,
+         SI.getNumCases(), addEdge(SI.getParent(), SI.getDefaultDest()));
+    return true;
+  }
+
+  case Instruction::Ret: {
+    auto &RI = cast<ReturnInst>(I);
+    if (Value *V = RI.getReturnValue())
+      emit(Ret, 0, getReg(V));
+    else
+      emit(RetVoid);
+    return true;
+  }
+
+  case Instruction::Unreachable:
+    emit(Unreachable);
+    return true;
+
+  case Instruction::Call:
+    return compileCall(cast<CallInst>(I));
+  }
+}
+
+bool BytecodeCompiler::compileBinaryOperator(BinaryOperator &I) {
+  unsigned Dst = Regs[&I];
+  unsigned A = getReg(I.getOperand(0)), B = getReg(I.getOperand(1));
+  Type *Ty = I.getType();
+
+  if (Ty->isFloatTy() || Ty->isDoubleTy()) {
+    bool IsFloat = Ty->isFloatTy();
+    BytecodeOpcode Opcode;
+    switch (I.getOpcode()) {
+    case Instruction::FAdd: Opcode = IsFloat ? FAdd32 : FAdd64; break;
+    case Instruction::FSub: Opcode = IsFloat ? FSub32 : FSub64; break;
+    case Instruction::FMul: Opcode = IsFloat ? FMul32 : FMul64; break;
+    case Instruction::FDiv: Opcode = IsFloat ? FDiv32 : FDiv64; break;
+    case Instruction::FRem: Opcode = IsFloat ? FRem32 : FRem64; break;
+    default:
+      return false;
+    }
+    emit(Opcode, Dst, A, B);
+    return true;
+  }
+
+  if (!Ty->isIntegerTy())
+    return false;
+
+  unsigned Width = Ty->getIntegerBitWidth();
+  uint64_t Mask = maskTrailingOnes<uint64_t>(Width);
+  BytecodeOpcode Opcode;
+  switch (I.getOpcode()) {
+  case Instruction::Add:  Opcode = Add;  break;
+  case Instruction::Sub:  Opcode = Sub;  break;
+  case Instruction::Mul:  Opcode = Mul;  break;
+  case Instruction::UDiv: Opcode = UDiv; break;
+  case Instruction::SDiv: Opcode = SDiv; break;
+  case Instruction::URem: Opcode = URem; break;
+  case Instruction::SRem: Opcode = SRem; break;
+  case Instruction::And:  Opcode = And;  break;
+  case Instruction::Or:   Opcode = Or;   break;
+  case Instruction::Xor:  Opcode = Xor;  break;
+  case Instruction::Shl:
+  case Instruction::LShr:
+  case Instruction::AShr:
+    // Out of range shift amounts are masked as in Execution.cpp.
+    Opcode = I.getOpcode() == Instruction::Shl
+                 ? Shl
+                 : I.getOpcode() == Instruction::LShr ? LShr : AShr;
+    emit(Opcode, Dst, A, B, NextPowerOf2(Width - 1) - 1, Mask, Width);
+    return true;
+  default:
+    return false;
+  }
+  emit(Opcode, Dst, A, B, 0, Mask, Width);
+  return true;
+}
+
+bool BytecodeCompiler::compileCast(CastInst &I) {
+  unsigned Dst = Regs[&I];
+  unsigned A = getReg(I.getOperand(0));
+  Type *SrcTy = I.getSrcTy(), *DstTy = I.getDestTy();
+  unsigned SrcWidth = getScalarBitWidth(SrcTy);
+  unsigned DstWidth = getScalarBitWidth(DstTy);
+
+  switch (I.getOpcode()) {
+  case Instruction::Trunc:
+  case Instruction::PtrToInt:
+    emit(Mask, Dst, A, 0, 0, maskTrailingOnes<uint64_t>(DstWidth));
+    return true;
+  case Instruction::IntToPtr:
+    emit(Mask, Dst, A, 0, 0,
+         maskTrailingOnes<uint64_t>(DL.getPointerSizeInBits()));
+    return true;
+  case Instruction::ZExt:
+  case Instruction::BitCast:
+    emit(Copy, Dst, A);
+    return true;
+  case Instruction::SExt:
+    emit(SExt, Dst, A, 0, 0, maskTrailingOnes<uint64_t>(DstWidth), SrcWidth);
+    return true;
+  case Instruction::FPTrunc:
+    emit(FPTrunc, Dst, A);
+    return true;
+  case Instruction::FPExt:
+    emit(FPExt, Dst, A);
+    return true;
+  case Instruction::UIToFP:
+    emit(DstTy->isFloatTy() ? UIToF32 : UIToF64, Dst, A, 0, 0, 0, SrcWidth);
+    return true;
+  case Instruction::SIToFP:
+    emit(DstTy->isFloatTy() ? SIToF32 : SIToF64, Dst, A, 0, 0, 0, SrcWidth);
+    return true;
+  case Instruction::FPToUI:
+  case Instruction::FPToSI:
+    emit(SrcTy->isFloatTy() ? F32ToInt : F64ToInt, Dst, A, 0, 0, 0, DstWidth);
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool BytecodeCompiler::compileGEP(GetElementPtrInst &I) {
+  uint64_t Offset = 0;
+  unsigned FirstIndex = BF->GEPIndices.size();
+
+  for (gep_type_iterator GTI = gep_type_begin(I), E = gep_type_end(I);
+       GTI != E; ++GTI) {
+    Value *Idx = GTI.getOperand();
+    if (StructType *STy = GTI.getStructTypeOrNull()) {
+      unsigned Field = cast<ConstantInt>(Idx)->getZExtValue();
+      Offset += DL.getStructLayout(STy)->getElementOffset(Field);
+      continue;
+    }
+
+    int64_t Scale = DL.getTypeAllocSize(GTI.getIndexedType());
+    if (auto *CI = dyn_cast<ConstantInt>(Idx))
+      Offset += static_cast<uint64_t>(CI->getSExtValue() * Scale);
+    else
+      BF->GEPIndices.push_back(
+          {getReg(Idx), Idx->getType()->getIntegerBitWidth(), Scale});
+  }
+
+  emit(GEP, Regs[&I], getReg(I.getPointerOperand()), FirstIndex,
+       BF->GEPIndices.size() - FirstIndex, Offset);
+  return true;
+}
+
+bool BytecodeCompiler::compileCall(CallInst &I) {
+  if (I.isInlineAsm())
+    return false;
+
+  Function *Callee = I.getCalledFunction();
+  if (Callee && Callee->isIntrinsic()) {
+    // These are dropped by IntrinsicLowering as well. Anything else would
+    // have to be lowered, which changes the function.
+    if (isa<DbgInfoIntrinsic>(I) ||
+        Callee->getIntrinsicID() == Intrinsic::lifetime_start ||
+        Callee->getIntrinsicID() == Intrinsic::lifetime_end)
+      return true;
+    return false;
+  }
+
+  BytecodeFunction::CallSiteInfo CI;
+  CI.Callee = Callee;
+  CI.CalleeReg = Callee ? 0 : getReg(I.getCalledValue());
+  CI.FTy = I.getFunctionType();
+  for (Value *Arg : I.arg_operands()) {
+    CI.Args.push_back(getReg(Arg));
+    CI.ArgTypes.push_back(Arg->getType());
+  }
+  BF->Calls.push_back(std::move(CI));
+
+  // Void calls have no destination; Op_Call does not write one for them.
+  emit(Call, I.getType()->isVoidTy() ? 0 : Regs[&I], 0, 0, 0,
+       BF->Calls.size() - 1);
+  return true;
+}
+
+std::unique_ptr<BytecodeFunction> Interpreter::compileBytecode(Function &F) {
+  // Host and target must agree on byte order for loads and stores to be
+  // plain copies.
+  if (!sys::IsLittleEndianHost || !getDataLayout().isLittleEndian())
+    return nullptr;
+
+  // Constants do not depend on the stack frame.
+  ExecutionContext SF;
+  return BytecodeCompiler(F, getDataLayout(), [&](Constant *C) {
+           return getOperandValue(C, SF);
+         }).compile();
+}
+
+BytecodeFunction *Interpreter::getBytecode(Function *F) {
+  if (!EnableFastPath || F->isDeclaration())
+    return nullptr;
+
+  auto I = Bytecode.find(F);
+  if (I == Bytecode.end()) {
+    auto BF = compileBytecode(*F);
+    if (BF)
+      ++NumBytecodeFunctions;
+    else
+      ++NumBytecodeRejected;
+    I = Bytecode.insert(std::make_pair(F, std::move(BF))).first;
+  }
+  return I->second.get();
+}
+
+//===----------------------------------------------------------------------===//
+//                     Running bytecode
+//===----------------------------------------------------------------------===//
+
+GenericValue Interpreter::runBytecode(BytecodeFunction &BF, Function *F,
+                                      ArrayRef<GenericValue> ArgVals) {
+  SmallVector<uint64_t, 8> Args;
+  unsigned i = 0;
+  for (Argument &A : F->args())
+    Args.push_back(fromGenericValue(ArgVals[i++], A.getType()));
+  ++BytecodeDepth;
+  uint64_t Result = executeBytecode(BF, Args.data());
+  --BytecodeDepth;
+  return toGenericValue(Result, F->getReturnType());
+}
+
+bool Interpreter::canRunBytecode() const {
+  return BytecodeDepth < MaxNativeDepth;
+}
+
+GenericValue Interpreter::callFromBytecode(Function *F,
+                                           ArrayRef<GenericValue> ArgVals) {
+  // Run the callee on a stack of its own: when it returns, the frames below
+  // it must not mistake its result for the result of one of their own calls.
+  std::vector<ExecutionContext> CallerStack;
+  std::swap(CallerStack, ECStack);
+  callFunction(F, ArgVals);
+  run();
+  std::swap(CallerStack, ECStack);
+  return ExitValue;
+}
+
+static bool evaluateFCmp(unsigned Pred, double A, double B) {
+  bool Unordered = std::isnan(A) || std::isnan(B);
+  switch (Pred) {
+  case FCmpInst::FCMP_FALSE: return false;
+  case FCmpInst::FCMP_OEQ:   return !Unordered && A == B;
+  case FCmpInst::FCMP_OGT:   return !Unordered && A > B;
+  case FCmpInst::FCMP_OGE:   return !Unordered && A >= B;
+  case FCmpInst::FCMP_OLT:   return !Unordered && A < B;
+  case FCmpInst::FCMP_OLE:   return !Unordered && A <= B;
+  case FCmpInst::FCMP_ONE:   return !Unordered && A != B;
+  case FCmpInst::FCMP_ORD:   return !Unordered;
+  case FCmpInst::FCMP_UNO:   return Unordered;
+  case FCmpInst::FCMP_UEQ:   return Unordered || A == B;
+  case FCmpInst::FCMP_UGT:   return Unordered || A > B;
+  case FCmpInst::FCMP_UGE:   return Unordered || A >= B;
+  case FCmpInst::FCMP_ULT:   return Unordered || A < B;
+  case FCmpInst::FCMP_ULE:   return Unordered || A <= B;
+  case FCmpInst::FCMP_UNE:   return Unordered || A != B;
+  case FCmpInst::FCMP_TRUE:  return true;
+  default:
+    llvm_unreachable("Invalid FCmp predicate");
+  }
+}
+
+// Performs the PHI moves of an edge and returns the first instruction of its
+// destination.
+static const BytecodeInst *takeEdge(const BytecodeFunction &BF, uint64_t Edge,
+                                    uint64_t *R) {
+  const BytecodeFunction::Edge &E = BF.Edges[Edge];
+  if (E.MovesBegin != E.MovesEnd) {
+    uint64_t *Scratch = R + BF.InitialRegs.size();
+    for (unsigned I = E.MovesBegin; I != E.MovesEnd; ++I)
+      Scratch[I - E.MovesBegin] = R[BF.Moves[I].Src];
+    for (unsigned I = E.MovesBegin; I != E.MovesEnd; ++I)
+      R[BF.Moves[I].Dst] = Scratch[I - E.MovesBegin];
+  }
+  return &BF.Code[E.Target];
+}
+
+static float asFloat(uint64_t V) { return BitsToFloat(V); }
+static double asDouble(uint64_t V) { return BitsToDouble(V); }
+static int64_t asSigned(uint64_t V, unsigned Width) {
+  return SignExtend64(V, Width);
+}
+
+uint64_t Interpreter::executeBytecode(BytecodeFunction &BF,
+                                      const uint64_t *Args) {
+#ifdef USE_THREADED_DISPATCH
+  // Replace opcodes with the addresses of their handlers the first time the
+  // function runs.
+  static const void *const Handlers[] = {
+#define HANDLE_OPCODE(Name) &&Op_##Name,
+      BYTECODE_OPCODES(HANDLE_OPCODE)
+#undef HANDLE_OPCODE
+  };
+  if (!BF.IsThreaded) {
+    for (BytecodeInst &I : BF.Code)
+      I.Handler = Handlers[I.Opcode];
+    BF.IsThreaded = true;
+  }
+#define DISPATCH() goto *PC->Handler
+#else
+#define DISPATCH() goto Dispatch
+#endif
+#define NEXT()                                                                 \
+  do {                                                                         \
+    ++PC;                                                                      \
+    DISPATCH();                                                                \
+  } while (false)
+#define TAKE_EDGE(Edge)                                                        \
+  do {                                                                         \
+    PC = takeEdge(BF, Edge, R);                                                \
+    DISPATCH();                                                                \
+  } while (false)
+
+  SmallVector<uint64_t, 64> Regs(BF.InitialRegs.begin(),
+                                 BF.InitialRegs.end());
+  Regs.resize(BF.InitialRegs.size() + BF.NumScratchRegs);
+  uint64_t *R = Regs.data();
+  std::copy(Args, Args + BF.NumArgs, R);
+
+  AllocaHolder Allocas;
+  const BytecodeInst *PC = BF.Code.data();
+
+#ifdef USE_THREADED_DISPATCH
+  DISPATCH();
+#else
+Dispatch:
+  switch (PC->Opcode) {
+#define HANDLE_OPCODE(Name)                                                    \
+  case Name:                                                                   \
+    goto Op_##Name;
+    BYTECODE_OPCODES(HANDLE_OPCODE)
+#undef HANDLE_OPCODE
+  }
+  llvm_unreachable("Invalid bytecode opcode");
+#endif
+
+  // Integer arithmetic. Results are truncated to the width of the type.
+Op_Add:
+  R[PC->Dst] = (R[PC->A] + R[PC->B]) & PC->Imm;
+  NEXT();
+Op_Sub:
+  R[PC->Dst] = (R[PC->A] - R[PC->B]) & PC->Imm;
+  NEXT();
+Op_Mul:
+  R[PC->Dst] = (R[PC->A] * R[PC->B]) & PC->Imm;
+  NEXT();
+Op_UDiv:
+  R[PC->Dst] = R[PC->A] / R[PC->B];
+  NEXT();
+Op_SDiv: {
+  int64_t A = asSigned(R[PC->A], PC->Width), B = asSigned(R[PC->B], PC->Width);
+  // Dividing the smallest value by -1 wraps around, as for APInt.
+  uint64_t Q = B == -1 ? 0 - static_cast<uint64_t>(A)
+                       : static_cast<uint64_t>(A / B);
+  R[PC->Dst] = Q & PC->Imm;
+  NEXT();
+}
+Op_URem:
+  R[PC->Dst] = R[PC->A] % R[PC->B];
+  NEXT();
+Op_SRem: {
+  int64_t A = asSigned(R[PC->A], PC->Width), B = asSigned(R[PC->B], PC->Width);
+  R[PC->Dst] = (B == -1 ? 0 : static_cast<uint64_t>(A % B)) & PC->Imm;
+  NEXT();
+}
+Op_Shl: {
+  uint64_t Amt = R[PC->B] < PC->Width ? R[PC->B] : R[PC->B] & PC->C;
+  R[PC->Dst] = Amt >= 64 ? 0 : (R[PC->A] << Amt) & PC->Imm;
+  NEXT();
+}
+Op_LShr: {
+  uint64_t Amt = R[PC->B] < PC->Width ? R[PC->B] : R[PC->B] & PC->C;
+  R[PC->Dst] = Amt >= 64 ? 0 : R[PC->A] >> Amt;
+  NEXT();
+}
+Op_AShr: {
+  uint64_t Amt = R[PC->B] < PC->Width ? R[PC->B] : R[PC->B] & PC->C;
+  int64_t A = asSigned(R[PC->A], PC->Width);
+  R[PC->Dst] = static_cast<uint64_t>(A >> std::min<uint64_t>(Amt, 63)) &
+               PC->Imm;
+  NEXT();
+}
+Op_And:
+  R[PC->Dst] = R[PC->A] & R[PC->B];
+  NEXT();
+Op_Or:
+  R[PC->Dst] = R[PC->A] | R[PC->B];
+  NEXT();
+Op_Xor:
+  R[PC->Dst] = R[PC->A] ^ R[PC->B];
+  NEXT();
+
+  // Floating point arithmetic.
+Op_FAdd32:
+  R[PC->Dst] = FloatToBits(asFloat(R[PC->A]) + asFloat(R[PC->B]));
+  NEXT();
+Op_FSub32:
+  R[PC->Dst] = FloatToBits(asFloat(R[PC->A]) - asFloat(R[PC->B]));
+  NEXT();
+Op_FMul32:
+  R[PC->Dst] = FloatToBits(asFloat(R[PC->A]) * asFloat(R[PC->B]));
+  NEXT();
+Op_FDiv32:
+  R[PC->Dst] = FloatToBits(asFloat(R[PC->A]) / asFloat(R[PC->B]));
+  NEXT();
+Op_FRem32:
+  R[PC->Dst] = FloatToBits(fmod(asFloat(R[PC->A]), asFloat(R[PC->B])));
+  NEXT();
+Op_FAdd64:
+  R[PC->Dst] = DoubleToBits(asDouble(R[PC->A]) + asDouble(R[PC->B]));
+  NEXT();
+Op_FSub64:
+  R[PC->Dst] = DoubleToBits(asDouble(R[PC->A]) - asDouble(R[PC->B]));
+  NEXT();
+Op_FMul64:
+  R[PC->Dst] = DoubleToBits(asDouble(R[PC->A]) * asDouble(R[PC->B]));
+  NEXT();
+Op_FDiv64:
+  R[PC->Dst] = DoubleToBits(asDouble(R[PC->A]) / asDouble(R[PC->B]));
+  NEXT();
+Op_FRem64:
+  R[PC->Dst] = DoubleToBits(fmod(asDouble(R[PC->A]), asDouble(R[PC->B])));
+  NEXT();
+
+  // Comparisons.
+Op_ICmpEQ:
+  R[PC->Dst] = R[PC->A] == R[PC->B];
+  NEXT();
+Op_ICmpNE:
+  R[PC->Dst] = R[PC->A] != R[PC->B];
+  NEXT();
+Op_ICmpUGT:
+  R[PC->Dst] = R[PC->A] > R[PC->B];
+  NEXT();
+Op_ICmpUGE:
+  R[PC->Dst] = R[PC->A] >= R[PC->B];
+  NEXT();
+Op_ICmpULT:
+  R[PC->Dst] = R[PC->A] < R[PC->B];
+  NEXT();
+Op_ICmpULE:
+  R[PC->Dst] = R[PC->A] <= R[PC->B];
+  NEXT();
+Op_ICmpSGT:
+  R[PC->Dst] = asSigned(R[PC->A], PC->Width) > asSigned(R[PC->B], PC->Width);
+  NEXT();
+Op_ICmpSGE:
+  R[PC->Dst] = asSigned(R[PC->A], PC->Width) >= asSigned(R[PC->B], PC->Width);
+  NEXT();
+Op_ICmpSLT:
+  R[PC->Dst] = asSigned(R[PC->A], PC->Width) < asSigned(R[PC->B], PC->Width);
+  NEXT();
+Op_ICmpSLE:
+  R[PC->Dst] = asSigned(R[PC->A], PC->Width) <= asSigned(R[PC->B], PC->Width);
+  NEXT();
+Op_FCmp32:
+  R[PC->Dst] = evaluateFCmp(PC->Imm, asFloat(R[PC->A]), asFloat(R[PC->B]));
+  NEXT();
+Op_FCmp64:
+  R[PC->Dst] = evaluateFCmp(PC->Imm, asDouble(R[PC->A]), asDouble(R[PC->B]));
+  NEXT();
+
+Op_Select:
+  R[PC->Dst] = R[PC->A] ? R[PC->B] : R[PC->C];
+  NEXT();
+
+  // Casts.
+Op_Copy:
+  R[PC->Dst] = R[PC->A];
+  NEXT();
+Op_Mask:
+  R[PC->Dst] = R[PC->A] & PC->Imm;
+  NEXT();
+Op_SExt:
+  R[PC->Dst] = static_cast<uint64_t>(asSigned(R[PC->A], PC->Width)) & PC->Imm;
+  NEXT();
+Op_FPTrunc:
+  R[PC->Dst] = FloatToBits(static_cast<float>(asDouble(R[PC->A])));
+  NEXT();
+Op_FPExt:
+  R[PC->Dst] = DoubleToBits(static_cast<double>(asFloat(R[PC->A])));
+  NEXT();
+  // Integers are rounded to double first, as APIntOps::RoundAPIntToFloat does.
+Op_UIToF32:
+  R[PC->Dst] = FloatToBits(static_cast<float>(static_cast<double>(R[PC->A])));
+  NEXT();
+Op_UIToF64:
+  R[PC->Dst] = DoubleToBits(static_cast<double>(R[PC->A]));
+  NEXT();
+Op_SIToF32:
+  R[PC->Dst] = FloatToBits(
+      static_cast<float>(static_cast<double>(asSigned(R[PC->A], PC->Width))));
+  NEXT();
+Op_SIToF64:
+  R[PC->Dst] =
+      DoubleToBits(static_cast<double>(asSigned(R[PC->A], PC->Width)));
+  NEXT();
+Op_F32ToInt:
+  R[PC->Dst] = APIntOps::RoundFloatToAPInt(asFloat(R[PC->A]), PC->Width)
+                   .getZExtValue();
+  NEXT();
+Op_F64ToInt:
+  R[PC->Dst] = APIntOps::RoundDoubleToAPInt(asDouble(R[PC->A]), PC->Width)
+                   .getZExtValue();
+  NEXT();
+
+  // Memory.
+Op_Load8: {
+  uint8_t V;
+  memcpy(&V, reinterpret_cast<void *>(R[PC->A]), sizeof(V));
+  R[PC->Dst] = V & PC->Imm;
+  NEXT();
+}
+Op_Load16: {
+  uint16_t V;
+  memcpy(&V, reinterpret_cast<void *>(R[PC->A]), sizeof(V));
+  R[PC->Dst] = V & PC->Imm;
+  NEXT();
+}
+Op_Load32: {
+  uint32_t V;
+  memcpy(&V, reinterpret_cast<void *>(R[PC->A]), sizeof(V));
+  R[PC->Dst] = V & PC->Imm;
+  NEXT();
+}
+Op_Load64: {
+  uint64_t V;
+  memcpy(&V, reinterpret_cast<void *>(R[PC->A]), sizeof(V));
+  R[PC->Dst] = V & PC->Imm;
+  NEXT();
+}
+Op_LoadN: {
+  uint64_t V = 0;
+  memcpy(&V, reinterpret_cast<void *>(R[PC->A]), PC->Width);
+  R[PC->Dst] = V & PC->Imm;
+  NEXT();
+}
+Op_Store8: {
+  uint8_t V = R[PC->A];
+  memcpy(reinterpret_cast<void *>(R[PC->B]), &V, sizeof(V));
+  NEXT();
+}
+Op_Store16: {
+  uint16_t V = R[PC->A];
+  memcpy(reinterpret_cast<void *>(R[PC->B]), &V, sizeof(V));
+  NEXT();
+}
+Op_Store32: {
+  uint32_t V = R[PC->A];
+  memcpy(reinterpret_cast<void *>(R[PC->B]), &V, sizeof(V));
+  NEXT();
+}
+Op_Store64:
+  memcpy(reinterpret_cast<void *>(R[PC->B]), &R[PC->A], sizeof(uint64_t));
+  NEXT();
+Op_StoreN:
+  memcpy(reinterpret_cast<void *>(R[PC->B]), &R[PC->A], PC->Width);
+  NEXT();
+Op_Alloca: {
+  // Sized and freed as in Interpreter::visitAllocaInst.
+  unsigned NumElements = R[PC->A];
+  unsigned MemToAlloc = std::max(1U, NumElements * unsigned(PC->Imm));
+  void *Memory = safe_malloc(MemToAlloc);
+  Allocas.add(Memory);
+  R[PC->Dst] = reinterpret_cast<uintptr_t>(Memory);
+  NEXT();
+}
+Op_GEP: {
+  uint64_t Offset = PC->Imm;
+  for (unsigned I = PC->B, E = PC->B + PC->C; I != E; ++I) {
+    const BytecodeFunction::GEPIndex &Idx = BF.GEPIndices[I];
+    Offset += static_cast<uint64_t>(asSigned(R[Idx.Reg], Idx.Width)) *
+              static_cast<uint64_t>(Idx.Scale);
+  }
+  R[PC->Dst] = R[PC->A] + Offset;
+  NEXT();
+}
+
+  // Control flow.
+Op_Br:
+  TAKE_EDGE(PC->Imm);
+Op_CondBr:
+  TAKE_EDGE(R[PC->A] ? PC->B : PC->C);
+Op_Switch: {
+  uint64_t V = R[PC->A];
+  for (unsigned I = PC->B, E = PC->B + PC->C; I != E; ++I)
+    if (BF.SwitchCases[I].Value == V)
+      TAKE_EDGE(BF.SwitchCases[I].Edge);
+  TAKE_EDGE(PC->Imm);
+}
+Op_Ret:
+  return R[PC->A];
+Op_RetVoid:
+  return 0;
+Op_Unreachable:
+  report_fatal_error("Program executed an 'unreachable' instruction!");
+Op_Call: {
+  BytecodeFunction::CallSiteInfo &CI = BF.Calls[PC->Imm];
+  Function *Callee = CI.Callee;
+  BytecodeFunction *CalleeBF;
+  if (Callee) {
+    if (!CI.CalleeLookedUp) {
+      CI.CalleeBytecode = Callee->getFunctionType() == CI.FTy
+                              ? getBytecode(Callee)
+                              : nullptr;
+      CI.CalleeLookedUp = true;
+    }
+    CalleeBF = CI.CalleeBytecode;
+  } else {
+    // Pointers to functions are the Function objects themselves (see
+    // getPointerToFunction).
+    Callee = reinterpret_cast<Function *>(R[CI.CalleeReg]);
+    CalleeBF =
+        Callee->getFunctionType() == CI.FTy ? getBytecode(Callee) : nullptr;
+  }
+
+  // Register 0 is a live value (the first argument or constant), so void
+  // calls must not write their result.
+  Type *RetTy = CI.FTy->getReturnType();
+  if (CalleeBF && canRunBytecode()) {
+    SmallVector<uint64_t, 8> CallArgs;
+    for (unsigned Reg : CI.Args)
+      CallArgs.push_back(R[Reg]);
+    ++BytecodeDepth;
+    uint64_t Result = executeBytecode(*CalleeBF, CallArgs.data());
+    --BytecodeDepth;
+    if (!RetTy->isVoidTy())
+      R[PC->Dst] = Result;
+  } else {
+    // Deep recursion continues in the interpreter, whose frames live on the
+    // heap; callFunction does not enter bytecode while the limit is reached.
+    SmallVector<GenericValue, 8> CallArgs;
+    for (unsigned I = 0, E = CI.Args.size(); I != E; ++I)
+      CallArgs.push_back(toGenericValue(R[CI.Args[I]], CI.ArgTypes[I]));
+    GenericValue Result = callFromBytecode(Callee, CallArgs);
+    if (!RetTy->isVoidTy())
+      R[PC->Dst] = fromGenericValue(Result, RetTy);
+  }
+  NEXT();
+}
+
+#undef TAKE_EDGE
+#undef NEXT
+#undef DISPATCH
+}
@@ -0,0 +1,101 @@
+//===-- Bytecode.h - Pre-decoded form of interpreted functions --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header defines the register-based bytecode that the interpreter uses
+// as a fast path for functions that only operate on scalar values.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIB_EXECUTIONENGINE_INTERPRETER_BYTECODE_H
+#define LLVM_LIB_EXECUTIONENGINE_INTERPRETER_BYTECODE_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace llvm {
+
+class Function;
+class FunctionType;
+class Type;
+
+// BytecodeInst - One decoded instruction. Every value of the function lives
+// in a 64-bit register: integers zero-extended from their bit width, floats
+// and doubles as their bit patterns, and pointers as addresses. Operands are
+// register numbers; Imm and Width hold whatever the opcode needs (a mask, a
+// size, an index into one of the side tables of the function, ...).
+//
+struct BytecodeInst {
+  const void *Handler;  // Address of the opcode's handler, when threaded
+  uint16_t Opcode;
+  uint16_t Width;
+  unsigned Dst, A, B, C;
+  uint64_t Imm;
+};
+
+// BytecodeFunction - The bytecode for one function, produced by
+// Interpreter::compileBytecode.
+//
+struct BytecodeFunction {
+  // A control flow edge: the moves that implement the PHI nodes of the
+  // destination block, followed by a jump to its first instruction.
+  struct Edge {
+    unsigned Target;
+    unsigned MovesBegin, MovesEnd;
+  };
+
+  struct Move {
+    unsigned Dst, Src;
+  };
+
+  // A variable GEP index, sign-extended from Width bits and scaled.
+  struct GEPIndex {
+    unsigned Reg;
+    unsigned Width;
+    int64_t Scale;
+  };
+
+  struct SwitchCase {
+    uint64_t Value;
+    unsigned Edge;
+  };
+
+  struct CallSiteInfo {
+    Function *Callee;    // Null for indirect calls
+    unsigned CalleeReg;  // Register holding the callee of indirect calls
+    FunctionType *FTy;
+    SmallVector<unsigned, 4> Args;
+    SmallVector<Type *, 4> ArgTypes;  // Needed to box arguments of varargs calls
+    // The callee's bytecode, once it has been looked up. Only used for direct
+    // calls.
+    BytecodeFunction *CalleeBytecode = nullptr;
+    bool CalleeLookedUp = false;
+  };
+
+  std::vector<BytecodeInst> Code;
+  std::vector<Edge> Edges;
+  std::vector<Move> Moves;
+  std::vector<GEPIndex> GEPIndices;
+  std::vector<SwitchCase> SwitchCases;
+  std::vector<CallSiteInfo> Calls;
+
+  // Initial register file: the values of the constants used by the function
+  // (registers that hold arguments or instruction results are zero).
+  std::vector<uint64_t> InitialRegs;
+  unsigned NumArgs = 0;
+  // Registers used to make the PHI moves of an edge behave as if they were
+  // done in parallel. They follow the registers in InitialRegs.
+  unsigned NumScratchRegs = 0;
+
+  bool IsThreaded = false;
+};
+
+} // End llvm namespace
+
+#endif
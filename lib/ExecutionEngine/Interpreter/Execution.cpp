@@ -2089,6 +2089,15 @@ void Interpreter::callFunction(Function *F, ArrayRef<GenericValue> ArgVals) {
     return;
   }
 
+  // Functions that only operate on scalar values run to completion on the
+  // bytecode fast path, unless too many of them are already nested on the
+  // native stack.
+  if (BytecodeFunction *BF = canRunBytecode() ? getBytecode(F) : nullptr) {
+    GenericValue Result = runBytecode(*BF, F, ArgVals);
+    popStackAndReturnValueToCaller(F->getReturnType(), Result);
+    return;
+  }
+
   // Get pointers to first LLVM BB & Instruction in function.
   StackFrame.CurBB     = &F->front();
   StackFrame.CurInst   = StackFrame.CurBB->begin();
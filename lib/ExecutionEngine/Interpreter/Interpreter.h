@@ -14,6 +14,7 @@
 #ifndef LLVM_LIB_EXECUTIONENGINE_INTERPRETER_INTERPRETER_H
 #define LLVM_LIB_EXECUTIONENGINE_INTERPRETER_INTERPRETER_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/ExecutionEngine/GenericValue.h"
 #include "llvm/IR/CallSite.h"
@@ -26,6 +27,7 @@
 namespace llvm {
 
 class IntrinsicLowering;
+struct BytecodeFunction;
 template<typename T> class generic_gep_type_iterator;
 class ConstantExpr;
 typedef generic_gep_type_iterator<User::const_op_iterator> gep_type_iterator;
@@ -85,6 +87,14 @@ class Interpreter : public ExecutionEngine, public InstVisitor<Interpreter> {
   // registered with the atexit() library function.
   std::vector<Function*> AtExitHandlers;
 
+  // Bytecode - The pre-decoded form of the functions that can run on the
+  // bytecode fast path, or null for functions that can not.
+  DenseMap<Function *, std::unique_ptr<BytecodeFunction>> Bytecode;
+
+  // BytecodeDepth - The number of bytecode functions currently running on the
+  // native stack.
+  unsigned BytecodeDepth = 0;
+
 public:
   explicit Interpreter(std::unique_ptr<Module> M);
   ~Interpreter() override;
@@ -228,6 +238,15 @@ private:  // Helper functions
                                     Type *Ty, ExecutionContext &SF);
   void popStackAndReturnValueToCaller(Type *RetTy, GenericValue Result);
 
+  // Bytecode fast path, implemented in Bytecode.cpp.
+  BytecodeFunction *getBytecode(Function *F);
+  std::unique_ptr<BytecodeFunction> compileBytecode(Function &F);
+  GenericValue runBytecode(BytecodeFunction &BF, Function *F,
+                           ArrayRef<GenericValue> ArgVals);
+  uint64_t executeBytecode(BytecodeFunction &BF, const uint64_t *Args);
+  GenericValue callFromBytecode(Function *F, ArrayRef<GenericValue> ArgVals);
+  bool canRunBytecode() const;
+
 };
 
 } // End llvm namespace
@@ -8,8 +8,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/IR/CallSite.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "orc"
 
 using namespace llvm;
 using namespace llvm::orc;
@@ -73,7 +79,7 @@ public:
         Parent(Parent) {}
 
   PartitioningIRMaterializationUnit(
-      ThreadSafeModule TSM, SymbolFlagsMap SymbolFlags,
+      ThreadSafeModule TSM, VModuleKey K, SymbolFlagsMap SymbolFlags,
       SymbolNameToDefinitionMap SymbolToDefinition,
       CompileOnDemandLayer &Parent)
       : IRMaterializationUnit(std::move(TSM), std::move(K),
@@ -112,12 +118,37 @@ CompileOnDemandLayer::CompileOnDemandLayer(
     ExecutionSession &ES, IRLayer &BaseLayer, LazyCallThroughManager &LCTMgr,
     IndirectStubsManagerBuilder BuildIndirectStubsManager)
     : IRLayer(ES), BaseLayer(BaseLayer), LCTMgr(LCTMgr),
-      BuildIndirectStubsManager(std::move(BuildIndirectStubsManager)) {}
+      BuildIndirectStubsManager(std::move(BuildIndirectStubsManager)) {
+  ES.registerResourceManager(*this);
+}
+
+CompileOnDemandLayer::~CompileOnDemandLayer() {
+  getExecutionSession().deregisterResourceManager(*this);
+}
 
 void CompileOnDemandLayer::setPartitionFunction(PartitionFunction Partition) {
   this->Partition = std::move(Partition);
 }
 
+void CompileOnDemandLayer::setSpeculationLimit(
+    unsigned MaxSpeculativeFunctions) {
+  std::lock_guard<std::mutex> Lock(CODLayerMutex);
+  SpeculationLimit = MaxSpeculativeFunctions;
+}
+
+Error CompileOnDemandLayer::redirect(JITDylib &ImplD,
+                                     const SymbolStringPtr &Name,
+                                     JITTargetAddress NewAddr) {
+  // Called from compile threads while emit may be adding dylibs to the map.
+  std::lock_guard<std::mutex> Lock(CODLayerMutex);
+  for (auto &KV : DylibResources)
+    if (&KV.second.getImplDylib() == &ImplD)
+      return KV.second.getISManager().updatePointer(*Name, NewAddr);
+
+  return make_error<StringError>("No stubs for " + ImplD.getName(),
+                                 inconvertibleErrorCode());
+}
+
 void CompileOnDemandLayer::emit(MaterializationResponsibility R,
                                 ThreadSafeModule TSM) {
   assert(TSM.getModule() && "Null module");
@@ -157,13 +188,46 @@ void CompileOnDemandLayer::emit(MaterializationResponsibility R,
     return;
   }
 
-  R.replace(reexports(PDR.getImplDylib(), std::move(NonCallables), true));
+  auto K = R.getVModuleKey();
+  if (K != VModuleKey() && !Callables.empty()) {
+    SymbolNameSet StubNames;
+    for (auto &KV : Callables)
+      StubNames.insert(KV.first);
+    std::lock_guard<std::mutex> Lock(CODLayerMutex);
+    ModuleStubs[K].push_back(
+        std::make_pair(&PDR.getISManager(), std::move(StubNames)));
+  }
+
+  R.replace(reexports(PDR.getImplDylib(), std::move(NonCallables), true, K));
   R.replace(lazyReexports(LCTMgr, PDR.getISManager(), PDR.getImplDylib(),
-                          std::move(Callables)));
+                          std::move(Callables), K));
+}
+
+Error CompileOnDemandLayer::removeResources(VModuleKey K) {
+  std::vector<std::pair<IndirectStubsManager *, SymbolNameSet>> Stubs;
+  {
+    std::lock_guard<std::mutex> Lock(CODLayerMutex);
+    auto I = ModuleStubs.find(K);
+    if (I == ModuleStubs.end())
+      return Error::success();
+    Stubs = std::move(I->second);
+    ModuleStubs.erase(I);
+  }
+
+  // Stubs are only created for functions that were looked up, so some of
+  // the names may never have been given one.
+  for (auto &KV : Stubs)
+    for (auto &Name : KV.second)
+      if (KV.first->findStub(*Name, false))
+        if (auto Err = KV.first->removeStub(*Name))
+          return Err;
+
+  return Error::success();
 }
 
 CompileOnDemandLayer::PerDylibResources &
 CompileOnDemandLayer::getPerDylibResources(JITDylib &TargetD) {
+  std::lock_guard<std::mutex> Lock(CODLayerMutex);
   auto I = DylibResources.find(&TargetD);
   if (I == DylibResources.end()) {
     auto &ImplD = getExecutionSession().createJITDylib(
@@ -230,6 +294,90 @@ void CompileOnDemandLayer::expandPartition(GlobalValueSet &Partition) {
     Partition.insert(GV);
 }
 
+std::vector<std::string> CompileOnDemandLayer::findSpeculationCandidates(
+    const GlobalValueSet &Partition) {
+  // Collect the direct callees of the partition that still have a body in the
+  // source module, i.e. that have not been extracted and compiled yet.
+  std::vector<const Function *> Candidates;
+  DenseSet<const Function *> Seen;
+  for (auto *GV : Partition) {
+    auto *F = dyn_cast<Function>(GV);
+    if (!F || F->isDeclaration())
+      continue;
+
+    for (auto &I : instructions(F)) {
+      ImmutableCallSite CS(&I);
+      if (!CS)
+        continue;
+      auto *Callee = CS.getCalledFunction();
+      if (!Callee || Callee->isDeclaration() || Partition.count(Callee))
+        continue;
+
+      // A recorded entry count of zero means the callee never ran.
+      auto EntryCount = Callee->getEntryCount();
+      if (EntryCount.hasValue() && EntryCount.getCount() == 0)
+        continue;
+
+      if (Seen.insert(Callee).second)
+        Candidates.push_back(Callee);
+    }
+  }
+
+  // Prefer the callees that ran most often, then those without profile data
+  // in call site order.
+  std::stable_sort(Candidates.begin(), Candidates.end(),
+                   [](const Function *LHS, const Function *RHS) {
+                     auto LHSCount = LHS->getEntryCount();
+                     auto RHSCount = RHS->getEntryCount();
+                     if (!RHSCount.hasValue())
+                       return LHSCount.hasValue();
+                     return LHSCount.hasValue() &&
+                            LHSCount.getCount() > RHSCount.getCount();
+                   });
+
+  // Return names rather than functions: the source module is handed back to
+  // the impl dylib, and may be modified by another thread, before the
+  // candidates are looked up.
+  std::vector<std::string> CandidateNames;
+  for (auto *F : Candidates)
+    CandidateNames.push_back(F->getName());
+  return CandidateNames;
+}
+
+void CompileOnDemandLayer::speculate(JITDylib &ImplD, const DataLayout &DL,
+                                     std::vector<std::string> Candidates) {
+  {
+    std::lock_guard<std::mutex> Lock(CODLayerMutex);
+    unsigned Budget = SpeculationLimit > SpeculationsInFlight
+                          ? SpeculationLimit - SpeculationsInFlight
+                          : 0;
+    if (Candidates.size() > Budget)
+      Candidates.resize(Budget);
+    SpeculationsInFlight += Candidates.size();
+  }
+
+  if (Candidates.empty())
+    return;
+
+  auto &ES = getExecutionSession();
+  MangleAndInterner Mangle(ES, DL);
+  SymbolNameSet Names;
+  for (auto &Name : Candidates) {
+    LLVM_DEBUG(dbgs() << "Speculatively compiling " << Name << "\n");
+    Names.insert(Mangle(Name));
+  }
+
+  unsigned NumSpeculated = Candidates.size();
+  ES.speculate({{&ImplD, true}}, std::move(Names),
+               [this, NumSpeculated](Error Err) {
+                 // Failed speculation is harmless: the function will be
+                 // looked up again, and the error reported, on first call.
+                 consumeError(std::move(Err));
+                 std::lock_guard<std::mutex> Lock(CODLayerMutex);
+                 SpeculationsInFlight -= NumSpeculated;
+               });
+}
+
 void CompileOnDemandLayer::emitPartition(
     MaterializationResponsibility R, ThreadSafeModule TSM,
     IRMaterializationUnit::SymbolNameToDefinitionMap Defs) {
@@ -261,7 +409,8 @@ void CompileOnDemandLayer::emitPartition(
   // If the partition is empty, return the whole module to the symbol table.
   if (GVsToExtract->empty()) {
     R.replace(llvm::make_unique<PartitioningIRMaterializationUnit>(
-        std::move(TSM), R.getSymbols(), std::move(Defs), *this));
+        std::move(TSM), R.getVModuleKey(), R.getSymbols(), std::move(Defs),
+        *this));
     return;
   }
 
@@ -286,6 +435,17 @@ void CompileOnDemandLayer::emitPartition(
 
   expandPartition(*GVsToExtract);
 
+  // Find the callees to speculate on while the source module still has their
+  // bodies.
+  std::vector<std::string> SpeculationCandidates;
+  bool Speculate;
+  {
+    std::lock_guard<std::mutex> Lock(CODLayerMutex);
+    Speculate = SpeculationLimit > SpeculationsInFlight;
+  }
+  if (Speculate)
+    SpeculationCandidates = findSpeculationCandidates(*GVsToExtract);
+
   // Extract the requested partiton (plus any necessary aliases) and
   // put the rest back into the impl dylib.
   auto ShouldExtract = [&](const GlobalValue &GV) -> bool {
@@ -293,10 +453,17 @@ void CompileOnDemandLayer::emitPartition(
   };
 
   auto ExtractedTSM = extractSubModule(TSM, ".submodule", ShouldExtract);
+
+  JITDylib &ImplD = R.getTargetJITDylib();
+  DataLayout DL = TSM.getModule()->getDataLayout();
+
   R.replace(llvm::make_unique<PartitioningIRMaterializationUnit>(
       ES, std::move(TSM), R.getVModuleKey(), *this));
 
   BaseLayer.emit(std::move(R), std::move(ExtractedTSM));
+
+  if (!SpeculationCandidates.empty())
+    speculate(ImplD, DL, std::move(SpeculationCandidates));
 }
 
 } // end namespace orc
@@ -145,6 +145,10 @@ RegisterDependenciesFunction NoDependenciesToRegister =
 
 void MaterializationUnit::anchor() {}
 
+ResourceManager::~ResourceManager() {}
+
+void ResourceManager::anchor() {}
+
 raw_ostream &operator<<(raw_ostream &OS, const SymbolStringPtr &Sym) {
   return OS << *Sym;
 }
@@ -437,7 +441,7 @@ Error MaterializationResponsibility::defineMaterializing(
 #endif
   }
 
-  return JD.defineMaterializing(NewSymbolFlags);
+  return JD.defineMaterializing(NewSymbolFlags, K);
 }
 
 void MaterializationResponsibility::failMaterialization() {
@@ -729,7 +733,8 @@ SymbolNameSet ReexportsGenerator::operator()(JITDylib &JD,
   return Added;
 }
 
-Error JITDylib::defineMaterializing(const SymbolFlagsMap &SymbolFlags) {
+Error JITDylib::defineMaterializing(const SymbolFlagsMap &SymbolFlags,
+                                   VModuleKey K) {
   return ES.runSessionLocked([&]() -> Error {
     std::vector<SymbolMap::iterator> AddedSyms;
 
@@ -755,6 +760,12 @@ Error JITDylib::defineMaterializing(const SymbolFlagsMap &SymbolFlags) {
       }
     }
 
+    // Later insertions may have invalidated the iterators in AddedSyms.
+    for (auto &KV : SymbolFlags) {
+      setSymbolKey(KV.first, K);
+      ReadySymbols.update(KV.first, Symbols[KV.first]);
+    }
+
     return Error::success();
   });
 }
@@ -777,6 +788,13 @@ void JITDylib::replace(std::unique_ptr<MaterializationUnit> MU) {
         }
 #endif // NDEBUG
 
+        // Replacement units created without a key of their own (e.g. the
+        // remainder of a partially materialized unit) stay with the module
+        // that originally defined the symbols.
+        if (MU->getVModuleKey() != VModuleKey())
+          for (auto &KV : MU->getSymbols())
+            setSymbolKey(KV.first, MU->getVModuleKey());
+
         // If any symbol has pending queries against it then we need to
         // materialize MU immediately.
         for (auto &KV : MU->getSymbols()) {
@@ -810,6 +828,42 @@ void JITDylib::replace(std::unique_ptr<MaterializationUnit> MU) {
     ES.dispatchMaterialization(*this, std::move(MustRunMU));
 }
 
+void JITDylib::setSymbolKey(const SymbolStringPtr &Name, VModuleKey K) {
+  auto Result = SymbolKeys.insert(std::make_pair(Name, K));
+  if (!Result.second) {
+    if (Result.first->second == K)
+      return;
+    eraseFromModuleSymbols(Name, Result.first->second);
+    Result.first->second = K;
+  }
+  ModuleSymbols[K].insert(Name);
+}
+
+void JITDylib::eraseSymbolKey(const SymbolStringPtr &Name) {
+  auto I = SymbolKeys.find(Name);
+  if (I == SymbolKeys.end())
+    return;
+  eraseFromModuleSymbols(Name, I->second);
+  SymbolKeys.erase(I);
+}
+
+void JITDylib::eraseFromModuleSymbols(const SymbolStringPtr &Name,
+                                      VModuleKey K) {
+  auto I = ModuleSymbols.find(K);
+  assert(I != ModuleSymbols.end() && I->second.count(Name) &&
+         "Symbol missing from its module's symbol set");
+  I->second.erase(Name);
+  if (I->second.empty())
+    ModuleSymbols.erase(I);
+}
+
+SymbolNameSet JITDylib::getSymbolsForModule(VModuleKey K) const {
+  auto I = ModuleSymbols.find(K);
+  if (I == ModuleSymbols.end())
+    return SymbolNameSet();
+  return I->second;
+}
+
 SymbolNameSet
 JITDylib::getRequestedSymbols(const SymbolFlagsMap &SymbolFlags) const {
   return ES.runSessionLocked([&]() {
@@ -976,6 +1030,7 @@ void JITDylib::emit(const SymbolFlagsMap &Emitted) {
             auto &DependantSym = DependantJD.Symbols[DependantName];
             DependantSym.setFlags(DependantSym.getFlags() &
                                   ~JITSymbolFlags::Materializing);
+            DependantJD.ReadySymbols.update(DependantName, DependantSym);
             DependantJD.MaterializingInfos.erase(DependantMII);
           }
         }
@@ -994,6 +1049,7 @@ void JITDylib::emit(const SymbolFlagsMap &Emitted) {
                "Symbol has no entry in the Symbols table");
         auto &Sym = Symbols[Name];
         Sym.setFlags(Sym.getFlags() & ~JITSymbolFlags::Materializing);
+        ReadySymbols.update(Name, Sym);
         MaterializingInfos.erase(MII);
       }
     }
@@ -1018,6 +1074,8 @@ void JITDylib::notifyFailed(const SymbolNameSet &FailedSymbols) {
       auto I = Symbols.find(Name);
       assert(I != Symbols.end() && "Symbol not present in this JITDylib");
       Symbols.erase(I);
+      eraseSymbolKey(Name);
+      ReadySymbols.erase(Name);
 
       auto MII = MaterializingInfos.find(Name);
 
@@ -1136,6 +1194,8 @@ Error JITDylib::remove(const SymbolNameSet &Names) {
       }
 
       auto SymI = SymbolMaterializerItrPair.first;
+      eraseSymbolKey(SymI->first);
+      ReadySymbols.erase(SymI->first);
       Symbols.erase(SymI);
     }
 
@@ -1251,6 +1311,11 @@ void JITDylib::lodgeQueryImpl(
       // ready. Notify the query and continue.
       Q->notifySymbolReady();
       continue;
+    } else if (ES.NotifyQueryBlocked && !Q->isSpeculative()) {
+      // Another lookup already started materializing this symbol, so this
+      // query now waits on a unit that may still be queued. Speculative
+      // queries have nobody waiting on them and are not reported.
+      Q->BlockedOn[this].insert(Name);
     }
 
     // Add the query to the PendingQueries list.
@@ -1444,6 +1509,47 @@ void JITDylib::dump(raw_ostream &OS) {
   });
 }
 
+void JITDylib::ReadySymbolTable::update(const SymbolStringPtr &Name,
+                                        JITEvaluatedSymbol Sym) {
+  auto &S = getStripe(Name);
+  sys::ScopedWriter Lock(S.Mutex);
+  S.Symbols[Name] = Sym;
+}
+
+void JITDylib::ReadySymbolTable::erase(const SymbolStringPtr &Name) {
+  auto &S = getStripe(Name);
+  sys::ScopedWriter Lock(S.Mutex);
+  S.Symbols.erase(Name);
+}
+
+bool JITDylib::ReadySymbolTable::find(const SymbolStringPtr &Name,
+                                      JITEvaluatedSymbol &Sym) const {
+  auto &S = getStripe(Name);
+  sys::ScopedReader Lock(S.Mutex);
+  auto I = S.Symbols.find(Name);
+  if (I == S.Symbols.end())
+    return false;
+  Sym = I->second;
+  return true;
+}
+
+bool JITDylib::lookupReady(const SymbolStringPtr &Name, bool MatchNonExported,
+                           JITEvaluatedSymbol &Sym, bool &Found) const {
+  Found = false;
+
+  // If the symbol is not defined here the search can move on to the next
+  // JITDylib, unless the generator could define it.
+  if (!ReadySymbols.find(Name, Sym))
+    return !DefGenerator;
+
+  // Lazy and materializing symbols need the full (locked) lookup.
+  if (Sym.getFlags().isLazy() || Sym.getFlags().isMaterializing())
+    return false;
+
+  Found = MatchNonExported || Sym.getFlags().isExported();
+  return Found || !DefGenerator;
+}
+
 JITDylib::JITDylib(ExecutionSession &ES, std::string Name)
     : ES(ES), JITDylibName(std::move(Name)) {
   SearchOrder.push_back({this, true});
@@ -1504,6 +1610,13 @@ Error JITDylib::defineImpl(MaterializationUnit &MU) {
     return make_error<DuplicateDefinition>(**Duplicates.begin());
   }
 
+  // Record the module that provides each new (or overriding) definition.
+  for (auto &KV : MU.getSymbols())
+    if (!MUDefsOverridden.count(KV.first)) {
+      setSymbolKey(KV.first, MU.getVModuleKey());
+      ReadySymbols.update(KV.first, Symbols[KV.first]);
+    }
+
   // Update flags on existing defs and call discard on their materializers.
   for (auto &EDO : ExistingDefsOverridden) {
     assert(EDO.ExistingDefItr->second.getFlags().isLazy() &&
@@ -1593,6 +1706,63 @@ JITDylib &ExecutionSession::createJITDylib(std::string Name,
   });
 }
 
+void ExecutionSession::registerResourceManager(ResourceManager &RM) {
+  runSessionLocked([&]() { ResourceManagers.push_back(&RM); });
+}
+
+void ExecutionSession::deregisterResourceManager(ResourceManager &RM) {
+  runSessionLocked([&]() {
+    auto I = std::find(ResourceManagers.begin(), ResourceManagers.end(), &RM);
+    assert(I != ResourceManagers.end() && "ResourceManager not registered");
+    ResourceManagers.erase(I);
+  });
+}
+
+Error ExecutionSession::removeModule(VModuleKey K) {
+  assert(K != VModuleKey() && "Can not remove the default module key");
+
+  using ResourceManagerList = std::vector<ResourceManager *>;
+  auto RMs = runSessionLocked([&]() -> Expected<ResourceManagerList> {
+    // Check every dylib before touching any of them, so that a failed removal
+    // leaves the session unmodified.
+    std::vector<std::pair<JITDylib *, SymbolNameSet>> SymbolsToRemove;
+    SymbolNameSet Materializing;
+    for (auto &JD : JDs) {
+      auto Names = JD->getSymbolsForModule(K);
+      if (Names.empty())
+        continue;
+      for (auto &Name : Names) {
+        auto I = JD->Symbols.find(Name);
+        assert(I != JD->Symbols.end() && "Module symbol missing from dylib");
+        if (I->second.getFlags().isMaterializing())
+          Materializing.insert(Name);
+      }
+      SymbolsToRemove.push_back(std::make_pair(JD.get(), std::move(Names)));
+    }
+
+    if (!Materializing.empty())
+      return make_error<SymbolsCouldNotBeRemoved>(std::move(Materializing));
+
+    for (auto &KV : SymbolsToRemove)
+      cantFail(KV.first->remove(KV.second));
+
+    return ResourceManagers;
+  });
+
+  if (!RMs)
+    return RMs.takeError();
+
+  LLVM_DEBUG(dbgs() << "Removing resources for module " << K << "\n");
+
+  // Release resources outside the session lock: resource managers may need
+  // to take their own locks, which are also held while calling into the
+  // session.
+  Error Err = Error::success();
+  for (auto *RM : *RMs)
+    Err = joinErrors(std::move(Err), RM->removeResources(K));
+  return Err;
+}
+
 void ExecutionSession::legacyFailQuery(AsynchronousSymbolQuery &Q, Error Err) {
   assert(!!Err && "Error should be in failure state");
 
@@ -1739,10 +1909,76 @@ Expected<SymbolMap> ExecutionSession::legacyLookup(
 #endif
 }
 
+bool ExecutionSession::lookupReady(const JITDylibSearchList &SearchOrder,
+                                   const SymbolNameSet &Symbols,
+                                   SymbolMap &Result) {
+  for (auto &Name : Symbols) {
+    bool Found = false;
+    for (auto &KV : SearchOrder) {
+      assert(KV.first && "JITDylibList entries must not be null");
+      JITEvaluatedSymbol Sym;
+      if (!KV.first->lookupReady(Name, KV.second, Sym, Found))
+        return false;
+      if (Found) {
+        Result[Name] = Sym;
+        break;
+      }
+    }
+    if (!Found)
+      return false;
+  }
+  return true;
+}
+
 void ExecutionSession::lookup(
     const JITDylibSearchList &SearchOrder, SymbolNameSet Symbols,
     SymbolsResolvedCallback OnResolve, SymbolsReadyCallback OnReady,
     RegisterDependenciesFunction RegisterDependencies) {
+  lodgeLookup(SearchOrder, std::move(Symbols), std::move(OnResolve),
+              std::move(OnReady), std::move(RegisterDependencies), false);
+}
+
+void ExecutionSession::speculate(const JITDylibSearchList &SearchOrder,
+                                 SymbolNameSet Symbols,
+                                 SymbolsReadyCallback OnDone) {
+  if (!DispatchSpeculativeMaterialization) {
+    LLVM_DEBUG(dbgs() << "No speculative dispatcher, not speculating on "
+                      << Symbols << "\n");
+    OnDone(Error::success());
+    return;
+  }
+
+  // Resolution failures are reported through OnResolve only, in which case
+  // OnReady is never called.
+  auto SharedOnDone = std::make_shared<SymbolsReadyCallback>(std::move(OnDone));
+  auto OnResolve = [SharedOnDone](Expected<SymbolMap> Result) {
+    if (!Result)
+      (*SharedOnDone)(Result.takeError());
+  };
+  auto OnReady = [SharedOnDone](Error Err) {
+    (*SharedOnDone)(std::move(Err));
+  };
+
+  lodgeLookup(SearchOrder, std::move(Symbols), std::move(OnResolve),
+              std::move(OnReady), NoDependenciesToRegister, true);
+}
+
+void ExecutionSession::lodgeLookup(
+    const JITDylibSearchList &SearchOrder, SymbolNameSet Symbols,
+    SymbolsResolvedCallback OnResolve, SymbolsReadyCallback OnReady,
+    RegisterDependenciesFunction RegisterDependencies, bool Speculative) {
+
+  // If every symbol is already ready then the query can be answered without
+  // taking the session lock. Ready symbols are never registered as
+  // dependencies, so there is nothing to pass to RegisterDependencies.
+  {
+    SymbolMap Result;
+    if (lookupReady(SearchOrder, Symbols, Result)) {
+      OnResolve(std::move(Result));
+      OnReady(Error::success());
+      return;
+    }
+  }
 
   // lookup can be re-entered recursively if running on a single thread. Run any
   // outstanding MUs in case this query depends on them, otherwise this lookup
@@ -1753,9 +1989,11 @@ void ExecutionSession::lookup(
   std::map<JITDylib *, MaterializationUnitList> CollectedMUsMap;
   auto Q = std::make_shared<AsynchronousSymbolQuery>(
       Unresolved, std::move(OnResolve), std::move(OnReady));
+  Q->Speculative = Speculative;
   bool QueryIsFullyResolved = false;
   bool QueryIsFullyReady = false;
   bool QueryFailed = false;
+  SymbolDependenceMap BlockedOn;
 
   runSessionLocked([&]() {
     for (auto &KV : SearchOrder) {
@@ -1780,6 +2018,8 @@ void ExecutionSession::lookup(
       // Call the register dependencies function.
       if (RegisterDependencies && !Q->QueryRegistrations.empty())
         RegisterDependencies(Q->QueryRegistrations);
+
+      BlockedOn = std::move(Q->BlockedOn);
     } else {
       // Query failed due to unresolved symbols.
       QueryFailed = true;
@@ -1804,6 +2044,25 @@ void ExecutionSession::lookup(
       Q->handleFullyReady();
   }
 
+  if (!BlockedOn.empty())
+    NotifyQueryBlocked(BlockedOn);
+
+  // Speculative MUs go straight to the speculative dispatcher: nothing is
+  // waiting on them, so they need not be run before returning.
+  if (Speculative) {
+    assert(DispatchSpeculativeMaterialization &&
+           "Speculative lookup without a speculative dispatcher");
+    for (auto &KV : CollectedMUsMap)
+      for (auto &MU : KV.second) {
+        LLVM_DEBUG(runSessionLocked([&]() {
+                     dbgs() << "Speculatively compiling, for "
+                            << KV.first->getName() << ", " << *MU << "\n";
+                   }););
+        DispatchSpeculativeMaterialization(*KV.first, std::move(MU));
+      }
+    return;
+  }
+
   // Move the MUs to the OutstandingMUs list, then materialize.
   {
     std::lock_guard<std::recursive_mutex> Lock(OutstandingMUsMutex);
@@ -1819,6 +2078,12 @@ void ExecutionSession::lookup(
 Expected<SymbolMap> ExecutionSession::lookup(
     const JITDylibSearchList &SearchOrder, const SymbolNameSet &Symbols,
     RegisterDependenciesFunction RegisterDependencies, bool WaitUntilReady) {
+  {
+    SymbolMap Result;
+    if (lookupReady(SearchOrder, Symbols, Result))
+      return std::move(Result);
+  }
+
 #if LLVM_ENABLE_THREADS
   // In the threaded case we use promises to return the results.
   std::promise<SymbolMap> PromisedResult;
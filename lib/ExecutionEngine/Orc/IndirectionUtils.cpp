@@ -55,6 +55,12 @@ private:
 namespace llvm {
 namespace orc {
 
+Error IndirectStubsManager::removeStub(StringRef Name) {
+  return make_error<StringError>("Stub removal is not supported by this "
+                                 "IndirectStubsManager",
+                                 inconvertibleErrorCode());
+}
+
 void IndirectStubsManager::anchor() {}
 void TrampolinePool::anchor() {}
 
@@ -17,8 +17,9 @@ namespace {
   // A SimpleCompiler that owns its TargetMachine.
   class TMOwningSimpleCompiler : public llvm::orc::SimpleCompiler {
   public:
-    TMOwningSimpleCompiler(std::unique_ptr<llvm::TargetMachine> TM)
-      : llvm::orc::SimpleCompiler(*TM), TM(std::move(TM)) {}
+    TMOwningSimpleCompiler(std::unique_ptr<llvm::TargetMachine> TM,
+                           llvm::ObjectCache *ObjCache = nullptr)
+      : llvm::orc::SimpleCompiler(*TM, ObjCache), TM(std::move(TM)) {}
   private:
     // FIXME: shared because std::functions (and thus
     // IRCompileLayer::CompileFunction) are not moveable.
@@ -37,7 +38,7 @@ LLJIT::~LLJIT() {
 
 Expected<std::unique_ptr<LLJIT>>
 LLJIT::Create(JITTargetMachineBuilder JTMB, DataLayout DL,
-              unsigned NumCompileThreads) {
+              unsigned NumCompileThreads, ObjectCache *ObjCache) {
 
   if (NumCompileThreads == 0) {
     // If NumCompileThreads == 0 then create a single-threaded LLJIT instance.
@@ -45,12 +46,13 @@ LLJIT::Create(JITTargetMachineBuilder JTMB, DataLayout DL,
     if (!TM)
       return TM.takeError();
     return std::unique_ptr<LLJIT>(new LLJIT(llvm::make_unique<ExecutionSession>(),
-                                            std::move(*TM), std::move(DL)));
+                                            std::move(*TM), std::move(DL),
+                                            ObjCache));
   }
 
   return std::unique_ptr<LLJIT>(new LLJIT(llvm::make_unique<ExecutionSession>(),
                                           std::move(JTMB), std::move(DL),
-                                          NumCompileThreads));
+                                          NumCompileThreads, ObjCache));
 }
 
 Error LLJIT::defineAbsolute(StringRef Name, JITEvaluatedSymbol Sym) {
@@ -59,19 +61,20 @@ Error LLJIT::defineAbsolute(StringRef Name, JITEvaluatedSymbol Sym) {
   return Main.define(absoluteSymbols(std::move(Symbols)));
 }
 
-Error LLJIT::addIRModule(JITDylib &JD, ThreadSafeModule TSM) {
+Error LLJIT::addIRModule(JITDylib &JD, ThreadSafeModule TSM, VModuleKey K) {
   assert(TSM && "Can not add null module");
 
   if (auto Err = applyDataLayout(*TSM.getModule()))
     return Err;
 
-  return CompileLayer.add(JD, std::move(TSM), ES->allocateVModule());
+  return CompileLayer.add(JD, std::move(TSM), K);
 }
 
-Error LLJIT::addObjectFile(JITDylib &JD, std::unique_ptr<MemoryBuffer> Obj) {
+Error LLJIT::addObjectFile(JITDylib &JD, std::unique_ptr<MemoryBuffer> Obj,
+                           VModuleKey K) {
   assert(Obj && "Can not add null object");
 
-  return ObjLinkingLayer.add(JD, std::move(Obj), ES->allocateVModule());
+  return ObjLinkingLayer.add(JD, std::move(Obj), K);
 }
 
 Expected<JITEvaluatedSymbol> LLJIT::lookupLinkerMangled(JITDylib &JD,
@@ -80,23 +83,25 @@ Expected<JITEvaluatedSymbol> LLJIT::lookupLinkerMangled(JITDylib &JD,
 }
 
 LLJIT::LLJIT(std::unique_ptr<ExecutionSession> ES,
-             std::unique_ptr<TargetMachine> TM, DataLayout DL)
+             std::unique_ptr<TargetMachine> TM, DataLayout DL,
+             ObjectCache *ObjCache)
     : ES(std::move(ES)), Main(this->ES->getMainJITDylib()), DL(std::move(DL)),
       ObjLinkingLayer(
           *this->ES,
           []() { return llvm::make_unique<SectionMemoryManager>(); }),
       CompileLayer(*this->ES, ObjLinkingLayer,
-                   TMOwningSimpleCompiler(std::move(TM))),
+                   TMOwningSimpleCompiler(std::move(TM), ObjCache)),
       CtorRunner(Main), DtorRunner(Main) {}
 
 LLJIT::LLJIT(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
-             DataLayout DL, unsigned NumCompileThreads)
+             DataLayout DL, unsigned NumCompileThreads,
+             ObjectCache *ObjCache)
     : ES(std::move(ES)), Main(this->ES->getMainJITDylib()), DL(std::move(DL)),
       ObjLinkingLayer(
           *this->ES,
           []() { return llvm::make_unique<SectionMemoryManager>(); }),
       CompileLayer(*this->ES, ObjLinkingLayer,
-                   ConcurrentIRCompiler(std::move(JTMB))),
+                   ConcurrentIRCompiler(std::move(JTMB), ObjCache)),
       CtorRunner(Main), DtorRunner(Main) {
   assert(NumCompileThreads != 0 &&
          "Multithreaded LLJIT instance can not be created with 0 threads");
@@ -105,16 +110,14 @@ LLJIT::LLJIT(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
   // them in parallel.
   CompileLayer.setCloneToNewContextOnEmit(true);
 
-  // Create a thread pool to compile on and set the execution session
-  // dispatcher to use the thread pool.
-  CompileThreads = llvm::make_unique<ThreadPool>(NumCompileThreads);
-  this->ES->setDispatchMaterialization(
-      [this](JITDylib &JD, std::unique_ptr<MaterializationUnit> MU) {
-        // FIXME: Switch to move capture once we have c++14.
-        auto SharedMU = std::shared_ptr<MaterializationUnit>(std::move(MU));
-        auto Work = [SharedMU, &JD]() { SharedMU->doMaterialize(JD); };
-        CompileThreads->async(std::move(Work));
-      });
+  // Create a dispatcher to compile on and set the execution session to use it.
+  CompileThreads =
+      llvm::make_unique<MaterializationDispatcher>(NumCompileThreads);
+  this->ES->setDispatchMaterialization(CompileThreads->getDispatchFunction());
+  this->ES->setNotifyQueryBlocked(
+      CompileThreads->getNotifyQueryBlockedFunction());
+  this->ES->setDispatchSpeculativeMaterialization(
+      CompileThreads->getSpeculativeDispatchFunction());
 }
 
 std::string LLJIT::mangle(StringRef UnmangledName) {
@@ -143,9 +146,15 @@ void LLJIT::recordCtorDtors(Module &M) {
   DtorRunner.add(getDestructors(M));
 }
 
+LLLazyJIT::~LLLazyJIT() {
+  if (CompileThreads)
+    CompileThreads->wait();
+}
+
 Expected<std::unique_ptr<LLLazyJIT>>
 LLLazyJIT::Create(JITTargetMachineBuilder JTMB, DataLayout DL,
-                  JITTargetAddress ErrorAddr, unsigned NumCompileThreads) {
+                  JITTargetAddress ErrorAddr, unsigned NumCompileThreads,
+                  ObjectCache *ObjCache) {
   auto ES = llvm::make_unique<ExecutionSession>();
 
   const Triple &TT = JTMB.getTargetTriple();
@@ -165,16 +174,30 @@ LLLazyJIT::Create(JITTargetMachineBuilder JTMB, DataLayout DL,
     if (!TM)
       return TM.takeError();
     return std::unique_ptr<LLLazyJIT>(
-        new LLLazyJIT(std::move(ES), std::move(*TM), std::move(DL),
+        new LLLazyJIT(std::move(ES), std::move(*TM), std::move(DL), ObjCache,
                       std::move(*LCTMgr), std::move(ISMBuilder)));
   }
 
   return std::unique_ptr<LLLazyJIT>(new LLLazyJIT(
       std::move(ES), std::move(JTMB), std::move(DL), NumCompileThreads,
-      std::move(*LCTMgr), std::move(ISMBuilder)));
+      ObjCache, std::move(*LCTMgr), std::move(ISMBuilder)));
 }
 
-Error LLLazyJIT::addLazyIRModule(JITDylib &JD, ThreadSafeModule TSM) {
+Error LLLazyJIT::enableTieredCompilation(JITTargetMachineBuilder FastJTMB,
+                                         unsigned HotThreshold) {
+  if (!CompileThreads)
+    return make_error<StringError>(
+        "Tiered compilation requires a multi-threaded LLLazyJIT",
+        inconvertibleErrorCode());
+
+  FastCompileLayer = llvm::make_unique<IRCompileLayer>(
+      *ES, ObjLinkingLayer, ConcurrentIRCompiler(std::move(FastJTMB)));
+  TieringLayer.enableTiering(*FastCompileLayer, HotThreshold);
+  return Error::success();
+}
+
+Error LLLazyJIT::addLazyIRModule(JITDylib &JD, ThreadSafeModule TSM,
+                                 VModuleKey K) {
   assert(TSM && "Can not add null module");
 
   if (auto Err = applyDataLayout(*TSM.getModule()))
@@ -182,26 +205,38 @@ Error LLLazyJIT::addLazyIRModule(JITDylib &JD, ThreadSafeModule TSM) {
 
   recordCtorDtors(*TSM.getModule());
 
-  return CODLayer.add(JD, std::move(TSM), ES->allocateVModule());
+  return CODLayer.add(JD, std::move(TSM), K);
 }
 
 LLLazyJIT::LLLazyJIT(
     std::unique_ptr<ExecutionSession> ES, std::unique_ptr<TargetMachine> TM,
-    DataLayout DL, std::unique_ptr<LazyCallThroughManager> LCTMgr,
+    DataLayout DL, ObjectCache *ObjCache,
+    std::unique_ptr<LazyCallThroughManager> LCTMgr,
     std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder)
-    : LLJIT(std::move(ES), std::move(TM), std::move(DL)),
+    : LLJIT(std::move(ES), std::move(TM), std::move(DL), ObjCache),
       LCTMgr(std::move(LCTMgr)), TransformLayer(*this->ES, CompileLayer),
-      CODLayer(*this->ES, TransformLayer, *this->LCTMgr,
+      TieringLayer(*this->ES, TransformLayer,
+                   [this](JITDylib &ImplD, const SymbolStringPtr &Name,
+                          JITTargetAddress NewAddr) {
+                     return CODLayer.redirect(ImplD, Name, NewAddr);
+                   }),
+      CODLayer(*this->ES, TieringLayer, *this->LCTMgr,
                std::move(ISMBuilder)) {}
 
 LLLazyJIT::LLLazyJIT(
     std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
-    DataLayout DL, unsigned NumCompileThreads,
+    DataLayout DL, unsigned NumCompileThreads, ObjectCache *ObjCache,
     std::unique_ptr<LazyCallThroughManager> LCTMgr,
     std::function<std::unique_ptr<IndirectStubsManager>()> ISMBuilder)
-    : LLJIT(std::move(ES), std::move(JTMB), std::move(DL), NumCompileThreads),
+    : LLJIT(std::move(ES), std::move(JTMB), std::move(DL), NumCompileThreads,
+            ObjCache),
       LCTMgr(std::move(LCTMgr)), TransformLayer(*this->ES, CompileLayer),
-      CODLayer(*this->ES, TransformLayer, *this->LCTMgr,
+      TieringLayer(*this->ES, TransformLayer,
+                   [this](JITDylib &ImplD, const SymbolStringPtr &Name,
+                          JITTargetAddress NewAddr) {
+                     return CODLayer.redirect(ImplD, Name, NewAddr);
+                   }),
+      CODLayer(*this->ES, TieringLayer, *this->LCTMgr,
                std::move(ISMBuilder)) {
   CODLayer.setCloneToNewContextOnEmit(true);
 }
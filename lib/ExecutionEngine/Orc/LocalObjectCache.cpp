@@ -0,0 +1,216 @@
+//===------- LocalObjectCache.cpp - Disk-backed object cache for ORC ------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/LocalObjectCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/VCSRevision.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+#define DEBUG_TYPE "orc"
+
+namespace llvm {
+namespace orc {
+
+// Compute the part of the cache key that depends on the target configuration
+// rather than on the module being compiled.
+static std::string computeTargetKey(const TargetMachine &TM) {
+  SHA1 Hasher;
+
+  auto AddString = [&](StringRef Str) {
+    Hasher.update(Str);
+    Hasher.update(ArrayRef<uint8_t>{0});
+  };
+  auto AddUnsigned = [&](unsigned I) {
+    uint8_t Data[4];
+    Data[0] = I;
+    Data[1] = I >> 8;
+    Data[2] = I >> 16;
+    Data[3] = I >> 24;
+    Hasher.update(ArrayRef<uint8_t>{Data, 4});
+  };
+
+  // Objects produced by a different version of LLVM are never reused.
+  AddString(LLVM_VERSION_STRING);
+#ifdef LLVM_REVISION
+  AddString(LLVM_REVISION);
+#endif
+
+  AddString(TM.getTargetTriple().str());
+  AddString(TM.getTargetCPU());
+  AddString(TM.getTargetFeatureString());
+  AddUnsigned(TM.getRelocationModel());
+  AddUnsigned(TM.getCodeModel());
+  AddUnsigned(TM.getOptLevel());
+
+  const TargetOptions &Options = TM.Options;
+  AddUnsigned(Options.UnsafeFPMath);
+  AddUnsigned(Options.NoInfsFPMath);
+  AddUnsigned(Options.NoNaNsFPMath);
+  AddUnsigned(Options.NoSignedZerosFPMath);
+  AddUnsigned(Options.NoTrappingFPMath);
+  AddUnsigned(Options.HonorSignDependentRoundingFPMathOption);
+  AddUnsigned(Options.NoZerosInBSS);
+  AddUnsigned(Options.GuaranteedTailCallOpt);
+  AddUnsigned(Options.StackSymbolOrdering);
+  AddUnsigned(Options.EnableFastISel);
+  AddUnsigned(Options.EnableGlobalISel);
+  AddUnsigned(Options.UseInitArray);
+  AddUnsigned(Options.RelaxELFRelocations);
+  AddUnsigned(Options.FunctionSections);
+  AddUnsigned(Options.DataSections);
+  AddUnsigned(Options.UniqueSectionNames);
+  AddUnsigned(Options.TrapUnreachable);
+  AddUnsigned(Options.EmulatedTLS);
+  AddUnsigned(Options.ExplicitEmulatedTLS);
+  AddUnsigned(Options.EnableIPRA);
+  AddUnsigned(Options.FloatABIType);
+  AddUnsigned(Options.AllowFPOpFusion);
+  AddUnsigned(Options.ThreadModel);
+  AddUnsigned(static_cast<unsigned>(Options.EABIVersion));
+  AddUnsigned(static_cast<unsigned>(Options.DebuggerTuning));
+  AddUnsigned(static_cast<unsigned>(Options.ExceptionModel));
+
+  return toHex(Hasher.result());
+}
+
+Expected<std::unique_ptr<LocalObjectCache>>
+LocalObjectCache::Create(StringRef CacheDir, const TargetMachine &TM,
+                         CachePruningPolicy Policy) {
+  if (std::error_code EC = sys::fs::create_directories(CacheDir))
+    return errorCodeToError(EC);
+
+  std::unique_ptr<LocalObjectCache> Cache(new LocalObjectCache(
+      CacheDir, computeTargetKey(TM), std::move(Policy)));
+  Cache->prune();
+  return std::move(Cache);
+}
+
+LocalObjectCache::LocalObjectCache(std::string CacheDir, std::string TargetKey,
+                                   CachePruningPolicy Policy)
+    : CacheDir(std::move(CacheDir)), TargetKey(std::move(TargetKey)),
+      Policy(std::move(Policy)) {}
+
+LocalObjectCache::~LocalObjectCache() { prune(); }
+
+bool LocalObjectCache::prune() { return pruneCache(CacheDir, Policy); }
+
+std::string LocalObjectCache::computeKey(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+  }
+
+  SHA1 Hasher;
+  Hasher.update(TargetKey);
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+  return toHex(Hasher.result());
+}
+
+std::string LocalObjectCache::getEntryPath(StringRef Key) const {
+  // This choice of file name allows the cache to be pruned (see pruneCache()
+  // in include/llvm/Support/CachePruning.h).
+  SmallString<64> EntryPath;
+  sys::path::append(EntryPath, CacheDir, "llvmcache-" + Key);
+  return EntryPath.str();
+}
+
+std::unique_ptr<MemoryBuffer> LocalObjectCache::getObject(const Module *M) {
+  std::string Key = computeKey(*M);
+  std::string EntryPath = getEntryPath(Key);
+
+  int FD;
+  if (!sys::fs::openFileForRead(EntryPath, FD, sys::fs::OF_UpdateAtime)) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+        MemoryBuffer::getOpenFile(FD, EntryPath,
+                                  /*FileSize*/ -1,
+                                  /*RequiresNullTerminator*/ false);
+    close(FD);
+    if (MBOrErr) {
+      LLVM_DEBUG(dbgs() << "Object cache hit for " << M->getModuleIdentifier()
+                        << ": " << EntryPath << "\n");
+      return std::move(*MBOrErr);
+    }
+  }
+
+  // Treat any failure to read the entry (e.g. because it is being pruned by
+  // another process) as a miss: the module will simply be recompiled.
+  LLVM_DEBUG(dbgs() << "Object cache miss for " << M->getModuleIdentifier()
+                    << "\n");
+  std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+  PendingKeys[M] = std::move(Key);
+  return nullptr;
+}
+
+void LocalObjectCache::notifyObjectCompiled(const Module *M,
+                                            MemoryBufferRef Obj) {
+  std::string Key;
+  {
+    std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+    auto I = PendingKeys.find(M);
+    if (I == PendingKeys.end())
+      return;
+    Key = std::move(I->second);
+    PendingKeys.erase(I);
+  }
+
+  // Write to a temporary file first so that concurrent readers never see a
+  // partially written entry. Failing to populate the cache is not an error.
+  SmallString<64> TempFilenameModel;
+  sys::path::append(TempFilenameModel, CacheDir, "Orc-%%%%%%.tmp.o");
+  Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+      TempFilenameModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+
+  bool WriteFailed;
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose*/ false);
+    OS << Obj.getBuffer();
+    OS.flush();
+    WriteFailed = OS.has_error();
+    OS.clear_error();
+  }
+
+  if (WriteFailed) {
+    consumeError(Temp->discard());
+    return;
+  }
+
+  if (Error Err = Temp->keep(getEntryPath(Key))) {
+    consumeError(std::move(Err));
+    consumeError(Temp->discard());
+  }
+}
+
+void LocalObjectCache::notifyObjectCompileFailed(const Module *M) {
+  std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+  PendingKeys.erase(M);
+}
+
+} // end namespace orc
+} // end namespace llvm
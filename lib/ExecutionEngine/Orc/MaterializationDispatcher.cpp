@@ -0,0 +1,176 @@
+//===--- MaterializationDispatcher.cpp - Prioritized MU dispatch ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/MaterializationDispatcher.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+
+#define DEBUG_TYPE "orc"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+static double toMilliseconds(MaterializationDispatcher::Clock::duration D) {
+  return std::chrono::duration<double, std::milli>(D).count();
+}
+
+MaterializationDispatcher::MaterializationDispatcher(unsigned NumThreads)
+    : CompileThreads(NumThreads) {
+  assert(NumThreads != 0 && "Dispatcher needs at least one compile thread");
+}
+
+MaterializationDispatcher::~MaterializationDispatcher() { wait(); }
+
+void MaterializationDispatcher::wait() { CompileThreads.wait(); }
+
+size_t MaterializationDispatcher::getQueueDepth() const {
+  std::lock_guard<std::mutex> Lock(QueueMutex);
+  return DemandedUnits.size() + SpeculativeUnits.size();
+}
+
+MaterializationDispatcher::Statistics
+MaterializationDispatcher::getStatistics() const {
+  std::lock_guard<std::mutex> Lock(QueueMutex);
+  return Stats;
+}
+
+void MaterializationDispatcher::printStatistics(raw_ostream &OS) const {
+  Statistics S = getStatistics();
+  OS << "Materialization dispatcher statistics:\n"
+     << "  units dispatched:        " << S.NumDispatched << " ("
+     << S.NumSpeculative << " speculative, " << S.NumPromoted
+     << " promoted)\n"
+     << "  units materialized:      " << S.NumMaterialized << "\n"
+     << "  max queue depth:         " << S.MaxQueueDepth << "\n";
+  if (S.NumMaterialized == 0)
+    return;
+  OS << "  queue latency (ms):      avg "
+     << format("%.3f", toMilliseconds(S.TotalQueueLatency) / S.NumMaterialized)
+     << ", max " << format("%.3f", toMilliseconds(S.MaxQueueLatency)) << "\n"
+     << "  materialize latency (ms): avg "
+     << format("%.3f",
+               toMilliseconds(S.TotalMaterializeLatency) / S.NumMaterialized)
+     << ", max " << format("%.3f", toMilliseconds(S.MaxMaterializeLatency))
+     << "\n";
+}
+
+void MaterializationDispatcher::enqueue(JITDylib &JD,
+                                        std::unique_ptr<MaterializationUnit> MU,
+                                        bool Speculative) {
+  auto QU = std::make_shared<QueuedUnit>();
+  QU->JD = &JD;
+  QU->MU = std::move(MU);
+  QU->DispatchTime = Clock::now();
+
+  {
+    std::lock_guard<std::mutex> Lock(QueueMutex);
+    if (Speculative) {
+      auto &Symbols = SpeculativeSymbols[&JD];
+      for (auto &KV : QU->MU->getSymbols())
+        Symbols[KV.first] = QU.get();
+      SpeculativeUnits.push_back(std::move(QU));
+      ++Stats.NumSpeculative;
+    } else
+      DemandedUnits.push_back(std::move(QU));
+    ++Stats.NumDispatched;
+    Stats.MaxQueueDepth =
+        std::max<unsigned>(Stats.MaxQueueDepth,
+                           DemandedUnits.size() + SpeculativeUnits.size());
+  }
+
+  CompileThreads.async([this]() { runNextUnit(); });
+}
+
+void MaterializationDispatcher::forgetSpeculativeSymbols(
+    const QueuedUnit &QU) {
+  auto I = SpeculativeSymbols.find(QU.JD);
+  assert(I != SpeculativeSymbols.end() && "Speculative unit not indexed");
+  for (auto &KV : QU.MU->getSymbols())
+    I->second.erase(KV.first);
+  if (I->second.empty())
+    SpeculativeSymbols.erase(I);
+}
+
+void MaterializationDispatcher::notifyQueryBlocked(
+    const SymbolDependenceMap &Symbols) {
+  std::lock_guard<std::mutex> Lock(QueueMutex);
+  if (SpeculativeUnits.empty())
+    return;
+
+  SmallPtrSet<QueuedUnit *, 4> Blocking;
+  for (auto &KV : Symbols) {
+    auto I = SpeculativeSymbols.find(KV.first);
+    if (I == SpeculativeSymbols.end())
+      continue;
+    for (auto &Name : KV.second) {
+      auto J = I->second.find(Name);
+      if (J != I->second.end())
+        Blocking.insert(J->second);
+    }
+  }
+
+  // Promoted units are blocking a lookup right now, so run them before any
+  // other demanded unit, keeping their relative order.
+  auto InsertPos = DemandedUnits.begin();
+  for (auto I = SpeculativeUnits.begin();
+       !Blocking.empty() && I != SpeculativeUnits.end();) {
+    if (!Blocking.erase(I->get())) {
+      ++I;
+      continue;
+    }
+    forgetSpeculativeSymbols(**I);
+    InsertPos = std::next(DemandedUnits.insert(InsertPos, std::move(*I)));
+    I = SpeculativeUnits.erase(I);
+    ++Stats.NumPromoted;
+  }
+}
+
+std::shared_ptr<MaterializationDispatcher::QueuedUnit>
+MaterializationDispatcher::takeNextUnit() {
+  std::lock_guard<std::mutex> Lock(QueueMutex);
+  bool Speculative = DemandedUnits.empty();
+  auto &Queue = Speculative ? SpeculativeUnits : DemandedUnits;
+  // Every queued unit has a pool task of its own, so there is always work
+  // left when a task starts.
+  assert(!Queue.empty() && "Pool task started with no queued unit");
+  auto QU = std::move(Queue.front());
+  Queue.pop_front();
+  if (Speculative)
+    forgetSpeculativeSymbols(*QU);
+  return QU;
+}
+
+void MaterializationDispatcher::runNextUnit() {
+  auto QU = takeNextUnit();
+
+  auto Start = Clock::now();
+  auto QueueLatency = Start - QU->DispatchTime;
+  LLVM_DEBUG({
+    dbgs() << "Materializing " << QU->MU->getName() << " for "
+           << QU->JD->getName() << " after "
+           << format("%.3f", toMilliseconds(QueueLatency)) << " ms in queue\n";
+  });
+  QU->MU->doMaterialize(*QU->JD);
+  auto MaterializeLatency = Clock::now() - Start;
+  LLVM_DEBUG({
+    dbgs() << "Materialized unit for " << QU->JD->getName() << " in "
+           << format("%.3f", toMilliseconds(MaterializeLatency)) << " ms\n";
+  });
+
+  std::lock_guard<std::mutex> Lock(QueueMutex);
+  ++Stats.NumMaterialized;
+  Stats.TotalQueueLatency += QueueLatency;
+  Stats.MaxQueueLatency = std::max(Stats.MaxQueueLatency, QueueLatency);
+  Stats.TotalMaterializeLatency += MaterializeLatency;
+  Stats.MaxMaterializeLatency =
+      std::max(Stats.MaxMaterializeLatency, MaterializeLatency);
+}
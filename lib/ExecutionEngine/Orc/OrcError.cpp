@@ -60,6 +60,8 @@ public:
              "(Use StringError to get error message)";
     case OrcErrorCode::UnknownResourceHandle:
       return "Unknown resource handle";
+    case OrcErrorCode::RemoteSharedMemoryUnavailable:
+      return "Remote shared memory unavailable";
     }
     llvm_unreachable("Unhandled error code");
   }
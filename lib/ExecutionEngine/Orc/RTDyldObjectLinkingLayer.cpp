@@ -82,7 +82,13 @@ RTDyldObjectLinkingLayer::RTDyldObjectLinkingLayer(
     NotifyLoadedFunction NotifyLoaded, NotifyEmittedFunction NotifyEmitted)
     : ObjectLayer(ES), GetMemoryManager(GetMemoryManager),
       NotifyLoaded(std::move(NotifyLoaded)),
-      NotifyEmitted(std::move(NotifyEmitted)) {}
+      NotifyEmitted(std::move(NotifyEmitted)) {
+  ES.registerResourceManager(*this);
+}
+
+RTDyldObjectLinkingLayer::~RTDyldObjectLinkingLayer() {
+  getExecutionSession().deregisterResourceManager(*this);
+}
 
 void RTDyldObjectLinkingLayer::emit(MaterializationResponsibility R,
                                     std::unique_ptr<MemoryBuffer> O) {
@@ -128,8 +134,9 @@ void RTDyldObjectLinkingLayer::emit(MaterializationResponsibility R,
   {
     auto Tmp = GetMemoryManager();
     std::lock_guard<std::mutex> Lock(RTDyldLayerMutex);
-    MemMgrs.push_back(std::move(Tmp));
-    MemMgr = MemMgrs.back().get();
+    auto &KeyMemMgrs = MemMgrs[K];
+    KeyMemMgrs.push_back(std::move(Tmp));
+    MemMgr = KeyMemMgrs.back().get();
   }
 
   JITDylibSearchOrderResolver Resolver(*SharedR);
@@ -143,6 +150,7 @@ void RTDyldObjectLinkingLayer::emit(MaterializationResponsibility R,
    */
   jitLinkForORC(
       **Obj, std::move(O), *MemMgr, Resolver, ProcessAllSections,
+      ResolveRelocationsInParallel,
       [this, K, SharedR, &Obj, InternalSymbols](
           std::unique_ptr<RuntimeDyld::LoadedObjectInfo> LoadedObjInfo,
           std::map<StringRef, JITEvaluatedSymbol> ResolvedSymbols) {
@@ -212,5 +220,24 @@ void RTDyldObjectLinkingLayer::onObjEmit(VModuleKey K,
     NotifyEmitted(K);
 }
 
+Error RTDyldObjectLinkingLayer::removeResources(VModuleKey K) {
+  std::vector<std::unique_ptr<RuntimeDyld::MemoryManager>> MemMgrsToRemove;
+  {
+    std::lock_guard<std::mutex> Lock(RTDyldLayerMutex);
+    auto I = MemMgrs.find(K);
+    if (I == MemMgrs.end())
+      return Error::success();
+    MemMgrsToRemove = std::move(I->second);
+    MemMgrs.erase(I);
+  }
+
+  // The EH frames live in memory owned by the memory managers, so they must
+  // be deregistered before it is released.
+  for (auto &MemMgr : MemMgrsToRemove)
+    MemMgr->deregisterEHFrames();
+
+  return Error::success();
+}
+
 } // End namespace orc.
 } // End namespace llvm.
@@ -0,0 +1,279 @@
+//===------ TieredCompileLayer.cpp - Recompile hot functions --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/TieredCompileLayer.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+
+#define DEBUG_TYPE "orc"
+
+STATISTIC(NumFunctionsTieredUp,
+          "Number of functions redirected to their optimized body");
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace llvm {
+namespace orc {
+
+/// Provides the optimized (<function>.tier1) body of a hot function.
+class TierUpMaterializationUnit : public MaterializationUnit {
+public:
+  TierUpMaterializationUnit(TieredCompileLayer &Parent, SymbolFlagsMap Symbols,
+                            VModuleKey K, uint64_t FunctionId)
+      : MaterializationUnit(std::move(Symbols), std::move(K)), Parent(Parent),
+        FunctionId(FunctionId) {}
+
+  StringRef getName() const override { return "TierUpMaterializationUnit"; }
+
+private:
+  void materialize(MaterializationResponsibility R) override {
+    Parent.emitOptimized(std::move(R), FunctionId);
+  }
+
+  void discard(const JITDylib &JD, const SymbolStringPtr &Name) override {
+    llvm_unreachable("Tier-1 definitions should never be overridden");
+  }
+
+  TieredCompileLayer &Parent;
+  uint64_t FunctionId;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+TieredCompileLayer::TieredCompileLayer(ExecutionSession &ES,
+                                       IRLayer &OptimizingLayer,
+                                       RedirectFunction Redirect)
+    : IRLayer(ES), OptimizingLayer(OptimizingLayer),
+      Redirect(std::move(Redirect)) {
+  ES.registerResourceManager(*this);
+}
+
+TieredCompileLayer::~TieredCompileLayer() {
+  getExecutionSession().deregisterResourceManager(*this);
+}
+
+void TieredCompileLayer::enableTiering(IRLayer &FastLayer,
+                                       unsigned HotThreshold) {
+  assert(HotThreshold != 0 && "Hot threshold must be at least one call");
+  this->FastLayer = &FastLayer;
+  this->HotThreshold = HotThreshold;
+}
+
+void TieredCompileLayer::emit(MaterializationResponsibility R,
+                              ThreadSafeModule TSM) {
+  assert(TSM.getModule() && "Null module");
+
+  if (!FastLayer) {
+    OptimizingLayer.emit(std::move(R), std::move(TSM));
+    return;
+  }
+
+  auto &M = *TSM.getModule();
+
+  for (auto &GV : M.global_values())
+    if (GV.hasLocalLinkage() && !GV.isDeclaration()) {
+      LLVM_DEBUG(dbgs() << "Not tiering " << M.getModuleIdentifier()
+                        << ": local symbol " << GV.getName() << "\n");
+      OptimizingLayer.emit(std::move(R), std::move(TSM));
+      return;
+    }
+
+  std::vector<Function *> Functions;
+  for (auto &F : M.functions())
+    if (!F.isDeclaration() && !F.hasAvailableExternallyLinkage())
+      Functions.push_back(&F);
+
+  if (Functions.empty()) {
+    FastLayer->emit(std::move(R), std::move(TSM));
+    return;
+  }
+
+  // Keep an uninstrumented copy of the module to recompile hot functions from.
+  auto Source = std::make_shared<ThreadSafeModule>(cloneToNewContext(TSM));
+
+  auto &ES = getExecutionSession();
+  MangleAndInterner Mangle(ES, M.getDataLayout());
+  uint64_t FirstId;
+  {
+    std::lock_guard<std::mutex> Lock(TieredFunctionsMutex);
+    FirstId = NextFunctionId;
+    NextFunctionId += Functions.size();
+    auto K = R.getVModuleKey();
+    for (unsigned I = 0; I != Functions.size(); ++I) {
+      auto *F = Functions[I];
+      TieredFunctions[FirstId + I] = {K, &R.getTargetJITDylib(), F->getName(),
+                                      Mangle(F->getName()),
+                                      Mangle((F->getName() + ".tier1").str()),
+                                      Source};
+      if (K != VModuleKey())
+        ModuleFunctionIds[K].push_back(FirstId + I);
+    }
+  }
+
+  for (unsigned I = 0; I != Functions.size(); ++I)
+    instrument(*Functions[I], FirstId + I);
+
+  FastLayer->emit(std::move(R), std::move(TSM));
+}
+
+Error TieredCompileLayer::removeResources(VModuleKey K) {
+  if (K == VModuleKey())
+    return Error::success();
+
+  // Ids are never reused, so a call already in flight to a removed function
+  // finds no entry and does not tier up.
+  std::lock_guard<std::mutex> Lock(TieredFunctionsMutex);
+  auto I = ModuleFunctionIds.find(K);
+  if (I == ModuleFunctionIds.end())
+    return Error::success();
+  for (auto FunctionId : I->second)
+    TieredFunctions.erase(FunctionId);
+  ModuleFunctionIds.erase(I);
+  return Error::success();
+}
+
+void TieredCompileLayer::tierUpEntry(TieredCompileLayer *Layer,
+                                     uint64_t FunctionId) {
+  Layer->tierUp(FunctionId);
+}
+
+void TieredCompileLayer::instrument(Function &F, uint64_t FunctionId) {
+  Module &M = *F.getParent();
+  LLVMContext &Ctx = M.getContext();
+  Type *Int64Ty = Type::getInt64Ty(Ctx);
+  Type *Int8PtrTy = Type::getInt8PtrTy(Ctx);
+  Type *IntPtrTy = M.getDataLayout().getIntPtrType(Ctx);
+
+  auto *Counter =
+      new GlobalVariable(M, Int64Ty, false, GlobalValue::PrivateLinkage,
+                         ConstantInt::get(Int64Ty, 0),
+                         "__orc_tier_count." + F.getName());
+
+  // The tier-up entry point and this layer live in the JIT's own process, so
+  // their addresses can be baked into the instrumented code.
+  auto *TierUpTy = FunctionType::get(Type::getVoidTy(Ctx),
+                                     {Int8PtrTy, Int64Ty}, false);
+  Constant *TierUp = ConstantExpr::getIntToPtr(
+      ConstantInt::get(IntPtrTy, pointerToJITTargetAddress(&tierUpEntry)),
+      TierUpTy->getPointerTo());
+  Constant *Layer = ConstantExpr::getIntToPtr(
+      ConstantInt::get(IntPtrTy, pointerToJITTargetAddress(this)), Int8PtrTy);
+
+  // Count calls after the entry block's allocas so that they stay static, and
+  // call back into the layer exactly once, when the count reaches the
+  // threshold.
+  BasicBlock &Entry = F.getEntryBlock();
+  auto IP = Entry.getFirstInsertionPt();
+  while (isa<AllocaInst>(*IP))
+    ++IP;
+
+  IRBuilder<> B(&Entry, IP);
+  Value *Count = B.CreateAtomicRMW(AtomicRMWInst::Add, Counter, B.getInt64(1),
+                                   AtomicOrdering::Monotonic);
+  Value *IsHot = B.CreateICmpEQ(Count, B.getInt64(HotThreshold - 1));
+  Instruction *Then = SplitBlockAndInsertIfThen(
+      IsHot, &*IP, false, MDBuilder(Ctx).createBranchWeights(1, HotThreshold));
+  IRBuilder<>(Then).CreateCall(TierUp, {Layer, B.getInt64(FunctionId)});
+}
+
+TieredCompileLayer::TieredFunction
+TieredCompileLayer::getTieredFunction(uint64_t FunctionId) {
+  std::lock_guard<std::mutex> Lock(TieredFunctionsMutex);
+  assert(FunctionId < NextFunctionId && "Invalid function id");
+  auto I = TieredFunctions.find(FunctionId);
+  if (I == TieredFunctions.end())
+    return TieredFunction();
+  return I->second;
+}
+
+void TieredCompileLayer::tierUp(uint64_t FunctionId) {
+  auto &ES = getExecutionSession();
+  auto TF = getTieredFunction(FunctionId);
+
+  // The function's module was removed while a call was in flight.
+  if (!TF.Source)
+    return;
+
+  LLVM_DEBUG(dbgs() << "Tiering up " << TF.IRName << "\n");
+
+  SymbolFlagsMap Tier1Symbols(
+      {{TF.Tier1Name, JITSymbolFlags::Exported | JITSymbolFlags::Callable}});
+  if (auto Err = TF.ImplD->define(llvm::make_unique<TierUpMaterializationUnit>(
+          *this, std::move(Tier1Symbols), TF.K, FunctionId))) {
+    ES.reportError(std::move(Err));
+    return;
+  }
+
+  // Compile the optimized body in the background. Once it is ready, look up
+  // its address (which no longer blocks) and redirect the function to it.
+  ES.speculate(
+      {{TF.ImplD, true}}, {TF.Tier1Name}, [this, TF](Error Err) {
+        auto &ES = getExecutionSession();
+        if (Err) {
+          ES.reportError(std::move(Err));
+          return;
+        }
+        ES.lookup({{TF.ImplD, true}}, {TF.Tier1Name},
+                  [this, TF](Expected<SymbolMap> Result) {
+                    auto &ES = getExecutionSession();
+                    if (!Result) {
+                      ES.reportError(Result.takeError());
+                      return;
+                    }
+                    auto NewAddr = (*Result)[TF.Tier1Name].getAddress();
+                    if (auto Err = Redirect(*TF.ImplD, TF.Name, NewAddr)) {
+                      ES.reportError(std::move(Err));
+                      return;
+                    }
+                    LLVM_DEBUG(dbgs() << "Redirected " << TF.IRName << " to "
+                                      << format("0x%016" PRIx64, NewAddr)
+                                      << "\n");
+                    ++NumTieredUp;
+                    ++NumFunctionsTieredUp;
+                  },
+                  [](Error Err) {
+                    // Any failure was reported by the resolution callback.
+                    consumeError(std::move(Err));
+                  },
+                  NoDependenciesToRegister);
+      });
+}
+
+void TieredCompileLayer::emitOptimized(MaterializationResponsibility R,
+                                       uint64_t FunctionId) {
+  auto TF = getTieredFunction(FunctionId);
+  if (!TF.Source) {
+    R.failMaterialization();
+    return;
+  }
+
+  // Clone just the hot function: everything it references is already defined
+  // in the implementation dylib by the tier-0 module.
+  auto TSM = cloneToNewContext(*TF.Source, [&](const GlobalValue &GV) {
+    return GV.getName() == TF.IRName;
+  });
+  auto &M = *TSM.getModule();
+  M.setModuleIdentifier(M.getModuleIdentifier() + ".tier1");
+
+  auto *F = M.getFunction(TF.IRName);
+  assert(F && !F->isDeclaration() && "Hot function missing from source");
+  F->setName(TF.IRName + ".tier1");
+  F->setLinkage(GlobalValue::ExternalLinkage);
+  F->setVisibility(GlobalValue::DefaultVisibility);
+
+  OptimizingLayer.emit(std::move(R), std::move(TSM));
+}
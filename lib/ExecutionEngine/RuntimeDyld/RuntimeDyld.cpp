@@ -19,10 +19,12 @@
 #include "RuntimeDyldMachO.h"
 #include "llvm/Object/COFF.h"
 #include "llvm/Object/ELFObjectFile.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MSVCErrorWorkarounds.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MutexGuard.h"
+#include "llvm/Support/Parallel.h"
 
 #include <future>
 
@@ -31,6 +33,13 @@ using namespace llvm::object;
 
 #define DEBUG_TYPE "dyld"
 
+// Below this many relocations, the cost of distributing the work to other
+// threads outweighs the cost of resolving the relocations.
+static cl::opt<unsigned> MinParallelRelocations(
+    "rtdyld-parallel-relocation-threshold", cl::init(4096), cl::Hidden,
+    cl::desc("Minimum number of relocations to resolve in parallel, when "
+             "parallel relocation resolution is enabled"));
+
 namespace {
 
 enum RuntimeDyldErrorCode {
@@ -143,6 +152,7 @@ void RuntimeDyldImpl::resolveRelocations() {
 
 void RuntimeDyldImpl::resolveLocalRelocations() {
   // Iterate over all outstanding relocations
+  std::vector<std::pair<const RelocationList *, uint64_t>> Lists;
   for (auto it = Relocations.begin(), e = Relocations.end(); it != e; ++it) {
     // The Section here (Sections[i]) refers to the section in which the
     // symbol for the relocation is located.  The SectionID in the relocation
@@ -151,8 +161,9 @@ void RuntimeDyldImpl::resolveLocalRelocations() {
     uint64_t Addr = Sections[Idx].getLoadAddress();
     LLVM_DEBUG(dbgs() << "Resolving relocations Section #" << Idx << "\t"
                       << format("%p", (uintptr_t)Addr) << "\n");
-    resolveRelocationList(it->second, Addr);
+    Lists.push_back(std::make_pair(&it->second, Addr));
   }
+  resolveRelocationLists(Lists);
   Relocations.clear();
 }
 
@@ -1003,69 +1014,93 @@ void RuntimeDyldImpl::resolveRelocationList(const RelocationList &Relocs,
   }
 }
 
-void RuntimeDyldImpl::applyExternalSymbolRelocations(
-    const StringMap<JITEvaluatedSymbol> ExternalSymbolMap) {
-  while (!ExternalSymbolRelocations.empty()) {
+void RuntimeDyldImpl::resolveRelocationLists(
+    ArrayRef<std::pair<const RelocationList *, uint64_t>> Lists) {
+  size_t NumRelocations = 0;
+  for (auto &KV : Lists)
+    NumRelocations += KV.first->size();
+
+  if (!ResolveRelocationsInParallel || NumRelocations < MinParallelRelocations ||
+      !canResolveRelocationsConcurrently()) {
+    for (auto &KV : Lists)
+      resolveRelocationList(*KV.first, KV.second);
+    return;
+  }
 
-    StringMap<RelocationList>::iterator i = ExternalSymbolRelocations.begin();
+  // Group the relocations by the section they are applied to, keeping their
+  // order within each section, and resolve the sections concurrently.
+  using PendingRelocation = std::pair<const RelocationEntry *, uint64_t>;
+  std::vector<std::vector<PendingRelocation>> BySection(Sections.size());
+  for (auto &KV : Lists)
+    for (const RelocationEntry &RE : *KV.first)
+      // Ignore relocations for sections that were not loaded
+      if (Sections[RE.SectionID].getAddress() != nullptr)
+        BySection[RE.SectionID].push_back(std::make_pair(&RE, KV.second));
+
+  LLVM_DEBUG(dbgs() << "Resolving " << NumRelocations
+                    << " relocations in parallel\n");
+  parallel::for_each(parallel::par, BySection.begin(), BySection.end(),
+                     [this](const std::vector<PendingRelocation> &Relocs) {
+                       for (auto &P : Relocs)
+                         resolveRelocation(*P.first, P.second);
+                     });
+}
 
-    StringRef Name = i->first();
+void RuntimeDyldImpl::applyExternalSymbolRelocations(
+    const StringMap<JITEvaluatedSymbol> ExternalSymbolMap) {
+  std::vector<std::pair<const RelocationList *, uint64_t>> Lists;
+  for (auto &KV : ExternalSymbolRelocations) {
+    StringRef Name = KV.first();
+    const RelocationList &Relocs = KV.second;
     if (Name.size() == 0) {
       // This is an absolute symbol, use an address of zero.
       LLVM_DEBUG(dbgs() << "Resolving absolute relocations."
                         << "\n");
-      RelocationList &Relocs = i->second;
-      resolveRelocationList(Relocs, 0);
-    } else {
-      uint64_t Addr = 0;
-      JITSymbolFlags Flags;
-      RTDyldSymbolTable::const_iterator Loc = GlobalSymbolTable.find(Name);
-      if (Loc == GlobalSymbolTable.end()) {
-        auto RRI = ExternalSymbolMap.find(Name);
-        assert(RRI != ExternalSymbolMap.end() && "No result for symbol");
-        Addr = RRI->second.getAddress();
-        Flags = RRI->second.getFlags();
-        // The call to getSymbolAddress may have caused additional modules to
-        // be loaded, which may have added new entries to the
-        // ExternalSymbolRelocations map.  Consquently, we need to update our
-        // iterator.  This is also why retrieval of the relocation list
-        // associated with this symbol is deferred until below this point.
-        // New entries may have been added to the relocation list.
-        i = ExternalSymbolRelocations.find(Name);
-      } else {
-        // We found the symbol in our global table.  It was probably in a
-        // Module that we loaded previously.
-        const auto &SymInfo = Loc->second;
-        Addr = getSectionLoadAddress(SymInfo.getSectionID()) +
-               SymInfo.getOffset();
-        Flags = SymInfo.getFlags();
-      }
+      Lists.push_back(std::make_pair(&Relocs, 0));
+      continue;
+    }
 
-      // FIXME: Implement error handling that doesn't kill the host program!
-      if (!Addr)
-        report_fatal_error("Program used external function '" + Name +
-                           "' which could not be resolved!");
-
-      // If Resolver returned UINT64_MAX, the client wants to handle this symbol
-      // manually and we shouldn't resolve its relocations.
-      if (Addr != UINT64_MAX) {
-
-        // Tweak the address based on the symbol flags if necessary.
-        // For example, this is used by RuntimeDyldMachOARM to toggle the low bit
-        // if the target symbol is Thumb.
-        Addr = modifyAddressBasedOnFlags(Addr, Flags);
-
-        LLVM_DEBUG(dbgs() << "Resolving relocations Name: " << Name << "\t"
-                          << format("0x%lx", Addr) << "\n");
-        // This list may have been updated when we called getSymbolAddress, so
-        // don't change this code to get the list earlier.
-        RelocationList &Relocs = i->second;
-        resolveRelocationList(Relocs, Addr);
-      }
+    uint64_t Addr = 0;
+    JITSymbolFlags Flags;
+    RTDyldSymbolTable::const_iterator Loc = GlobalSymbolTable.find(Name);
+    if (Loc == GlobalSymbolTable.end()) {
+      auto RRI = ExternalSymbolMap.find(Name);
+      assert(RRI != ExternalSymbolMap.end() && "No result for symbol");
+      Addr = RRI->second.getAddress();
+      Flags = RRI->second.getFlags();
+    } else {
+      // We found the symbol in our global table.  It was probably in a
+      // Module that we loaded previously.
+      const auto &SymInfo = Loc->second;
+      Addr = getSectionLoadAddress(SymInfo.getSectionID()) +
+             SymInfo.getOffset();
+      Flags = SymInfo.getFlags();
     }
 
-    ExternalSymbolRelocations.erase(i);
+    // FIXME: Implement error handling that doesn't kill the host program!
+    if (!Addr)
+      report_fatal_error("Program used external function '" + Name +
+                         "' which could not be resolved!");
+
+    // If Resolver returned UINT64_MAX, the client wants to handle this symbol
+    // manually and we shouldn't resolve its relocations.
+    if (Addr == UINT64_MAX)
+      continue;
+
+    // Tweak the address based on the symbol flags if necessary.
+    // For example, this is used by RuntimeDyldMachOARM to toggle the low bit
+    // if the target symbol is Thumb.
+    Addr = modifyAddressBasedOnFlags(Addr, Flags);
+
+    LLVM_DEBUG(dbgs() << "Resolving relocations Name: " << Name << "\t"
+                      << format("0x%lx", Addr) << "\n");
+    Lists.push_back(std::make_pair(&Relocs, Addr));
   }
+
+  // All symbol values are known up front, so the relocations for all symbols
+  // can be resolved as one batch.
+  resolveRelocationLists(Lists);
+  ExternalSymbolRelocations.clear();
 }
 
 Error RuntimeDyldImpl::resolveExternalSymbols() {
@@ -1202,6 +1237,7 @@ RuntimeDyld::RuntimeDyld(RuntimeDyld::MemoryManager &MemMgr,
   // permissions are applied.
   Dyld = nullptr;
   ProcessAllSections = false;
+  ResolveRelocationsInParallel = false;
   Checker = nullptr;
 }
 
@@ -1258,6 +1294,7 @@ RuntimeDyld::loadObject(const ObjectFile &Obj) {
                ProcessAllSections, Checker);
     else
       report_fatal_error("Incompatible object format!");
+    Dyld->setResolveRelocationsInParallel(ResolveRelocationsInParallel);
   }
 
   if (!Dyld->isCompatibleFile(Obj))
@@ -1328,6 +1365,7 @@ void jitLinkForORC(object::ObjectFile &Obj,
                    std::unique_ptr<MemoryBuffer> UnderlyingBuffer,
                    RuntimeDyld::MemoryManager &MemMgr,
                    JITSymbolResolver &Resolver, bool ProcessAllSections,
+                   bool ResolveRelocationsInParallel,
                    std::function<Error(
                        std::unique_ptr<RuntimeDyld::LoadedObjectInfo> LoadedObj,
                        std::map<StringRef, JITEvaluatedSymbol>)>
@@ -1336,6 +1374,7 @@ void jitLinkForORC(object::ObjectFile &Obj,
 
   RuntimeDyld RTDyld(MemMgr, Resolver);
   RTDyld.setProcessAllSections(ProcessAllSections);
+  RTDyld.setResolveRelocationsInParallel(ResolveRelocationsInParallel);
 
   auto Info = RTDyld.loadObject(Obj);
 
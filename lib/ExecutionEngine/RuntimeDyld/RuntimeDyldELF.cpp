@@ -921,6 +921,19 @@ void RuntimeDyldELF::resolveRelocation(const RelocationEntry &RE,
                            RE.SymOffset, RE.SectionID);
 }
 
+bool RuntimeDyldELF::canResolveRelocationsConcurrently() const {
+  // Relocation processing for these targets does not touch the GOT, stubs or
+  // any other state of this instance.
+  switch (Arch) {
+  case Triple::x86_64:
+  case Triple::aarch64:
+  case Triple::aarch64_be:
+    return true;
+  default:
+    return false;
+  }
+}
+
 void RuntimeDyldELF::resolveRelocation(const SectionEntry &Section,
                                        uint64_t Offset, uint64_t Value,
                                        uint32_t Type, int64_t Addend,
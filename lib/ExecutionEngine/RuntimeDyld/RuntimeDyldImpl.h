@@ -14,6 +14,7 @@
 #ifndef LLVM_LIB_EXECUTIONENGINE_RUNTIMEDYLD_RUNTIMEDYLDIMPL_H
 #define LLVM_LIB_EXECUTIONENGINE_RUNTIMEDYLD_RUNTIMEDYLDIMPL_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/Triple.h"
@@ -301,6 +302,10 @@ protected:
   // sections containing relocations should be. Defaults to 'false'.
   bool ProcessAllSections;
 
+  // True if relocations targeting different sections may be resolved on
+  // separate threads. Defaults to 'false'.
+  bool ResolveRelocationsInParallel;
+
   // This mutex prevents simultaneously loading objects from two different
   // threads.  This keeps us from having to protect individual data structures
   // and guarantees that section allocation requests to the memory manager
@@ -424,6 +429,18 @@ protected:
   /// \param Value Target symbol address to apply the relocation action
   virtual void resolveRelocation(const RelocationEntry &RE, uint64_t Value) = 0;
 
+  /// Returns true if resolveRelocation only reads shared state and writes to
+  /// the bytes covered by the relocation, so that relocations that target
+  /// different sections can be resolved concurrently.
+  virtual bool canResolveRelocationsConcurrently() const { return false; }
+
+  /// Resolves each relocation list with its value. Relocations targeting the
+  /// same section are always resolved in order; if parallel resolution is
+  /// enabled (and supported by the target), different target sections are
+  /// resolved on separate threads.
+  void resolveRelocationLists(
+      ArrayRef<std::pair<const RelocationList *, uint64_t>> Lists);
+
   /// Parses one or more object file relocations (some object files use
   ///        relocation pairs) and stores it to Relocations or SymbolRelocations
   ///        (this depends on the object file type).
@@ -473,7 +490,8 @@ public:
   RuntimeDyldImpl(RuntimeDyld::MemoryManager &MemMgr,
                   JITSymbolResolver &Resolver)
     : MemMgr(MemMgr), Resolver(Resolver), Checker(nullptr),
-      ProcessAllSections(false), HasError(false) {
+      ProcessAllSections(false), ResolveRelocationsInParallel(false),
+      HasError(false) {
   }
 
   virtual ~RuntimeDyldImpl();
@@ -482,6 +500,10 @@ public:
     this->ProcessAllSections = ProcessAllSections;
   }
 
+  void setResolveRelocationsInParallel(bool ResolveRelocationsInParallel) {
+    this->ResolveRelocationsInParallel = ResolveRelocationsInParallel;
+  }
+
   void setRuntimeDyldChecker(RuntimeDyldCheckerImpl *Checker) {
     this->Checker = Checker;
   }
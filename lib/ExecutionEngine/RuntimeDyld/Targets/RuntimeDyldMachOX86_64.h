@@ -121,6 +121,8 @@ public:
     }
   }
 
+  bool canResolveRelocationsConcurrently() const override { return true; }
+
   Error finalizeSection(const ObjectFile &Obj, unsigned SectionID,
                         const SectionRef &Section) {
     return Error::success();
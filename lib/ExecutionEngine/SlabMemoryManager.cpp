@@ -0,0 +1,302 @@
+//===- SlabMemoryManager.cpp - Slab-based memory manager for RtDyld -------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a memory manager that packs the sections of many
+// objects into a few large slabs of memory.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/SlabMemoryManager.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Process.h"
+#include <iterator>
+
+namespace llvm {
+
+// Adds [Start, Start + Size) to FreeRanges, merging it with its neighbours.
+static void addFreeRange(std::map<uintptr_t, size_t> &FreeRanges,
+                         uintptr_t Start, size_t Size) {
+  auto Next = FreeRanges.lower_bound(Start);
+  if (Next != FreeRanges.end() && Start + Size == Next->first) {
+    Size += Next->second;
+    Next = FreeRanges.erase(Next);
+  }
+
+  if (Next != FreeRanges.begin()) {
+    auto Prev = std::prev(Next);
+    if (Prev->first + Prev->second == Start) {
+      Prev->second += Size;
+      return;
+    }
+  }
+
+  FreeRanges[Start] = Size;
+}
+
+const size_t SlabMemoryManager::SlabPool::HugePageSize;
+const size_t SlabMemoryManager::SlabPool::DefaultSlabSize;
+
+SlabMemoryManager::SlabPool::SlabPool(size_t SlabSize, bool UseHugePages)
+    : SlabSize(SlabSize), UseHugePages(UseHugePages) {}
+
+SlabMemoryManager::SlabPool::~SlabPool() {
+  for (SlabGroup *Group : {&CodeSlabs, &RODataSlabs, &RWDataSlabs})
+    for (sys::MemoryBlock &Slab : Group->Slabs)
+      sys::Memory::releaseMappedMemory(Slab);
+}
+
+SlabMemoryManager::SlabPool::SlabGroup &
+SlabMemoryManager::SlabPool::getGroup(AllocationPurpose Purpose) {
+  switch (Purpose) {
+  case AllocationPurpose::Code:
+    return CodeSlabs;
+  case AllocationPurpose::ROData:
+    return RODataSlabs;
+  case AllocationPurpose::RWData:
+    return RWDataSlabs;
+  }
+  llvm_unreachable("Unknown SlabMemoryManager::AllocationPurpose");
+}
+
+std::error_code SlabMemoryManager::SlabPool::mapSlab(SlabGroup &Group,
+                                                     size_t MinSize) {
+  static const size_t PageSize = sys::Process::getPageSize();
+  size_t Granularity = UseHugePages ? HugePageSize : PageSize;
+  size_t Size = alignTo(std::max(SlabSize, MinSize), Granularity);
+
+  // mmap only guarantees page alignment, so over-allocate to be able to start
+  // the usable part of the slab on a huge page boundary.
+  size_t MapSize = UseHugePages ? Size + HugePageSize : Size;
+  unsigned Flags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+  if (UseHugePages)
+    Flags |= sys::Memory::MF_HUGE_HINT;
+
+  std::error_code EC;
+  sys::MemoryBlock Slab = sys::Memory::allocateMappedMemory(
+      MapSize, LastSlab.base() ? &LastSlab : nullptr, Flags, EC);
+  if (EC)
+    return EC;
+
+  Group.Slabs.push_back(Slab);
+  LastSlab = Slab;
+  ++Stats.NumSlabs;
+  Stats.BytesMapped += Slab.size();
+
+  uintptr_t SlabStart = reinterpret_cast<uintptr_t>(Slab.base());
+  uintptr_t Start = alignTo(SlabStart, Granularity);
+  addFreeRange(Group.FreeRanges, Start, SlabStart + Slab.size() - Start);
+  return std::error_code();
+}
+
+sys::MemoryBlock
+SlabMemoryManager::SlabPool::allocate(AllocationPurpose Purpose,
+                                      size_t NumBytes, std::error_code &EC) {
+  static const size_t PageSize = sys::Process::getPageSize();
+  EC = std::error_code();
+  if (NumBytes == 0)
+    return sys::MemoryBlock();
+
+  size_t Size = alignTo(NumBytes, PageSize);
+
+  std::lock_guard<std::mutex> Lock(PoolMutex);
+  SlabGroup &Group = getGroup(Purpose);
+
+  // First fit, in address order, keeps live blocks packed at the start of
+  // the slabs.
+  auto FindFit = [&]() {
+    return find_if(Group.FreeRanges,
+                   [&](const std::pair<const uintptr_t, size_t> &Range) {
+                     return Range.second >= Size;
+                   });
+  };
+
+  auto I = FindFit();
+  if (I == Group.FreeRanges.end()) {
+    if ((EC = mapSlab(Group, Size)))
+      return sys::MemoryBlock();
+    I = FindFit();
+    assert(I != Group.FreeRanges.end() && "New slab too small");
+  }
+
+  uintptr_t Start = I->first;
+  size_t Available = I->second;
+  Group.FreeRanges.erase(I);
+  if (Available > Size)
+    Group.FreeRanges[Start + Size] = Available - Size;
+
+  Stats.BytesInUse += Size;
+  return sys::MemoryBlock(reinterpret_cast<void *>(Start), Size);
+}
+
+std::error_code
+SlabMemoryManager::SlabPool::protect(const sys::MemoryBlock &Block,
+                                     unsigned Flags) {
+  {
+    std::lock_guard<std::mutex> Lock(PoolMutex);
+    ++Stats.NumProtectCalls;
+  }
+  return sys::Memory::protectMappedMemory(Block, Flags);
+}
+
+std::error_code
+SlabMemoryManager::SlabPool::release(AllocationPurpose Purpose,
+                                     sys::MemoryBlock Block,
+                                     bool WasProtected) {
+  if (!Block.base())
+    return std::error_code();
+
+  // Make the block writable again before anyone else can be handed it. If
+  // that fails the block is leaked rather than reused.
+  if (WasProtected)
+    if (std::error_code EC = protect(Block, sys::Memory::MF_READ |
+                                                sys::Memory::MF_WRITE))
+      return EC;
+
+  std::lock_guard<std::mutex> Lock(PoolMutex);
+  addFreeRange(getGroup(Purpose).FreeRanges,
+               reinterpret_cast<uintptr_t>(Block.base()), Block.size());
+  Stats.BytesInUse -= Block.size();
+  return std::error_code();
+}
+
+SlabMemoryManager::SlabPool::Statistics
+SlabMemoryManager::SlabPool::getStatistics() const {
+  std::lock_guard<std::mutex> Lock(PoolMutex);
+  return Stats;
+}
+
+SlabMemoryManager::SlabMemoryManager(std::shared_ptr<SlabPool> Pool)
+    : Pool(Pool ? std::move(Pool) : std::make_shared<SlabPool>()) {}
+
+SlabMemoryManager::~SlabMemoryManager() {
+  // The EH frames live in the memory being released.
+  deregisterEHFrames();
+
+  for (auto Purpose : {AllocationPurpose::Code, AllocationPurpose::ROData,
+                       AllocationPurpose::RWData})
+    for (Block &B : getGroup(Purpose).Blocks)
+      Pool->release(Purpose, B.Memory, B.Protected);
+}
+
+SlabMemoryManager::MemoryGroup &
+SlabMemoryManager::getGroup(AllocationPurpose Purpose) {
+  switch (Purpose) {
+  case AllocationPurpose::Code:
+    return CodeMem;
+  case AllocationPurpose::ROData:
+    return RODataMem;
+  case AllocationPurpose::RWData:
+    return RWDataMem;
+  }
+  llvm_unreachable("Unknown SlabMemoryManager::AllocationPurpose");
+}
+
+bool SlabMemoryManager::addBlock(AllocationPurpose Purpose, size_t NumBytes) {
+  std::error_code EC;
+  sys::MemoryBlock MB = Pool->allocate(Purpose, NumBytes, EC);
+  if (EC)
+    return false;
+
+  MemoryGroup &Group = getGroup(Purpose);
+  Block B;
+  B.Memory = MB;
+  Group.Blocks.push_back(B);
+  Group.Cur = reinterpret_cast<uintptr_t>(MB.base());
+  Group.End = Group.Cur + MB.size();
+  return true;
+}
+
+void SlabMemoryManager::reserveAllocationSpace(
+    uintptr_t CodeSize, uint32_t CodeAlign, uintptr_t RODataSize,
+    uint32_t RODataAlign, uintptr_t RWDataSize, uint32_t RWDataAlign) {
+  // Leave room to align the first section of each block. If a reservation
+  // fails, allocateSection will try again and report the failure.
+  if (CodeSize)
+    addBlock(AllocationPurpose::Code, CodeSize + CodeAlign);
+  if (RODataSize)
+    addBlock(AllocationPurpose::ROData, RODataSize + RODataAlign);
+  if (RWDataSize)
+    addBlock(AllocationPurpose::RWData, RWDataSize + RWDataAlign);
+}
+
+uint8_t *SlabMemoryManager::allocateCodeSection(uintptr_t Size,
+                                                unsigned Alignment,
+                                                unsigned SectionID,
+                                                StringRef SectionName) {
+  return allocateSection(AllocationPurpose::Code, Size, Alignment);
+}
+
+uint8_t *SlabMemoryManager::allocateDataSection(uintptr_t Size,
+                                                unsigned Alignment,
+                                                unsigned SectionID,
+                                                StringRef SectionName,
+                                                bool IsReadOnly) {
+  if (IsReadOnly)
+    return allocateSection(AllocationPurpose::ROData, Size, Alignment);
+  return allocateSection(AllocationPurpose::RWData, Size, Alignment);
+}
+
+uint8_t *SlabMemoryManager::allocateSection(AllocationPurpose Purpose,
+                                            uintptr_t Size,
+                                            unsigned Alignment) {
+  if (!Alignment)
+    Alignment = 16;
+
+  assert(!(Alignment & (Alignment - 1)) && "Alignment must be a power of two.");
+
+  MemoryGroup &Group = getGroup(Purpose);
+  uintptr_t Addr = alignTo(Group.Cur, Alignment);
+  if (Group.Blocks.empty() || Addr + Size > Group.End) {
+    // Nothing (or not enough) was reserved for this purpose: take another
+    // block from the pool.
+    if (!addBlock(Purpose, Size + Alignment))
+      return nullptr;
+    Addr = alignTo(Group.Cur, Alignment);
+  }
+
+  Group.Cur = Addr + Size;
+  return reinterpret_cast<uint8_t *>(Addr);
+}
+
+std::error_code SlabMemoryManager::applyPermissions(MemoryGroup &Group,
+                                                    unsigned Permissions) {
+  for (Block &B : Group.Blocks) {
+    if (B.Protected)
+      continue;
+    if (std::error_code EC = Pool->protect(B.Memory, Permissions))
+      return EC;
+    B.Protected = true;
+    if (Permissions & sys::Memory::MF_EXEC)
+      sys::Memory::InvalidateInstructionCache(B.Memory.base(),
+                                              B.Memory.size());
+  }
+
+  // Protected blocks can not be written to any more, so later allocations
+  // need a new block.
+  Group.Cur = Group.End;
+  return std::error_code();
+}
+
+bool SlabMemoryManager::finalizeMemory(std::string *ErrMsg) {
+  std::error_code EC =
+      applyPermissions(CodeMem, sys::Memory::MF_READ | sys::Memory::MF_EXEC);
+  if (!EC)
+    EC = applyPermissions(RODataMem, sys::Memory::MF_READ);
+
+  if (EC) {
+    if (ErrMsg)
+      *ErrMsg = EC.message();
+    return true;
+  }
+
+  // Read-write data memory already has the correct permissions.
+  return false;
+}
+
+} // namespace llvm
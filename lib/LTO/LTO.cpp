@@ -27,6 +27,7 @@
 #include "llvm/LTO/LTOBackend.h"
 #include "llvm/Linker/IRMover.h"
 #include "llvm/Object/IRObjectFile.h"
+#include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -44,6 +45,8 @@
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 #include "llvm/Transforms/Utils/SplitModule.h"
 
+#include <condition_variable>
+#include <map>
 #include <set>
 
 using namespace llvm;
@@ -56,28 +59,27 @@ static cl::opt<bool>
     DumpThinCGSCCs("dump-thin-cg-sccs", cl::init(false), cl::Hidden,
                    cl::desc("Dump the SCCs in the ThinLTO index's callgraph"));
 
+static cl::opt<unsigned> ThinLTOBackendMemoryBudget(
+    "thinlto-backend-memory-budget", cl::init(0), cl::Hidden,
+    cl::desc("Approximate peak memory budget (in MB) for concurrently running "
+             "in-process ThinLTO backend tasks (0 = unlimited)"));
+
+/// Rough estimate of the peak memory consumed by a backend task per IR
+/// instruction in its context, covering the IR itself as well as the
+/// MachineIR and analyses built during optimization and code generation.
+static cl::opt<unsigned> ThinLTOBackendBytesPerInstruction(
+    "thinlto-backend-bytes-per-instruction", cl::init(1024), cl::Hidden,
+    cl::desc("Estimated peak memory use of a ThinLTO backend task per IR "
+             "instruction, for -thinlto-backend-memory-budget"));
+
 /// Enable global value internalization in LTO.
 cl::opt<bool> EnableLTOInternalization(
     "enable-lto-internalization", cl::init(true), cl::Hidden,
     cl::desc("Enable global value internalization in LTO"));
 
-// Computes a unique hash for the Module considering the current list of
-// export/import and other global analysis results.
-// The hash is produced in \p Key.
-void llvm::computeLTOCacheKey(
-    SmallString<40> &Key, const Config &Conf, const ModuleSummaryIndex &Index,
-    StringRef ModuleID, const FunctionImporter::ImportMapTy &ImportList,
-    const FunctionImporter::ExportSetTy &ExportList,
-    const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
-    const GVSummaryMapTy &DefinedGlobals,
-    const std::set<GlobalValue::GUID> &CfiFunctionDefs,
-    const std::set<GlobalValue::GUID> &CfiFunctionDecls) {
-  // Compute the unique hash for this entry.
-  // This is based on the current compiler version, the module itself, the
-  // export list, the hash for every single module in the import list, the
-  // list of ResolvedODR for the module, and the list of preserved symbols.
-  SHA1 Hasher;
-
+// Adds the compiler version and the parts of the LTO configuration that affect
+// code generation to \p Hasher.
+static void addConfigToHash(SHA1 &Hasher, const Config &Conf) {
   // Start with the compiler revision
   Hasher.update(LLVM_VERSION_STRING);
 #ifdef LLVM_REVISION
@@ -97,18 +99,6 @@ void llvm::computeLTOCacheKey(
     Data[3] = I >> 24;
     Hasher.update(ArrayRef<uint8_t>{Data, 4});
   };
-  auto AddUint64 = [&](uint64_t I) {
-    uint8_t Data[8];
-    Data[0] = I;
-    Data[1] = I >> 8;
-    Data[2] = I >> 16;
-    Data[3] = I >> 24;
-    Data[4] = I >> 32;
-    Data[5] = I >> 40;
-    Data[6] = I >> 48;
-    Data[7] = I >> 56;
-    Hasher.update(ArrayRef<uint8_t>{Data, 8});
-  };
   AddString(Conf.CPU);
   // FIXME: Hash more of Options. For now all clients initialize Options from
   // command-line flags (which is unsupported in production), but may set
@@ -138,6 +128,50 @@ void llvm::computeLTOCacheKey(
   AddString(Conf.OverrideTriple);
   AddString(Conf.DefaultTriple);
   AddString(Conf.DwoDir);
+}
+
+// Computes a unique hash for the Module considering the current list of
+// export/import and other global analysis results.
+// The hash is produced in \p Key.
+void llvm::computeLTOCacheKey(
+    SmallString<40> &Key, const Config &Conf, const ModuleSummaryIndex &Index,
+    StringRef ModuleID, const FunctionImporter::ImportMapTy &ImportList,
+    const FunctionImporter::ExportSetTy &ExportList,
+    const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
+    const GVSummaryMapTy &DefinedGlobals,
+    const std::set<GlobalValue::GUID> &CfiFunctionDefs,
+    const std::set<GlobalValue::GUID> &CfiFunctionDecls) {
+  // Compute the unique hash for this entry.
+  // This is based on the current compiler version, the module itself, the
+  // export list, the hash for every single module in the import list, the
+  // list of ResolvedODR for the module, and the list of preserved symbols.
+  SHA1 Hasher;
+  addConfigToHash(Hasher, Conf);
+
+  auto AddString = [&](StringRef Str) {
+    Hasher.update(Str);
+    Hasher.update(ArrayRef<uint8_t>{0});
+  };
+  auto AddUnsigned = [&](unsigned I) {
+    uint8_t Data[4];
+    Data[0] = I;
+    Data[1] = I >> 8;
+    Data[2] = I >> 16;
+    Data[3] = I >> 24;
+    Hasher.update(ArrayRef<uint8_t>{Data, 4});
+  };
+  auto AddUint64 = [&](uint64_t I) {
+    uint8_t Data[8];
+    Data[0] = I;
+    Data[1] = I >> 8;
+    Data[2] = I >> 16;
+    Data[3] = I >> 24;
+    Data[4] = I >> 32;
+    Data[5] = I >> 40;
+    Data[6] = I >> 48;
+    Data[7] = I >> 56;
+    Hasher.update(ArrayRef<uint8_t>{Data, 8});
+  };
 
   // Include the hash for the current module
   auto ModHash = Index.getModuleHash(ModuleID);
@@ -285,6 +319,16 @@ void llvm::computeLTOCacheKey(
   Key = toHex(Hasher.result());
 }
 
+// Computes a unique hash for a regular LTO code generation partition from its
+// optimized bitcode. The hash is produced in \p Key.
+void llvm::computeLTOPartitionCacheKey(SmallString<40> &Key,
+                                       const Config &Conf, StringRef Bitcode) {
+  SHA1 Hasher;
+  addConfigToHash(Hasher, Conf);
+  Hasher.update(Bitcode);
+  Key = toHex(Hasher.result());
+}
+
 static void thinLTOResolvePrevailingGUID(
     GlobalValueSummaryList &GVSummaryList, GlobalValue::GUID GUID,
     DenseSet<GlobalValueSummary *> &GlobalInvolvedWithAlias,
@@ -827,7 +871,7 @@ Error LTO::run(AddStreamFn AddStream, NativeObjectCache Cache) {
     StatsFile->keep();
   }
 
-  Error Result = runRegularLTO(AddStream);
+  Error Result = runRegularLTO(AddStream, Cache);
   if (!Result)
     Result = runThinLTO(AddStream, Cache);
 
@@ -837,7 +881,7 @@ Error LTO::run(AddStreamFn AddStream, NativeObjectCache Cache) {
   return Result;
 }
 
-Error LTO::runRegularLTO(AddStreamFn AddStream) {
+Error LTO::runRegularLTO(AddStreamFn AddStream, NativeObjectCache Cache) {
   for (auto &M : RegularLTO.ModsWithSummaries)
     if (Error Err = linkRegularLTO(std::move(M),
                                    /*LivenessFromIndex=*/true))
@@ -901,7 +945,8 @@ Error LTO::runRegularLTO(AddStreamFn AddStream) {
       return Error::success();
   }
   return backend(Conf, AddStream, RegularLTO.ParallelCodeGenParallelismLevel,
-                 std::move(RegularLTO.CombinedModule), ThinLTO.CombinedIndex);
+                 std::move(RegularLTO.CombinedModule), ThinLTO.CombinedIndex,
+                 Cache);
 }
 
 /// This class defines the interface to the ThinLTO backend.
@@ -938,6 +983,26 @@ class InProcessThinBackend : public ThinBackendProc {
   Optional<Error> Err;
   std::mutex ErrMu;
 
+  struct BackendTask {
+    unsigned Task;
+    BitcodeModule BM;
+    const FunctionImporter::ImportMapTy *ImportList;
+    const FunctionImporter::ExportSetTy *ExportList;
+    const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> *ResolvedODR;
+    const GVSummaryMapTy *DefinedGlobals;
+    MapVector<StringRef, BitcodeModule> *ModuleMap;
+    uint64_t Size;
+  };
+  /// Tasks queued by start(), largest first. Tasks of the same size stay in
+  /// the order they were queued.
+  std::multimap<uint64_t, BackendTask, std::greater<uint64_t>> PendingTasks;
+
+  /// Sum of the estimated sizes of the tasks currently running, guarded by
+  /// BudgetMu.
+  uint64_t InFlightSize = 0;
+  std::mutex BudgetMu;
+  std::condition_variable BudgetCV;
+
 public:
   InProcessThinBackend(
       Config &Conf, ModuleSummaryIndex &CombinedIndex,
@@ -1003,37 +1068,97 @@ public:
     assert(ModuleToDefinedGVSummaries.count(ModulePath));
     const GVSummaryMapTy &DefinedGlobals =
         ModuleToDefinedGVSummaries.find(ModulePath)->second;
-    BackendThreadPool.async(
-        [=](BitcodeModule BM, ModuleSummaryIndex &CombinedIndex,
-            const FunctionImporter::ImportMapTy &ImportList,
-            const FunctionImporter::ExportSetTy &ExportList,
-            const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes>
-                &ResolvedODR,
-            const GVSummaryMapTy &DefinedGlobals,
-            MapVector<StringRef, BitcodeModule> &ModuleMap) {
-          Error E = runThinLTOBackendThread(
-              AddStream, Cache, Task, BM, CombinedIndex, ImportList, ExportList,
-              ResolvedODR, DefinedGlobals, ModuleMap);
-          if (E) {
-            std::unique_lock<std::mutex> L(ErrMu);
-            if (Err)
-              Err = joinErrors(std::move(*Err), std::move(E));
-            else
-              Err = std::move(E);
-          }
-        },
-        BM, std::ref(CombinedIndex), std::ref(ImportList), std::ref(ExportList),
-        std::ref(ResolvedODR), std::ref(DefinedGlobals), std::ref(ModuleMap));
+    // Tasks are only queued here; they are dispatched from wait() once every
+    // module is known, so that they can be ordered and throttled by size.
+    uint64_t Size = estimateTaskSize(DefinedGlobals, ImportList);
+    PendingTasks.emplace(Size, BackendTask{Task, BM, &ImportList, &ExportList,
+                                           &ResolvedODR, &DefinedGlobals,
+                                           &ModuleMap, Size});
     return Error::success();
   }
 
   Error wait() override {
+    // Start the largest tasks first: they dominate the critical path, and
+    // smaller tasks can fill in the remaining threads and budget afterwards.
+    uint64_t BytesPerInstruction =
+        std::max(ThinLTOBackendBytesPerInstruction.getValue(), 1u);
+    uint64_t Budget = 0;
+    // A non-zero budget must not round down to 0, which means unlimited.
+    if (ThinLTOBackendMemoryBudget)
+      Budget = std::max<uint64_t>(uint64_t(ThinLTOBackendMemoryBudget) * 1024 *
+                                      1024 / BytesPerInstruction,
+                                  1);
+
+    while (!PendingTasks.empty()) {
+      auto I = PendingTasks.end();
+      {
+        std::unique_lock<std::mutex> L(BudgetMu);
+        // Pick the largest task that fits in the remaining budget. A task
+        // larger than the whole budget is still run, but only on its own.
+        BudgetCV.wait(L, [&] {
+          I = PendingTasks.end();
+          if (!Budget)
+            I = PendingTasks.begin();
+          else if (InFlightSize <= Budget)
+            I = PendingTasks.lower_bound(Budget - InFlightSize);
+          if (I == PendingTasks.end() && InFlightSize == 0)
+            I = PendingTasks.begin();
+          return I != PendingTasks.end();
+        });
+        InFlightSize += I->second.Size;
+      }
+      BackendTask T = std::move(I->second);
+      PendingTasks.erase(I);
+      LLVM_DEBUG(dbgs() << "Scheduling ThinLTO backend task " << T.Task << " ("
+                        << T.BM.getModuleIdentifier()
+                        << "), estimated size: " << T.Size
+                        << " instructions\n");
+      LLVM_DEBUG(if (Budget && T.Size > Budget) dbgs()
+                 << "Task " << T.Task
+                 << " exceeds the memory budget; running it on its own\n");
+      BackendThreadPool.async([this, T] {
+        Error E = runThinLTOBackendThread(
+            AddStream, Cache, T.Task, T.BM, CombinedIndex, *T.ImportList,
+            *T.ExportList, *T.ResolvedODR, *T.DefinedGlobals, *T.ModuleMap);
+        if (E) {
+          std::unique_lock<std::mutex> L(ErrMu);
+          if (Err)
+            Err = joinErrors(std::move(*Err), std::move(E));
+          else
+            Err = std::move(E);
+        }
+        {
+          std::unique_lock<std::mutex> L(BudgetMu);
+          InFlightSize -= T.Size;
+        }
+        BudgetCV.notify_all();
+      });
+    }
+
     BackendThreadPool.wait();
     if (Err)
       return std::move(*Err);
     else
       return Error::success();
   }
+
+private:
+  /// Estimate the size of a backend task as the number of IR instructions
+  /// that will be live in its context: the functions defined in the module
+  /// plus every function imported into it.
+  uint64_t estimateTaskSize(const GVSummaryMapTy &DefinedGlobals,
+                            const FunctionImporter::ImportMapTy &ImportList) {
+    uint64_t Size = 1;
+    for (auto &Def : DefinedGlobals)
+      if (auto *FS = dyn_cast<FunctionSummary>(Def.second))
+        Size += FS->instCount();
+    for (auto &ILI : ImportList)
+      for (GlobalValue::GUID GUID : ILI.second)
+        if (auto *FS = dyn_cast_or_null<FunctionSummary>(
+                CombinedIndex.findSummaryInModule(GUID, ILI.first())))
+          Size += FS->instCount();
+    return Size;
+  }
 };
 } // end anonymous namespace
 
@@ -1074,6 +1199,14 @@ class WriteIndexesThinBackend : public ThinBackendProc {
   raw_fd_ostream *LinkedObjectsFile;
   lto::IndexWriteCallback OnWrite;
 
+  // The per-module index files are written concurrently. The combined index
+  // and the import lists are only read while doing so.
+  ThreadPool BackendThreadPool;
+  std::mutex OnWriteMu;
+
+  Optional<Error> Err;
+  std::mutex ErrMu;
+
 public:
   WriteIndexesThinBackend(
       Config &Conf, ModuleSummaryIndex &CombinedIndex,
@@ -1083,7 +1216,8 @@ public:
       : ThinBackendProc(Conf, CombinedIndex, ModuleToDefinedGVSummaries),
         OldPrefix(OldPrefix), NewPrefix(NewPrefix),
         ShouldEmitImportsFiles(ShouldEmitImportsFiles),
-        LinkedObjectsFile(LinkedObjectsFile), OnWrite(OnWrite) {}
+        LinkedObjectsFile(LinkedObjectsFile), OnWrite(OnWrite),
+        BackendThreadPool(llvm::hardware_concurrency()) {}
 
   Error start(
       unsigned Task, BitcodeModule BM,
@@ -1095,9 +1229,35 @@ public:
     std::string NewModulePath =
         getThinLTOOutputFile(ModulePath, OldPrefix, NewPrefix);
 
+    // The list of linked objects is written here so that it stays in module
+    // order.
     if (LinkedObjectsFile)
       *LinkedObjectsFile << NewModulePath << '\n';
 
+    BackendThreadPool.async(
+        [this, ModulePath, NewModulePath, &ImportList] {
+          if (Error E = writeIndexFiles(ModulePath, NewModulePath, ImportList)) {
+            std::unique_lock<std::mutex> L(ErrMu);
+            if (Err)
+              Err = joinErrors(std::move(*Err), std::move(E));
+            else
+              Err = std::move(E);
+          }
+        });
+    return Error::success();
+  }
+
+  Error wait() override {
+    BackendThreadPool.wait();
+    if (Err)
+      return std::move(*Err);
+    else
+      return Error::success();
+  }
+
+private:
+  Error writeIndexFiles(StringRef ModulePath, const std::string &NewModulePath,
+                        const FunctionImporter::ImportMapTy &ImportList) {
     std::map<std::string, GVSummaryMapTy> ModuleToSummariesForIndex;
     gatherImportedSummariesForModule(ModulePath, ModuleToDefinedGVSummaries,
                                      ImportList, ModuleToSummariesForIndex);
@@ -1116,12 +1276,13 @@ public:
         return errorCodeToError(EC);
     }
 
-    if (OnWrite)
+    if (OnWrite) {
+      // The callback is provided by the linker and need not be thread-safe.
+      std::lock_guard<std::mutex> L(OnWriteMu);
       OnWrite(ModulePath);
+    }
     return Error::success();
   }
-
-  Error wait() override { return Error::success(); }
 };
 } // end anonymous namespace
 
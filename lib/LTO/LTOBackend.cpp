@@ -36,6 +36,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
@@ -46,6 +47,23 @@
 using namespace llvm;
 using namespace lto;
 
+static cl::opt<bool> CostBalancedCodeGenSplit(
+    "lto-cost-balanced-split", cl::init(false), cl::Hidden,
+    cl::desc("Balance parallel LTO code generation partitions by estimated "
+             "codegen cost and keep call graph SCCs together"));
+
+static cl::opt<bool> ReportCodeGenPartitions(
+    "lto-report-codegen-partitions", cl::init(false), cl::Hidden,
+    cl::desc("Report the time spent generating code for each parallel LTO "
+             "code generation partition"));
+
+static cl::opt<bool> CacheCodeGenPartitions(
+    "lto-cache-codegen-partitions", cl::init(false), cl::Hidden,
+    cl::desc("Cache the native object of each regular LTO code generation "
+             "partition, keyed on its optimized IR, and reuse it in later "
+             "links (requires a cache directory; this only skips code "
+             "generation, optimization still runs on every link)"));
+
 LLVM_ATTRIBUTE_NORETURN static void reportOpenError(StringRef Path, Twine Msg) {
   errs() << "failed to open " << Path << ": " << Msg << '\n';
   errs().flush();
@@ -296,11 +314,9 @@ bool opt(Config &Conf, TargetMachine *TM, unsigned Task, Module &Mod,
   return !Conf.PostOptModuleHook || Conf.PostOptModuleHook(Task, Mod);
 }
 
-void codegen(Config &Conf, TargetMachine *TM, AddStreamFn AddStream,
-             unsigned Task, Module &Mod) {
-  if (Conf.PreCodeGenModuleHook && !Conf.PreCodeGenModuleHook(Task, Mod))
-    return;
-
+static void emitNativeObject(Config &Conf, TargetMachine *TM,
+                             AddStreamFn AddStream, unsigned Task,
+                             Module &Mod) {
   std::unique_ptr<ToolOutputFile> DwoOut;
   SmallString<1024> DwoFile(Conf.DwoPath);
   if (!Conf.DwoDir.empty()) {
@@ -333,9 +349,56 @@ void codegen(Config &Conf, TargetMachine *TM, AddStreamFn AddStream,
     DwoOut->keep();
 }
 
+void codegen(Config &Conf, TargetMachine *TM, AddStreamFn AddStream,
+             unsigned Task, Module &Mod) {
+  if (Conf.PreCodeGenModuleHook && !Conf.PreCodeGenModuleHook(Task, Mod))
+    return;
+  emitNativeObject(Conf, TM, AddStream, Task, Mod);
+}
+
+/// Generates code for a regular LTO partition whose optimized bitcode is BC,
+/// unless Cache already holds the native object for identical IR. The
+/// PreCodeGenModuleHook runs on cache hits too, so -save-temps output does not
+/// depend on the state of the cache.
+void codegenCached(Config &Conf, TargetMachine *TM, AddStreamFn AddStream,
+                   NativeObjectCache Cache, unsigned Task, Module &Mod,
+                   StringRef BC) {
+  if (Conf.PreCodeGenModuleHook && !Conf.PreCodeGenModuleHook(Task, Mod))
+    return;
+  SmallString<40> Key;
+  computeLTOPartitionCacheKey(Key, Conf, BC);
+  if (AddStreamFn CacheAddStream = Cache(Task, Key))
+    emitNativeObject(Conf, TM, CacheAddStream, Task, Mod);
+}
+
+/// Removes declarations that are not referenced by a partition. Every partition
+/// is cloned with declarations of all globals in the module, so without this
+/// any global added or removed elsewhere would change the cache key of every
+/// partition.
+void dropUnusedDeclarations(Module &Mod) {
+  for (auto I = Mod.begin(), E = Mod.end(); I != E;) {
+    Function &F = *I++;
+    if (F.isDeclaration() && F.use_empty())
+      F.eraseFromParent();
+  }
+  for (auto I = Mod.global_begin(), E = Mod.global_end(); I != E;) {
+    GlobalVariable &GV = *I++;
+    if (GV.isDeclaration() && GV.use_empty())
+      GV.eraseFromParent();
+  }
+}
+
 void splitCodeGen(Config &C, TargetMachine *TM, AddStreamFn AddStream,
+                  NativeObjectCache Cache,
                   unsigned ParallelCodeGenParallelismLevel,
                   std::unique_ptr<Module> Mod) {
+  // Timers for the per-partition report. They are created on this thread
+  // and each one is only started and stopped by the thread running its
+  // partition.
+  TimerGroup PartitionTimerGroup("lto-codegen-partitions",
+                                 "LTO Code Generation Partitions");
+  std::vector<std::unique_ptr<Timer>> PartitionTimers;
+
   ThreadPool CodegenThreadPool(ParallelCodeGenParallelismLevel);
   unsigned ThreadCount = 0;
   const Target *T = &TM->getTarget();
@@ -343,19 +406,34 @@ void splitCodeGen(Config &C, TargetMachine *TM, AddStreamFn AddStream,
   SplitModule(
       std::move(Mod), ParallelCodeGenParallelismLevel,
       [&](std::unique_ptr<Module> MPart) {
+        Timer *PartitionTimer = nullptr;
+        if (ReportCodeGenPartitions) {
+          std::string Name = "partition " + utostr(ThreadCount);
+          PartitionTimers.push_back(llvm::make_unique<Timer>(
+              Name,
+              Name + " (" + utostr(MPart->getInstructionCount()) +
+                  " instructions)",
+              PartitionTimerGroup));
+          PartitionTimer = PartitionTimers.back().get();
+        }
+
         // We want to clone the module in a new context to multi-thread the
         // codegen. We do it by serializing partition modules to bitcode
         // (while still on the main thread, in order to avoid data races) and
         // spinning up new threads which deserialize the partitions into
         // separate contexts.
         // FIXME: Provide a more direct way to do this in LLVM.
+        if (Cache)
+          dropUnusedDeclarations(*MPart);
         SmallString<0> BC;
         raw_svector_ostream BCOS(BC);
         WriteBitcodeToFile(*MPart, BCOS);
 
         // Enqueue the task
         CodegenThreadPool.async(
-            [&](const SmallString<0> &BC, unsigned ThreadId) {
+            [&](const SmallString<0> &BC, unsigned ThreadId,
+                Timer *PartitionTimer) {
+              TimeRegion TR(PartitionTimer);
               LTOLLVMContext Ctx(C);
               Expected<std::unique_ptr<Module>> MOrErr = parseBitcodeFile(
                   MemoryBufferRef(StringRef(BC.data(), BC.size()), "ld-temp.o"),
@@ -367,13 +445,17 @@ void splitCodeGen(Config &C, TargetMachine *TM, AddStreamFn AddStream,
               std::unique_ptr<TargetMachine> TM =
                   createTargetMachine(C, T, *MPartInCtx);
 
-              codegen(C, TM.get(), AddStream, ThreadId, *MPartInCtx);
+              if (Cache)
+                codegenCached(C, TM.get(), AddStream, Cache, ThreadId,
+                              *MPartInCtx, StringRef(BC.data(), BC.size()));
+              else
+                codegen(C, TM.get(), AddStream, ThreadId, *MPartInCtx);
             },
             // Pass BC using std::move to ensure that it get moved rather than
             // copied into the thread's context.
-            std::move(BC), ThreadCount++);
+            std::move(BC), ThreadCount++, PartitionTimer);
       },
-      false);
+      false, CostBalancedCodeGenSplit);
 
   // Because the inner lambda (which runs in a worker thread) captures our local
   // variables, we need to wait for the worker threads to terminate before we
@@ -410,7 +492,7 @@ finalizeOptimizationRemarks(std::unique_ptr<ToolOutputFile> DiagOutputFile) {
 Error lto::backend(Config &C, AddStreamFn AddStream,
                    unsigned ParallelCodeGenParallelismLevel,
                    std::unique_ptr<Module> Mod,
-                   ModuleSummaryIndex &CombinedIndex) {
+                   ModuleSummaryIndex &CombinedIndex, NativeObjectCache Cache) {
   Expected<const Target *> TOrErr = initAndLookupTarget(C, *Mod);
   if (!TOrErr)
     return TOrErr.takeError();
@@ -430,11 +512,23 @@ Error lto::backend(Config &C, AddStreamFn AddStream,
       return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
   }
 
+  // Split DWARF files are written as a side effect of code generation and
+  // would be missing for partitions loaded from the cache.
+  if (!CacheCodeGenPartitions || !C.DwoDir.empty() || !C.DwoPath.empty())
+    Cache = nullptr;
+
   if (ParallelCodeGenParallelismLevel == 1) {
-    codegen(C, TM.get(), AddStream, 0, *Mod);
+    if (Cache) {
+      SmallString<0> BC;
+      raw_svector_ostream BCOS(BC);
+      WriteBitcodeToFile(*Mod, BCOS);
+      codegenCached(C, TM.get(), AddStream, Cache, 0, *Mod, BC);
+    } else {
+      codegen(C, TM.get(), AddStream, 0, *Mod);
+    }
   } else {
-    splitCodeGen(C, TM.get(), AddStream, ParallelCodeGenParallelismLevel,
-                 std::move(Mod));
+    splitCodeGen(C, TM.get(), AddStream, Cache,
+                 ParallelCodeGenParallelismLevel, std::move(Mod));
   }
   return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
 }
@@ -126,6 +126,9 @@ MCSymbol *MCContext::getOrCreateSymbol(const Twine &Name) {
 
   assert(!NameRef.empty() && "Normal symbols cannot be unnamed!");
 
+  Optional<sys::SmartScopedLock<true>> Guard;
+  if (ThreadSafeSymbols)
+    Guard.emplace(SymbolsLock);
   MCSymbol *&Sym = Symbols[NameRef];
   if (!Sym)
     Sym = createSymbol(NameRef, false, false);
@@ -169,6 +172,10 @@ MCSymbol *MCContext::createSymbolImpl(const StringMapEntry<bool> *Name,
 
 MCSymbol *MCContext::createSymbol(StringRef Name, bool AlwaysAddSuffix,
                                   bool CanBeUnnamed) {
+  Optional<sys::SmartScopedLock<true>> Guard;
+  if (ThreadSafeSymbols)
+    Guard.emplace(SymbolsLock);
+
   if (CanBeUnnamed && !UseNamesOnTempLabels)
     return createSymbolImpl(nullptr, true);
 
@@ -256,6 +263,9 @@ MCSymbol *MCContext::getDirectionalLocalSymbol(unsigned LocalLabelVal,
 MCSymbol *MCContext::lookupSymbol(const Twine &Name) const {
   SmallString<128> NameSV;
   StringRef NameRef = Name.toStringRef(NameSV);
+  Optional<sys::SmartScopedLock<true>> Guard;
+  if (ThreadSafeSymbols)
+    Guard.emplace(SymbolsLock);
   return Symbols.lookup(NameRef);
 }
 
@@ -15,19 +15,23 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
+#include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Object/Archive.h"
+#include "llvm/Object/IRSymtab.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Object/SymbolicFile.h"
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <map>
+#include <mutex>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -386,12 +390,36 @@ getSymbols(MemoryBufferRef Buf, raw_ostream &SymNames, bool &HasObject) {
   std::vector<unsigned> Ret;
 
   // In the scenario when LLVMContext is populated SymbolicFile will contain a
-  // reference to it, thus SymbolicFile should be destroyed first.
-  LLVMContext Context;
+  // reference to it, thus SymbolicFile should be destroyed first. The context
+  // is only created if the module itself has to be read.
+  std::unique_ptr<LLVMContext> Context;
   std::unique_ptr<object::SymbolicFile> Obj;
   if (identify_magic(Buf.getBuffer()) == file_magic::bitcode) {
+    // Use the symbol table embedded in the bitcode file if it is current, so
+    // that the module itself does not need to be parsed. A missing or outdated
+    // table is not rebuilt: that costs more than reading the symbols from the
+    // module directly, which also works for modules that no table can be built
+    // for (for example one without a data layout).
+    Expected<BitcodeFileContents> BFCOrErr = getBitcodeFileContents(Buf);
+    if (BFCOrErr && irsymtab::hasCurrentSymtab(*BFCOrErr)) {
+      irsymtab::Reader R(
+          {BFCOrErr->Symtab.data(), BFCOrErr->Symtab.size()},
+          {BFCOrErr->StrtabForSymtab.data(), BFCOrErr->StrtabForSymtab.size()});
+      HasObject = true;
+      for (const irsymtab::Reader::SymbolRef &Sym : R.symbols()) {
+        if (Sym.isFormatSpecific() || !Sym.isGlobal() || Sym.isUndefined())
+          continue;
+        Ret.push_back(SymNames.tell());
+        SymNames << Sym.getName() << '\0';
+      }
+      return Ret;
+    }
+    if (!BFCOrErr)
+      consumeError(BFCOrErr.takeError());
+
+    Context = llvm::make_unique<LLVMContext>();
     auto ObjOrErr = object::SymbolicFile::createSymbolicFile(
-        Buf, file_magic::bitcode, &Context);
+        Buf, file_magic::bitcode, Context.get());
     if (!ObjOrErr) {
       // FIXME: check only for "not an object file" errors.
       consumeError(ObjOrErr.takeError());
@@ -423,7 +451,8 @@ getSymbols(MemoryBufferRef Buf, raw_ostream &SymNames, bool &HasObject) {
 static Expected<std::vector<MemberData>>
 computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                   object::Archive::Kind Kind, bool Thin, StringRef ArcName,
-                  bool Deterministic, ArrayRef<NewArchiveMember> NewMembers) {
+                  bool Deterministic, bool NeedSymbols,
+                  ArrayRef<NewArchiveMember> NewMembers) {
   static char PaddingData[8] = {'\n', '\n', '\n', '\n', '\n', '\n', '\n', '\n'};
 
   // This ignores the symbol table, but we only need the value mod 8 and the
@@ -483,7 +512,38 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
-  for (const NewArchiveMember &M : NewMembers) {
+  // Reading the symbols of a member is independent of all other members, so
+  // do it in parallel. Each member's names go to a separate buffer, and the
+  // buffers are concatenated in member order below, so the resulting symbol
+  // table is the same as if the members had been read one by one.
+  struct MemberSymbols {
+    SmallString<0> Names;
+    std::vector<unsigned> Offsets;
+    bool HasObject = false;
+  };
+  std::vector<MemberSymbols> Symbols(NewMembers.size());
+  if (NeedSymbols) {
+    std::mutex ErrMu;
+    Error Err = Error::success();
+    parallel::for_each_n(
+        parallel::par, size_t(0), NewMembers.size(), [&](size_t I) {
+          MemberSymbols &MS = Symbols[I];
+          raw_svector_ostream Names(MS.Names);
+          Expected<std::vector<unsigned>> OffsetsOrErr = getSymbols(
+              NewMembers[I].Buf->getMemBufferRef(), Names, MS.HasObject);
+          if (!OffsetsOrErr) {
+            std::lock_guard<std::mutex> Lock(ErrMu);
+            Err = joinErrors(std::move(Err), OffsetsOrErr.takeError());
+            return;
+          }
+          MS.Offsets = std::move(*OffsetsOrErr);
+        });
+    if (Err)
+      return std::move(Err);
+  }
+
+  for (size_t I = 0, E = NewMembers.size(); I != E; ++I) {
+    const NewArchiveMember &M = NewMembers[I];
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -509,13 +569,15 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                       Buf.getBufferSize() + MemberPadding);
     Out.flush();
 
-    Expected<std::vector<unsigned>> Symbols =
-        getSymbols(Buf, SymNames, HasObject);
-    if (auto E = Symbols.takeError())
-      return std::move(E);
+    MemberSymbols &MS = Symbols[I];
+    HasObject |= MS.HasObject;
+    uint64_t NamesBase = SymNames.tell();
+    for (unsigned &Offset : MS.Offsets)
+      Offset += NamesBase;
+    SymNames << MS.Names;
 
     Pos += Header.size() + Data.size() + Padding.size();
-    Ret.push_back({std::move(*Symbols), std::move(Header), Data, Padding});
+    Ret.push_back({std::move(MS.Offsets), std::move(Header), Data, Padding});
   }
   // If there are no symbols, emit an empty symbol table, to satisfy Solaris
   // tools, older versions of which expect a symbol table in a non-empty
@@ -538,7 +600,8 @@ Error llvm::writeArchive(StringRef ArcName,
   raw_svector_ostream StringTable(StringTableBuf);
 
   Expected<std::vector<MemberData>> DataOrErr = computeMemberData(
-      StringTable, SymNames, Kind, Thin, ArcName, Deterministic, NewMembers);
+      StringTable, SymNames, Kind, Thin, ArcName, Deterministic, WriteSymtab,
+      NewMembers);
   if (Error E = DataOrErr.takeError())
     return E;
   std::vector<MemberData> &Data = *DataOrErr;
@@ -359,14 +359,10 @@ static Expected<FileContents> upgrade(ArrayRef<BitcodeModule> BMs) {
   return std::move(FC);
 }
 
-Expected<FileContents> irsymtab::readBitcode(const BitcodeFileContents &BFC) {
-  if (BFC.Mods.empty())
-    return make_error<StringError>("Bitcode file does not contain any modules",
-                                   inconvertibleErrorCode());
-
+bool irsymtab::hasCurrentSymtab(const BitcodeFileContents &BFC) {
   if (BFC.StrtabForSymtab.empty() ||
       BFC.Symtab.size() < sizeof(storage::Header))
-    return upgrade(BFC.Mods);
+    return false;
 
   // We cannot use the regular reader to read the version and producer, because
   // it will expect the header to be in the current format. The only thing we
@@ -377,18 +373,27 @@ Expected<FileContents> irsymtab::readBitcode(const BitcodeFileContents &BFC) {
   StringRef Producer = Hdr->Producer.get(BFC.StrtabForSymtab);
   if (Version != storage::Header::kCurrentVersion ||
       Producer != kExpectedProducerName)
-    return upgrade(BFC.Mods);
-
-  FileContents FC;
-  FC.TheReader = {{BFC.Symtab.data(), BFC.Symtab.size()},
-                  {BFC.StrtabForSymtab.data(), BFC.StrtabForSymtab.size()}};
+    return false;
 
   // Finally, make sure that the number of modules in the symbol table matches
   // the number of modules in the bitcode file. If they differ, it may mean that
   // the bitcode file was created by binary concatenation, so we need to create
   // a new symbol table from scratch.
-  if (FC.TheReader.getNumModules() != BFC.Mods.size())
-    return upgrade(std::move(BFC.Mods));
+  Reader R({BFC.Symtab.data(), BFC.Symtab.size()},
+           {BFC.StrtabForSymtab.data(), BFC.StrtabForSymtab.size()});
+  return R.getNumModules() == BFC.Mods.size();
+}
+
+Expected<FileContents> irsymtab::readBitcode(const BitcodeFileContents &BFC) {
+  if (BFC.Mods.empty())
+    return make_error<StringError>("Bitcode file does not contain any modules",
+                                   inconvertibleErrorCode());
 
+  if (!hasCurrentSymtab(BFC))
+    return upgrade(BFC.Mods);
+
+  FileContents FC;
+  FC.TheReader = {{BFC.Symtab.data(), BFC.Symtab.size()},
+                  {BFC.StrtabForSymtab.data(), BFC.StrtabForSymtab.size()}};
   return std::move(FC);
 }
@@ -0,0 +1,236 @@
+//===- llvm/Support/SuffixArray.cpp - Array for finding repeats -----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the construction of suffix arrays with SA-IS, of their
+// LCP arrays with Kasai's algorithm, and the walk over their LCP intervals
+// that finds repeated substrings.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/SuffixArray.h"
+#include "llvm/ADT/DenseMap.h"
+#include <algorithm>
+
+using namespace llvm;
+
+/// Marks a slot of a suffix array that has not been filled in yet.
+static const unsigned Empty = -1;
+
+/// Set \p Buckets to the first slot (or, if \p End, to one past the last slot)
+/// of the suffixes starting with each character of the alphabet [0, \p K).
+static void getBuckets(ArrayRef<unsigned> S, unsigned K, bool End,
+                       std::vector<unsigned> &Buckets) {
+  Buckets.assign(K, 0);
+  for (unsigned C : S)
+    ++Buckets[C];
+  unsigned Sum = 0;
+  for (unsigned &B : Buckets) {
+    Sum += B;
+    B = End ? Sum : Sum - B;
+  }
+}
+
+/// Sort all the suffixes of \p S from the sorted S-type suffixes placed at the
+/// ends of their buckets in \p SA: first the L-type suffixes, left to right,
+/// then the S-type suffixes, right to left.
+static void induceSort(ArrayRef<unsigned> S, const std::vector<bool> &IsS,
+                       MutableArrayRef<unsigned> SA, unsigned K,
+                       std::vector<unsigned> &Buckets) {
+  unsigned N = S.size();
+  getBuckets(S, K, /*End=*/false, Buckets);
+  for (unsigned I = 0; I != N; ++I) {
+    unsigned J = SA[I];
+    if (J != Empty && J != 0 && !IsS[J - 1])
+      SA[Buckets[S[J - 1]]++] = J - 1;
+  }
+
+  getBuckets(S, K, /*End=*/true, Buckets);
+  for (unsigned I = N; I-- != 0;) {
+    unsigned J = SA[I];
+    if (J != Empty && J != 0 && IsS[J - 1])
+      SA[--Buckets[S[J - 1]]] = J - 1;
+  }
+}
+
+/// Fill \p SA with the suffix array of \p S, a string over the alphabet
+/// [0, \p K) whose last character is a 0 that occurs nowhere else.
+///
+/// A suffix is S-type if it is smaller than the suffix that follows it, and
+/// L-type otherwise; it is a leftmost S-type (LMS) suffix if it is S-type and
+/// follows an L-type suffix. Sorting the LMS suffixes is enough to induce the
+/// order of all the others. They are sorted by naming their substrings up to
+/// the next LMS suffix, and, if two of those are equal, by recursing on the
+/// string of names, which is at most half as long as \p S.
+static void buildSuffixArray(ArrayRef<unsigned> S,
+                             MutableArrayRef<unsigned> SA, unsigned K) {
+  unsigned N = S.size();
+  assert(N > 0 && S.back() == 0 && "String must end with a sentinel!");
+  if (N == 1) {
+    SA[0] = 0;
+    return;
+  }
+
+  std::vector<bool> IsS(N);
+  IsS[N - 1] = true;
+  for (unsigned I = N - 1; I-- != 0;)
+    IsS[I] = S[I] < S[I + 1] || (S[I] == S[I + 1] && IsS[I + 1]);
+  auto IsLMS = [&IsS](unsigned I) { return I != 0 && IsS[I] && !IsS[I - 1]; };
+
+  // Sort the substrings of the LMS suffixes.
+  std::vector<unsigned> Buckets;
+  getBuckets(S, K, /*End=*/true, Buckets);
+  std::fill(SA.begin(), SA.end(), Empty);
+  for (unsigned I = 1; I != N; ++I)
+    if (IsLMS(I))
+      SA[--Buckets[S[I]]] = I;
+  induceSort(S, IsS, SA, K, Buckets);
+
+  // Move them to the front of SA, in sorted order, and name them: equal
+  // substrings get the same name.
+  unsigned N1 = 0;
+  for (unsigned I = 0; I != N; ++I)
+    if (IsLMS(SA[I]))
+      SA[N1++] = SA[I];
+  std::fill(SA.begin() + N1, SA.end(), Empty);
+  unsigned Names = 0;
+  unsigned Prev = Empty;
+  for (unsigned I = 0; I != N1; ++I) {
+    unsigned Pos = SA[I];
+    bool Differs = Prev == Empty;
+    for (unsigned D = 0; !Differs; ++D) {
+      if (S[Pos + D] != S[Prev + D] || IsS[Pos + D] != IsS[Prev + D])
+        Differs = true;
+      else if (D > 0 && (IsLMS(Pos + D) || IsLMS(Prev + D)))
+        break;
+    }
+    if (Differs) {
+      ++Names;
+      Prev = Pos;
+    }
+    // No two LMS suffixes are adjacent, so this doesn't collide.
+    SA[N1 + Pos / 2] = Names - 1;
+  }
+
+  // The names, in the order of their suffixes in S, form the reduced string
+  // at the back of SA. Its suffix array goes at the front.
+  for (unsigned I = N, J = N; I-- > N1;)
+    if (SA[I] != Empty)
+      SA[--J] = SA[I];
+  MutableArrayRef<unsigned> S1 = SA.take_back(N1);
+  MutableArrayRef<unsigned> SA1 = SA.take_front(N1);
+  if (Names < N1)
+    buildSuffixArray(S1, SA1, Names);
+  else
+    for (unsigned I = 0; I != N1; ++I)
+      SA1[S1[I]] = I;
+
+  // Put the LMS suffixes, now sorted, at the ends of their buckets, and
+  // induce the order of the others from them.
+  getBuckets(S, K, /*End=*/true, Buckets);
+  for (unsigned I = 1, J = 0; I != N; ++I)
+    if (IsLMS(I))
+      S1[J++] = I;
+  for (unsigned I = 0; I != N1; ++I)
+    SA1[I] = S1[SA1[I]];
+  std::fill(SA.begin() + N1, SA.end(), Empty);
+  for (unsigned I = N1; I-- != 0;) {
+    unsigned J = SA[I];
+    SA[I] = Empty;
+    SA[--Buckets[S[J]]] = J;
+  }
+  induceSort(S, IsS, SA, K, Buckets);
+}
+
+SuffixArray::SuffixArray(ArrayRef<unsigned> Str) : Str(Str) {
+  unsigned N = Str.size();
+
+  // Renumber the characters densely, from 1, and append the sentinel 0.
+  std::vector<unsigned> S;
+  S.reserve(N + 1);
+  DenseMap<unsigned, unsigned> Names;
+  for (unsigned C : Str)
+    S.push_back(Names.insert({C, Names.size() + 1}).first->second);
+  S.push_back(0);
+
+  std::vector<unsigned> SA(N + 1);
+  buildSuffixArray(S, SA, Names.size() + 1);
+  // The sentinel is the smallest suffix.
+  Suffixes.assign(SA.begin() + 1, SA.end());
+  SA.clear();
+  SA.shrink_to_fit();
+
+  // Kasai et al.: the common prefix of the suffix at I + 1 with the one
+  // before it in the array is at most one shorter than that of the suffix at
+  // I. The sentinel stops the comparisons at the end of the string.
+  std::vector<unsigned> Rank(N);
+  for (unsigned I = 0; I != N; ++I)
+    Rank[Suffixes[I]] = I;
+  LCPs.assign(N, 0);
+  for (unsigned I = 0, H = 0; I != N; ++I) {
+    if (Rank[I] == 0) {
+      H = 0;
+      continue;
+    }
+    unsigned J = Suffixes[Rank[I] - 1];
+    while (S[I + H] == S[J + H])
+      ++H;
+    LCPs[Rank[I]] = H;
+    if (H > 0)
+      --H;
+  }
+}
+
+void SuffixArray::forEachRepeatedSubstring(
+    function_ref<void(const RepeatedSubstring &)> Fn,
+    unsigned MinLength) const {
+  // An LCP interval: the suffixes sharing a prefix of Length elements, whose
+  // neighbours outside the interval share less with them. It is an internal
+  // node of the suffix tree; the suffixes that are in none of its child
+  // intervals are its leaf children.
+  struct Interval {
+    unsigned Length;
+    /// Where the leaf children of the interval start in Leaves.
+    size_t LeavesBegin;
+  };
+
+  // The open intervals, nested, with increasing lengths, and the leaf children
+  // found so far of the ones that are long enough to report.
+  std::vector<Interval> Open;
+  std::vector<unsigned> Leaves;
+  Open.push_back({0, 0});
+
+  RepeatedSubstring RS;
+  unsigned N = Suffixes.size();
+  for (unsigned K = 1; K <= N; ++K) {
+    // The suffix before K is a leaf child of the deepest interval containing
+    // it, which is the longer of its common prefixes with its neighbours.
+    unsigned Leaf = Suffixes[K - 1];
+    unsigned H = K < N ? LCPs[K] : 0;
+
+    if (H > Open.back().Length)
+      Open.push_back({H, Leaves.size()});
+    if (Open.back().Length >= MinLength)
+      Leaves.push_back(Leaf);
+
+    // Close the intervals that don't extend past K - 1.
+    while (Open.back().Length > H) {
+      Interval I = Open.back();
+      Open.pop_back();
+      if (Leaves.size() - I.LeavesBegin >= 2) {
+        RS.Length = I.Length;
+        RS.StartIndices.assign(Leaves.begin() + I.LeavesBegin, Leaves.end());
+        std::sort(RS.StartIndices.begin(), RS.StartIndices.end());
+        Fn(RS);
+      }
+      Leaves.resize(I.LeavesBegin);
+      if (Open.back().Length < H)
+        Open.push_back({H, Leaves.size()});
+    }
+  }
+}
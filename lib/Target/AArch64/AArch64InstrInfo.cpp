@@ -5558,6 +5558,16 @@ void AArch64InstrInfo::fixupPostOutline(MachineBasicBlock &MBB) const {
 void AArch64InstrInfo::buildOutlinedFrame(
     MachineBasicBlock &MBB, MachineFunction &MF,
     const outliner::OutlinedFunction &OF) const {
+  // The outliner only keeps the liveness of functions that a later round may
+  // outline from.
+  bool TracksLiveness = MF.getProperties().hasProperty(
+      MachineFunctionProperties::Property::TracksLiveness);
+
+  // Outlined functions have no locals of their own, so they never use a red
+  // zone. Saying so lets later rounds of outlining outline from them.
+  if (TracksLiveness)
+    MF.getInfo<AArch64FunctionInfo>()->setHasRedZone(false);
+
   // For thunk outlining, rewrite the last instruction from a call to a
   // tail-call.
   if (OF.FrameConstructionID == MachineOutlinerThunk) {
@@ -5569,9 +5579,14 @@ void AArch64InstrInfo::buildOutlinedFrame(
       assert(Call->getOpcode() == AArch64::BLR);
       TailOpcode = AArch64::TCRETURNriALL;
     }
-    MachineInstr *TC = BuildMI(MF, DebugLoc(), get(TailOpcode))
-                            .add(Call->getOperand(0))
-                            .addImm(0);
+    MachineInstrBuilder TC = BuildMI(MF, DebugLoc(), get(TailOpcode))
+                                 .add(Call->getOperand(0))
+                                 .addImm(0);
+    // Keep the arguments of the call live up to the tail-call.
+    if (TracksLiveness)
+      for (const MachineOperand &MO : Call->implicit_operands())
+        if (MO.isReg() && MO.isUse())
+          TC.add(MO);
     MBB.insert(MBB.end(), TC);
     Call->eraseFromParent();
   }
@@ -5638,10 +5653,14 @@ void AArch64InstrInfo::buildOutlinedFrame(
       OF.FrameConstructionID == MachineOutlinerThunk)
     return;
 
-  // It's not a tail call, so we have to insert the return ourselves.
-  MachineInstr *ret = BuildMI(MF, DebugLoc(), get(AArch64::RET))
-                          .addReg(AArch64::LR, RegState::Undef);
+  // It's not a tail call, so we have to insert the return ourselves. LR holds
+  // the return address on entry.
+  MachineInstr *ret =
+      BuildMI(MF, DebugLoc(), get(AArch64::RET))
+          .addReg(AArch64::LR, TracksLiveness ? 0 : RegState::Undef);
   MBB.insert(MBB.end(), ret);
+  if (TracksLiveness && !MBB.isLiveIn(AArch64::LR))
+    MBB.addLiveIn(AArch64::LR);
 
   // Did we have to modify the stack by saving the link register?
   if (OF.FrameConstructionID != MachineOutlinerDefault)
@@ -50,6 +50,7 @@ public:
                              const AArch64RegisterBankInfo &RBI);
 
   bool select(MachineInstr &I, CodeGenCoverage &CoverageInfo) const override;
+  bool selectDuringTranslation(MachineInstr &I) const override;
   static const char *getName() { return DEBUG_TYPE; }
 
 private:
@@ -699,6 +700,81 @@ void AArch64InstructionSelector::materializeLargeCMVal(
   return;
 }
 
+bool AArch64InstructionSelector::selectDuringTranslation(
+    MachineInstr &I) const {
+  MachineBasicBlock &MBB = *I.getParent();
+  MachineFunction &MF = *MBB.getParent();
+  MachineRegisterInfo &MRI = MF.getRegInfo();
+
+  // Only the integer operations on legal scalars are handled: they always end
+  // up on the GPR bank, and their register classes are known up front.
+  const unsigned DefReg = I.getOperand(0).getReg();
+  const LLT Ty = MRI.getType(DefReg);
+  if (!Ty.isScalar() || (Ty.getSizeInBits() != 32 && Ty.getSizeInBits() != 64))
+    return false;
+  const bool Is64Bit = Ty.getSizeInBits() == 64;
+
+  const unsigned LHS = I.getOperand(1).getReg();
+  const unsigned RHS = I.getOperand(2).getReg();
+
+  // Fold a constant RHS into the add and sub immediate forms.
+  unsigned ImmOpc = 0;
+  switch (I.getOpcode()) {
+  case TargetOpcode::G_ADD:
+    ImmOpc = Is64Bit ? AArch64::ADDXri : AArch64::ADDWri;
+    break;
+  case TargetOpcode::G_SUB:
+    ImmOpc = Is64Bit ? AArch64::SUBXri : AArch64::SUBWri;
+    break;
+  }
+  Optional<int64_t> Imm;
+  if (ImmOpc) {
+    Imm = getConstantVRegVal(RHS, MRI);
+    if (Imm && !isUInt<12>(*Imm))
+      Imm = None;
+  }
+
+  MachineInstrBuilder MIB;
+  const DebugLoc &DL = I.getDebugLoc();
+  if (Imm) {
+    MIB = BuildMI(MBB, I, DL, TII.get(ImmOpc), DefReg)
+              .addUse(LHS)
+              .addImm(*Imm)
+              .addImm(0);
+  } else {
+    unsigned Opc;
+    switch (I.getOpcode()) {
+    case TargetOpcode::G_ADD:
+      Opc = Is64Bit ? AArch64::ADDXrr : AArch64::ADDWrr;
+      break;
+    case TargetOpcode::G_SUB:
+      Opc = Is64Bit ? AArch64::SUBXrr : AArch64::SUBWrr;
+      break;
+    case TargetOpcode::G_AND:
+      Opc = Is64Bit ? AArch64::ANDXrr : AArch64::ANDWrr;
+      break;
+    case TargetOpcode::G_OR:
+      Opc = Is64Bit ? AArch64::ORRXrr : AArch64::ORRWrr;
+      break;
+    case TargetOpcode::G_XOR:
+      Opc = Is64Bit ? AArch64::EORXrr : AArch64::EORWrr;
+      break;
+    case TargetOpcode::G_MUL:
+      Opc = Is64Bit ? AArch64::MADDXrrr : AArch64::MADDWrrr;
+      break;
+    default:
+      return false;
+    }
+    MIB = BuildMI(MBB, I, DL, TII.get(Opc), DefReg).addUse(LHS).addUse(RHS);
+    if (I.getOpcode() == TargetOpcode::G_MUL)
+      MIB.addUse(Is64Bit ? AArch64::XZR : AArch64::WZR);
+  }
+
+  constrainSelectedInstRegOperands(*MIB, TII, TRI, RBI);
+  I.eraseFromParent();
+  return true;
+}
+
 bool AArch64InstructionSelector::select(MachineInstr &I,
                                         CodeGenCoverage &CoverageInfo) const {
   assert(I.getParent() && "Instruction should be in a basic block!");
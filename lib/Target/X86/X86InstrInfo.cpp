@@ -5320,7 +5320,9 @@ MachineInstr *X86InstrInfo::foldMemoryOperandImpl(
         return nullptr;
     }
 
-    // Create a constant-pool entry.
+    // Create a constant-pool entry. Types and constants are shared with the
+    // functions compiled on other threads.
+    std::lock_guard<std::mutex> Lock(MF.getMMI().getIRMutex());
     MachineConstantPool &MCP = *MF.getConstantPool();
     Type *Ty;
     unsigned Opc = LoadMI.getOpcode();
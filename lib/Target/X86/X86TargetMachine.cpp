@@ -352,6 +352,10 @@ public:
     return DAG;
   }
 
+  // The X86 machine passes have been audited: the constants that
+  // X86InstrInfo::foldMemoryOperandImpl creates are made under the IR mutex.
+  bool supportsParallelMachinePasses() const override { return true; }
+
   void addIRPasses() override;
   bool addInstSelector() override;
   bool addIRTranslator() override;
@@ -16,9 +16,11 @@
 #include "llvm/Transforms/Utils/SplitModule.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/EquivalenceClasses.h"
+#include "llvm/ADT/SCCIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Analysis/CallGraph.h"
 #include "llvm/IR/Comdat.h"
 #include "llvm/IR/Constant.h"
 #include "llvm/IR/Constants.h"
@@ -36,6 +38,7 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/ValueMapper.h"
@@ -92,18 +95,10 @@ static void addAllGlobalValueUsers(ClusterMapType &GVtoClusterMap,
   }
 }
 
-// Find partitions for module in the way that no locals need to be
-// globalized.
-// Try to balance pack those partitions into N files since this roughly equals
-// thread balancing for the backend codegen step.
-static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
-                           unsigned N) {
-  // At this point module should have the proper mix of globals and locals.
-  // As we attempt to partition this module, we must not change any
-  // locals to globals.
-  LLVM_DEBUG(dbgs() << "Partition module with (" << M->size()
-                    << ")functions\n");
-  ClusterMapType GVtoClusterMap;
+// Group the globals of M that must not be separated into clusters: comdat
+// members, aliases and their aliasees, functions and the users of their block
+// addresses, and locals and their users.
+static void buildClusters(Module *M, ClusterMapType &GVtoClusterMap) {
   ComdatMembersType ComdatMembers;
 
   auto recordGVSet = [&GVtoClusterMap, &ComdatMembers](GlobalValue &GV) {
@@ -148,6 +143,21 @@ static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
   llvm::for_each(M->functions(), recordGVSet);
   llvm::for_each(M->globals(), recordGVSet);
   llvm::for_each(M->aliases(), recordGVSet);
+}
+
+// Find partitions for module in the way that no locals need to be
+// globalized.
+// Try to balance pack those partitions into N files since this roughly equals
+// thread balancing for the backend codegen step.
+static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
+                           unsigned N) {
+  // At this point module should have the proper mix of globals and locals.
+  // As we attempt to partition this module, we must not change any
+  // locals to globals.
+  LLVM_DEBUG(dbgs() << "Partition module with (" << M->size()
+                    << ")functions\n");
+  ClusterMapType GVtoClusterMap;
+  buildClusters(M, GVtoClusterMap);
 
   // Assigned all GVs to merged clusters while balancing number of objects in
   // each.
@@ -213,6 +223,102 @@ static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
   }
 }
 
+// Estimated code generation cost of a single global. Functions are costed by
+// their IR instruction count; everything else is nearly free to emit. With
+// profile data, the cost of a function is scaled by the logarithm of its entry
+// count: profile-guided passes (block placement, tail duplication, alignment)
+// do the most work on hot code, and functions that never run are optimized
+// for size.
+static uint64_t getCodeGenCost(const GlobalValue *GV) {
+  const Function *F = dyn_cast<Function>(GV);
+  if (!F)
+    return 1;
+  uint64_t Cost = 1 + F->getInstructionCount();
+  Function::ProfileCount EntryCount = F->getEntryCount();
+  if (EntryCount.hasValue())
+    Cost *= 1 + Log2_64_Ceil(EntryCount.getCount() + 1);
+  return Cost;
+}
+
+// Assign every defined global of M to one of N partitions so that the
+// partitions have roughly equal estimated code generation cost. Globals that
+// must stay together (see buildClusters) and functions in the same call graph
+// SCC are kept in the same partition.
+static void findCostBalancedPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
+                                       unsigned N) {
+  ClusterMapType GVtoClusterMap;
+  buildClusters(M, GVtoClusterMap);
+
+  // Every definition needs a partition, not only those with constraints.
+  for (GlobalValue &GV : M->global_values()) {
+    if (GV.isDeclaration())
+      continue;
+    GVtoClusterMap.insert(&GV);
+    if (auto *GIS = dyn_cast<GlobalIndirectSymbol>(&GV))
+      if (const GlobalObject *Base = GIS->getBaseObject())
+        GVtoClusterMap.unionSets(&GV, Base);
+  }
+
+  // Keep mutually recursive functions together, so that calls within a
+  // recursion cycle stay local to one object file.
+  CallGraph CG(*M);
+  for (scc_iterator<CallGraph *> I = scc_begin(&CG); !I.isAtEnd(); ++I) {
+    const Function *Leader = nullptr;
+    for (CallGraphNode *Node : *I) {
+      const Function *F = Node->getFunction();
+      if (!F || F->isDeclaration())
+        continue;
+      if (Leader)
+        GVtoClusterMap.unionSets(Leader, F);
+      else
+        Leader = F;
+    }
+  }
+
+  using CostType = std::pair<uint64_t, ClusterMapType::iterator>;
+  SmallVector<CostType, 64> Sets;
+  for (ClusterMapType::iterator I = GVtoClusterMap.begin(),
+                                E = GVtoClusterMap.end();
+       I != E; ++I) {
+    if (!I->isLeader())
+      continue;
+    uint64_t Cost = 0;
+    for (ClusterMapType::member_iterator MI = GVtoClusterMap.member_begin(I);
+         MI != GVtoClusterMap.member_end(); ++MI)
+      Cost += getCodeGenCost(*MI);
+    Sets.push_back(std::make_pair(Cost, I));
+  }
+
+  // Longest-processing-time-first: hand out the most expensive clusters first,
+  // each one to the currently cheapest partition. Ties are broken by name and
+  // partition number to keep the result deterministic.
+  llvm::sort(Sets, [](const CostType &A, const CostType &B) {
+    if (A.first == B.first)
+      return A.second->getData()->getName() < B.second->getData()->getName();
+    return A.first > B.first;
+  });
+
+  using LoadType = std::pair<uint64_t, unsigned>;
+  std::priority_queue<LoadType, std::vector<LoadType>, std::greater<LoadType>>
+      Partitions;
+  for (unsigned I = 0; I < N; ++I)
+    Partitions.push(std::make_pair(0, I));
+
+  for (auto &Set : Sets) {
+    LoadType Partition = Partitions.top();
+    Partitions.pop();
+    LLVM_DEBUG(dbgs() << "Partition[" << Partition.second << "] cost("
+                      << Set.first << ") ----> "
+                      << Set.second->getData()->getName() << "\n");
+    for (ClusterMapType::member_iterator MI = GVtoClusterMap.member_begin(
+             Set.second);
+         MI != GVtoClusterMap.member_end(); ++MI)
+      ClusterIDMap[*MI] = Partition.second;
+    Partition.first += Set.first;
+    Partitions.push(Partition);
+  }
+}
+
 static void externalize(GlobalValue *GV) {
   if (GV->hasLocalLinkage()) {
     GV->setLinkage(GlobalValue::ExternalLinkage);
@@ -250,7 +356,7 @@ static bool isInPartition(const GlobalValue *GV, unsigned I, unsigned N) {
 void llvm::SplitModule(
     std::unique_ptr<Module> M, unsigned N,
     function_ref<void(std::unique_ptr<Module> MPart)> ModuleCallback,
-    bool PreserveLocals) {
+    bool PreserveLocals, bool CostBalanced) {
   if (!PreserveLocals) {
     for (Function &F : *M)
       externalize(&F);
@@ -265,7 +371,10 @@ void llvm::SplitModule(
   // This performs splitting without a need for externalization, which might not
   // always be possible.
   ClusterIDMapType ClusterIDMap;
-  findPartitions(M.get(), ClusterIDMap, N);
+  if (CostBalanced)
+    findCostBalancedPartitions(M.get(), ClusterIDMap, N);
+  else
+    findPartitions(M.get(), ClusterIDMap, N);
 
   // FIXME: We should be able to reuse M as the last partition instead of
   // cloning it.
@@ -0,0 +1,73 @@
+; RUN: llc -mtriple=aarch64-- -O0 -global-isel -global-isel-fused-select \
+; RUN:   -stop-after=irtranslator -verify-machineinstrs %s -o - \
+; RUN:   | FileCheck %s --check-prefix=MIR
+; RUN: llc -mtriple=aarch64-- -O0 -global-isel -global-isel-fused-select \
+; RUN:   -verify-machineinstrs %s -o - | FileCheck %s --check-prefix=ASM
+; RUN: llc -mtriple=aarch64-- -O1 -global-isel -global-isel-fused-select \
+; RUN:   -stop-after=irtranslator %s -o - \
+; RUN:   | FileCheck %s --check-prefix=OPT
+
+; At -O0, the integer operations on legal scalars are selected as soon as
+; they are translated. Add and sub fold a small constant right-hand side.
+
+; MIR-LABEL: name: ops32
+; MIR: [[ADD:%[0-9]+]]:gpr32common(s32) = ADDWrr %0(s32), %1(s32)
+; MIR: [[ADDI:%[0-9]+]]:gpr32common(s32) = ADDWri [[ADD]](s32), 7, 0
+; MIR: [[MUL:%[0-9]+]]:gpr32(s32) = MADDWrrr [[ADDI]](s32), %1(s32), $wzr
+; MIR: [[XOR:%[0-9]+]]:gpr32(s32) = EORWrr [[MUL]](s32), %0(s32)
+; MIR: [[AND:%[0-9]+]]:gpr32(s32) = ANDWrr [[XOR]](s32), %1(s32)
+; MIR: [[OR:%[0-9]+]]:gpr32common(s32) = ORRWrr [[AND]](s32), %{{[0-9]+}}(s32)
+; MIR: {{%[0-9]+}}:gpr32sp(s32) = SUBWri [[OR]](s32), 12, 0
+; MIR-NOT: G_ADD
+; MIR-NOT: G_SUB
+
+; ASM-LABEL: ops32:
+; ASM: add w{{[0-9]+}}, w0, w1
+; ASM: add w{{[0-9]+}}, w{{[0-9]+}}, #7
+; ASM: mul
+; ASM: eor
+; ASM: and
+; ASM: orr
+; ASM: sub w0, w{{[0-9]+}}, #12
+
+; OPT-LABEL: name: ops32
+; OPT: G_ADD
+; OPT-NOT: ADDWrr
+define i32 @ops32(i32 %a, i32 %b) {
+  %x = add i32 %a, %b
+  %y = add i32 %x, 7
+  %m = mul i32 %y, %b
+  %o = xor i32 %m, %a
+  %p = and i32 %o, %b
+  %q = or i32 %p, 4096
+  %r = sub i32 %q, 12
+  ret i32 %r
+}
+
+; The immediate does not fit in 12 bits, so the register form is used.
+; MIR-LABEL: name: ops64
+; MIR: [[MUL:%[0-9]+]]:gpr64(s64) = MADDXrrr %0(s64), %1(s64), $xzr
+; MIR: [[SUB:%[0-9]+]]:gpr64(s64) = SUBXrr [[MUL]](s64), %0(s64)
+; MIR: {{%[0-9]+}}:gpr64(s64) = ADDXrr [[SUB]](s64), %{{[0-9]+}}(s64)
+
+; ASM-LABEL: ops64:
+; ASM: mul x{{[0-9]+}}, x0, x1
+; ASM: sub x{{[0-9]+}}, x{{[0-9]+}}, x0
+; ASM: add x0, x{{[0-9]+}}, x{{[0-9]+}}
+define i64 @ops64(i64 %a, i64 %b) {
+  %x = mul i64 %a, %b
+  %y = sub i64 %x, %a
+  %z = add i64 %y, 4096
+  ret i64 %z
+}
+
+; Types that still need legalizing are left to the rest of the pipeline.
+; MIR-LABEL: name: narrow
+; MIR: G_ADD %{{[0-9]+}}, %{{[0-9]+}}
+
+; ASM-LABEL: narrow:
+; ASM: add w0, w0, w1
+define i8 @narrow(i8 %a, i8 %b) {
+  %x = add i8 %a, %b
+  ret i8 %x
+}
@@ -0,0 +1,22 @@
+; RUN: llc -mtriple=aarch64-- -O0 -global-isel -stats %s -o - 2>&1 \
+; RUN:   | FileCheck %s
+; REQUIRES: asserts
+
+; Only the function whose generic instructions are all legal as translated
+; skips the legalizer worklists; the second one needs its i8 add widened.
+
+; CHECK-LABEL: legal:
+; CHECK: add x0, x0, x1
+; CHECK-LABEL: narrow:
+; CHECK: add w{{[0-9]+}}, w{{[0-9]+}}, w{{[0-9]+}}
+; CHECK: 1 legalizer - Number of functions found legal without the worklists
+
+define i64 @legal(i64 %a, i64 %b) {
+  %r = add i64 %a, %b
+  ret i64 %r
+}
+
+define i8 @narrow(i8 %a, i8 %b) {
+  %r = add i8 %a, %b
+  ret i8 %r
+}
@@ -0,0 +1,21 @@
+; Targets whose machine passes have not been audited for running on several
+; functions at once ignore -machine-function-threads.
+; RUN: llc -mtriple=aarch64-unknown-linux-gnu -machine-function-threads=4 \
+; RUN:   -filetype=obj -debug-pass=Structure < %s -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s
+
+; CHECK-NOT: Parallel Machine Passes
+; CHECK: AArch64 Instruction Selection
+; CHECK-NOT: Parallel Machine Passes
+; CHECK: Greedy Register Allocator
+; CHECK-NOT: Parallel Machine Passes
+
+define i32 @f(i32 %x) {
+  %y = add i32 %x, 1
+  ret i32 %y
+}
+
+define i32 @g(i32 %x) {
+  %y = call i32 @f(i32 %x)
+  ret i32 %y
+}
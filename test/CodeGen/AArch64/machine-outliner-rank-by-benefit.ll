@@ -0,0 +1,74 @@
+; RUN: llc %s -verify-machineinstrs -enable-machine-outliner \
+; RUN:   -mtriple=aarch64-unknown-unknown -o - | FileCheck %s -check-prefix=PAIRWISE
+; RUN: llc %s -verify-machineinstrs -enable-machine-outliner \
+; RUN:   -mtriple=aarch64-unknown-unknown -outliner-rank-by-benefit -o - \
+; RUN:   | FileCheck %s -check-prefix=RANKED
+
+; The stores of @f0 and @f2 are outlined either way. The last two stores and the
+; return of @f1 and @f3 are candidates too, but pairwise pruning gives them up
+; for overlapping candidates with more occurrences, which then no longer pay
+; off. Ranking the functions by benefit keeps them.
+
+; PAIRWISE-LABEL: f0:
+; PAIRWISE: b OUTLINED_FUNCTION_0
+; PAIRWISE-LABEL: f1:
+; PAIRWISE-NOT: OUTLINED_FUNCTION
+; PAIRWISE: ret
+; PAIRWISE-LABEL: f2:
+; PAIRWISE: b OUTLINED_FUNCTION_0
+; PAIRWISE-LABEL: f3:
+; PAIRWISE-NOT: OUTLINED_FUNCTION
+; PAIRWISE: ret
+; PAIRWISE-NOT: OUTLINED_FUNCTION_1:
+
+; RANKED-LABEL: f0:
+; RANKED: b OUTLINED_FUNCTION_[[STORES:[0-9]+]]
+; RANKED-LABEL: f1:
+; RANKED: str w9, [x0]
+; RANKED-NEXT: str w9, [x0]
+; RANKED-NEXT: b OUTLINED_FUNCTION_[[TAIL:[0-9]+]]
+; RANKED-LABEL: f2:
+; RANKED: b OUTLINED_FUNCTION_[[STORES]]
+; RANKED-LABEL: f3:
+; RANKED: b OUTLINED_FUNCTION_[[TAIL]]
+; RANKED: OUTLINED_FUNCTION_[[TAIL]]:
+; RANKED: str w8, [x0]
+; RANKED-NEXT: str w8, [x0]
+; RANKED-NEXT: ret
+
+define void @f0(i32* %p) #0 {
+  store volatile i32 5, i32* %p, align 4
+  store volatile i32 1, i32* %p, align 4
+  store volatile i32 4, i32* %p, align 4
+  store volatile i32 3, i32* %p, align 4
+  ret void
+}
+
+define void @f1(i32* %p) #0 {
+  store volatile i32 5, i32* %p, align 4
+  store volatile i32 1, i32* %p, align 4
+  store volatile i32 4, i32* %p, align 4
+  store volatile i32 3, i32* %p, align 4
+  store volatile i32 3, i32* %p, align 4
+  store volatile i32 4, i32* %p, align 4
+  store volatile i32 4, i32* %p, align 4
+  ret void
+}
+
+define void @f2(i32* %p) #0 {
+  store volatile i32 5, i32* %p, align 4
+  store volatile i32 1, i32* %p, align 4
+  store volatile i32 4, i32* %p, align 4
+  store volatile i32 3, i32* %p, align 4
+  ret void
+}
+
+define void @f3(i32* %p) #0 {
+  store volatile i32 4, i32* %p, align 4
+  store volatile i32 4, i32* %p, align 4
+  store volatile i32 3, i32* %p, align 4
+  store volatile i32 3, i32* %p, align 4
+  ret void
+}
+
+attributes #0 = { noredzone nounwind ssp uwtable "no-frame-pointer-elim"="false" "target-cpu"="cyclone" }
@@ -0,0 +1,134 @@
+; RUN: llc %s -verify-machineinstrs -enable-machine-outliner \
+; RUN:   -mtriple=aarch64-unknown-unknown -outliner-rounds=3 -o - | FileCheck %s
+; RUN: llc %s -verify-machineinstrs -enable-machine-outliner \
+; RUN:   -mtriple=aarch64-unknown-unknown -o - \
+; RUN:   | FileCheck %s -check-prefix=ONE-ROUND
+
+; The first round outlines the stores of the a and b functions into two
+; functions, which share their first six stores and their epilogue. The second
+; round outlines those from the functions of the first round. The functions it
+; creates are named after the round.
+
+; The first round's functions end in a return, so LR is live across the call of
+; the second round's function and is saved in a register. The functions
+; return %x, so that register is not x0.
+
+; CHECK-LABEL: a1:
+; CHECK: b OUTLINED_FUNCTION_1
+; CHECK-LABEL: b1:
+; CHECK: b OUTLINED_FUNCTION_0
+
+; CHECK-LABEL: OUTLINED_FUNCTION_0:
+; CHECK-NOT: x0
+; CHECK: mov x[[REG:[1-9][0-9]*]], x30
+; CHECK-NEXT: bl OUTLINED_FUNCTION_2_[[PREFIX:[0-9]+]]
+; CHECK-NEXT: mov x30, x[[REG]]
+; CHECK: b OUTLINED_FUNCTION_2_[[EPILOGUE:[0-9]+]]
+
+; CHECK-LABEL: OUTLINED_FUNCTION_1:
+; CHECK: mov x[[REG:[1-9][0-9]*]], x30
+; CHECK-NEXT: bl OUTLINED_FUNCTION_2_[[PREFIX]]
+; CHECK-NEXT: mov x30, x[[REG]]
+; CHECK: b OUTLINED_FUNCTION_2_[[EPILOGUE]]
+
+; CHECK: OUTLINED_FUNCTION_2_[[EPILOGUE]]:
+; CHECK: str w8, [sp, #12]
+; CHECK-NEXT: add sp, sp, #48
+; CHECK-NEXT: ret
+
+; CHECK: OUTLINED_FUNCTION_2_[[PREFIX]]:
+; CHECK: str w8, [sp, #44]
+; CHECK: str w8, [sp, #24]
+; CHECK-NEXT: ret
+
+; ONE-ROUND-NOT: OUTLINED_FUNCTION_2_
+
+define i32 @a1(i32 %x) #0 {
+  %p1 = alloca i32, align 4
+  %p2 = alloca i32, align 4
+  %p3 = alloca i32, align 4
+  %p4 = alloca i32, align 4
+  %p5 = alloca i32, align 4
+  %p6 = alloca i32, align 4
+  %p7 = alloca i32, align 4
+  %p8 = alloca i32, align 4
+  %p9 = alloca i32, align 4
+  store volatile i32 1, i32* %p1, align 4
+  store volatile i32 2, i32* %p2, align 4
+  store volatile i32 3, i32* %p3, align 4
+  store volatile i32 4, i32* %p4, align 4
+  store volatile i32 5, i32* %p5, align 4
+  store volatile i32 6, i32* %p6, align 4
+  store volatile i32 7, i32* %p7, align 4
+  store volatile i32 8, i32* %p8, align 4
+  store volatile i32 9, i32* %p9, align 4
+  ret i32 %x
+}
+
+define i32 @a2(i32 %x) #0 {
+  %p1 = alloca i32, align 4
+  %p2 = alloca i32, align 4
+  %p3 = alloca i32, align 4
+  %p4 = alloca i32, align 4
+  %p5 = alloca i32, align 4
+  %p6 = alloca i32, align 4
+  %p7 = alloca i32, align 4
+  %p8 = alloca i32, align 4
+  %p9 = alloca i32, align 4
+  store volatile i32 1, i32* %p1, align 4
+  store volatile i32 2, i32* %p2, align 4
+  store volatile i32 3, i32* %p3, align 4
+  store volatile i32 4, i32* %p4, align 4
+  store volatile i32 5, i32* %p5, align 4
+  store volatile i32 6, i32* %p6, align 4
+  store volatile i32 7, i32* %p7, align 4
+  store volatile i32 8, i32* %p8, align 4
+  store volatile i32 9, i32* %p9, align 4
+  ret i32 %x
+}
+
+define i32 @b1(i32 %x) #0 {
+  %p1 = alloca i32, align 4
+  %p2 = alloca i32, align 4
+  %p3 = alloca i32, align 4
+  %p4 = alloca i32, align 4
+  %p5 = alloca i32, align 4
+  %p6 = alloca i32, align 4
+  %p7 = alloca i32, align 4
+  %p8 = alloca i32, align 4
+  %p9 = alloca i32, align 4
+  store volatile i32 1, i32* %p1, align 4
+  store volatile i32 2, i32* %p2, align 4
+  store volatile i32 3, i32* %p3, align 4
+  store volatile i32 4, i32* %p4, align 4
+  store volatile i32 5, i32* %p5, align 4
+  store volatile i32 6, i32* %p6, align 4
+  store volatile i32 10, i32* %p7, align 4
+  store volatile i32 11, i32* %p8, align 4
+  store volatile i32 12, i32* %p9, align 4
+  ret i32 %x
+}
+
+define i32 @b2(i32 %x) #0 {
+  %p1 = alloca i32, align 4
+  %p2 = alloca i32, align 4
+  %p3 = alloca i32, align 4
+  %p4 = alloca i32, align 4
+  %p5 = alloca i32, align 4
+  %p6 = alloca i32, align 4
+  %p7 = alloca i32, align 4
+  %p8 = alloca i32, align 4
+  %p9 = alloca i32, align 4
+  store volatile i32 1, i32* %p1, align 4
+  store volatile i32 2, i32* %p2, align 4
+  store volatile i32 3, i32* %p3, align 4
+  store volatile i32 4, i32* %p4, align 4
+  store volatile i32 5, i32* %p5, align 4
+  store volatile i32 6, i32* %p6, align 4
+  store volatile i32 10, i32* %p7, align 4
+  store volatile i32 11, i32* %p8, align 4
+  store volatile i32 12, i32* %p9, align 4
+  ret i32 %x
+}
+
+attributes #0 = { noredzone nounwind ssp uwtable "no-frame-pointer-elim"="false" "target-cpu"="cyclone" }
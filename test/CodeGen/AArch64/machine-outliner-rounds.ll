@@ -0,0 +1,53 @@
+; RUN: llc %s -enable-machine-outliner -mtriple=aarch64-unknown-unknown \
+; RUN:   -outliner-rounds=3 -pass-remarks=machine-outliner -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s
+; RUN: llc %s -enable-machine-outliner -mtriple=aarch64-unknown-unknown \
+; RUN:   -outliner-rounds=3 -outliner-rank-by-benefit \
+; RUN:   -pass-remarks=machine-outliner -o /dev/null 2>&1 | FileCheck %s
+; RUN: llc %s -enable-machine-outliner -mtriple=aarch64-unknown-unknown \
+; RUN:   -pass-remarks=machine-outliner -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s -check-prefix=ONE-ROUND
+
+; Each round that outlines something says how many bytes it saved. The second
+; round finds nothing left to outline, so the outliner stops there.
+; CHECK: remark: <unknown>:0:0: Saved 48 bytes by outlining 14 instructions
+; CHECK: remark: <unknown>:0:0: Round 1 saved 48 bytes by outlining 2
+; CHECK-SAME: sequences into 1 functions
+; CHECK-NOT: Round 2
+
+; ONE-ROUND: Saved 48 bytes by outlining 14 instructions
+; ONE-ROUND-NOT: Round 1 saved
+
+define void @foo() #0 {
+  %1 = alloca i32, align 4
+  %2 = alloca i32, align 4
+  %3 = alloca i32, align 4
+  %4 = alloca i32, align 4
+  %5 = alloca i32, align 4
+  %6 = alloca i32, align 4
+  store i32 1, i32* %1, align 4
+  store i32 2, i32* %2, align 4
+  store i32 3, i32* %3, align 4
+  store i32 4, i32* %4, align 4
+  store i32 5, i32* %5, align 4
+  store i32 6, i32* %6, align 4
+  ret void
+}
+
+define void @bar() #0 {
+  %1 = alloca i32, align 4
+  %2 = alloca i32, align 4
+  %3 = alloca i32, align 4
+  %4 = alloca i32, align 4
+  %5 = alloca i32, align 4
+  %6 = alloca i32, align 4
+  store i32 1, i32* %1, align 4
+  store i32 2, i32* %2, align 4
+  store i32 3, i32* %3, align 4
+  store i32 4, i32* %4, align 4
+  store i32 5, i32* %5, align 4
+  store i32 6, i32* %6, align 4
+  ret void
+}
+
+attributes #0 = { noredzone nounwind ssp uwtable "no-frame-pointer-elim"="false" "target-cpu"="cyclone" }
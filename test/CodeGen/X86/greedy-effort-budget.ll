@@ -0,0 +1,60 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -verify-machineinstrs \
+; RUN:   -regalloc-effort-budget=1 -pass-remarks-analysis=regalloc \
+; RUN:   -o /dev/null 2>&1 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -verify-machineinstrs \
+; RUN:   -pass-remarks-analysis=regalloc -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s --allow-empty --check-prefix=UNLIMITED
+
+; More values are live across the calls than there are callee-saved
+; registers, so the allocator evicts and splits. With a budget of one unit of
+; work per virtual register it runs out and finishes with cheaper strategies,
+; which must still produce valid code.
+
+; CHECK: remark: <unknown>:0:0: effort budget of {{[0-9]+}} exceeded; using cheaper allocation strategies
+; CHECK-NOT: effort budget
+
+; UNLIMITED-NOT: effort budget
+
+declare void @use(i64)
+
+define i64 @pressure(i64* %p, i64 %n) {
+entry:
+  %p1 = getelementptr i64, i64* %p, i64 1
+  %p2 = getelementptr i64, i64* %p, i64 2
+  %p3 = getelementptr i64, i64* %p, i64 3
+  %p4 = getelementptr i64, i64* %p, i64 4
+  %p5 = getelementptr i64, i64* %p, i64 5
+  %p6 = getelementptr i64, i64* %p, i64 6
+  %p7 = getelementptr i64, i64* %p, i64 7
+  %v0 = load i64, i64* %p
+  %v1 = load i64, i64* %p1
+  %v2 = load i64, i64* %p2
+  %v3 = load i64, i64* %p3
+  %v4 = load i64, i64* %p4
+  %v5 = load i64, i64* %p5
+  %v6 = load i64, i64* %p6
+  %v7 = load i64, i64* %p7
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = phi i64 [ 0, %entry ], [ %acc.next, %loop ]
+  call void @use(i64 %i)
+  %s0 = mul i64 %v0, %v1
+  %s1 = mul i64 %v2, %v3
+  %s2 = mul i64 %v4, %v5
+  %s3 = mul i64 %v6, %v7
+  call void @use(i64 %s0)
+  %t0 = add i64 %s0, %s1
+  %t1 = add i64 %s2, %s3
+  %t2 = xor i64 %t0, %t1
+  %acc.next = add i64 %acc, %t2
+  %i.next = add i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %r0 = add i64 %acc.next, %v0
+  %r1 = add i64 %r0, %v7
+  ret i64 %r1
+}
@@ -0,0 +1,94 @@
+; Computing the live intervals of virtual registers on several threads must not
+; change the output.
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -verify-machineinstrs < %s \
+; RUN:   -o %t.s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -verify-machineinstrs < %s \
+; RUN:   -live-interval-threads=4 -o %t.threads.s
+; RUN: diff %t.s %t.threads.s
+
+declare void @use(i64)
+
+define i64 @loops(i64* %p, i64 %n, i64 %m) {
+entry:
+  br label %outer
+
+outer:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %outer.latch ]
+  %acc = phi i64 [ 0, %entry ], [ %acc.inner, %outer.latch ]
+  br label %inner
+
+inner:
+  %j = phi i64 [ 0, %outer ], [ %j.next, %inner.latch ]
+  %acc.in = phi i64 [ %acc, %outer ], [ %acc.inner, %inner.latch ]
+  %k = add i64 %i, %j
+  %a = getelementptr i64, i64* %p, i64 %k
+  %v = load i64, i64* %a
+  %odd = and i64 %v, 1
+  %c = icmp eq i64 %odd, 0
+  br i1 %c, label %even, label %inner.latch
+
+even:
+  %h = lshr i64 %v, 1
+  %x = mul i64 %h, %acc.in
+  store i64 %x, i64* %a
+  call void @use(i64 %x)
+  br label %inner.latch
+
+inner.latch:
+  %w = phi i64 [ %v, %inner ], [ %x, %even ]
+  %acc.inner = add i64 %acc.in, %w
+  %j.next = add i64 %j, 1
+  %inner.done = icmp eq i64 %j.next, %m
+  br i1 %inner.done, label %outer.latch, label %inner
+
+outer.latch:
+  %i.next = add i64 %i, 1
+  %outer.done = icmp eq i64 %i.next, %n
+  br i1 %outer.done, label %exit, label %outer
+
+exit:
+  ret i64 %acc.inner
+}
+
+; More values live across the calls than there are callee-saved registers.
+define i64 @pressure(i64* %p) {
+  %p1 = getelementptr i64, i64* %p, i64 1
+  %p2 = getelementptr i64, i64* %p, i64 2
+  %p3 = getelementptr i64, i64* %p, i64 3
+  %p4 = getelementptr i64, i64* %p, i64 4
+  %p5 = getelementptr i64, i64* %p, i64 5
+  %p6 = getelementptr i64, i64* %p, i64 6
+  %p7 = getelementptr i64, i64* %p, i64 7
+  %v0 = load i64, i64* %p
+  %v1 = load i64, i64* %p1
+  %v2 = load i64, i64* %p2
+  %v3 = load i64, i64* %p3
+  %v4 = load i64, i64* %p4
+  %v5 = load i64, i64* %p5
+  %v6 = load i64, i64* %p6
+  %v7 = load i64, i64* %p7
+  call void @use(i64 %v0)
+  %s0 = mul i64 %v0, %v1
+  %s1 = mul i64 %v2, %v3
+  %s2 = mul i64 %v4, %v5
+  %s3 = mul i64 %v6, %v7
+  call void @use(i64 %s0)
+  %t0 = add i64 %s0, %s1
+  %t1 = add i64 %s2, %s3
+  %r = xor i64 %t0, %t1
+  ret i64 %r
+}
+
+; Sub-register defs and uses, and a value that is defined but never used.
+define i32 @subregs(i64 %x, i16 %y) {
+  %lo = trunc i64 %x to i32
+  %b = trunc i64 %x to i8
+  %z = zext i8 %b to i32
+  %s = sext i16 %y to i32
+  %dead = mul i32 %lo, %s
+  %r = add i32 %z, %s
+  %q = udiv i64 %x, 7
+  %qt = trunc i64 %q to i32
+  %t = xor i32 %r, %qt
+  ret i32 %t
+}
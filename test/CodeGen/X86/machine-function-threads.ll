@@ -0,0 +1,177 @@
+; Compiling the machine functions on several threads must not change the
+; output.
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -filetype=obj < %s -o %t.o
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -filetype=obj \
+; RUN:   -machine-function-threads=4 < %s -o %t.threads.o
+; RUN: cmp %t.o %t.threads.o
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu < %s -o %t.s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -machine-function-threads=4 \
+; RUN:   < %s -o %t.threads.s
+; RUN: diff %t.s %t.threads.s
+
+; The machine passes are replaced by a pass that runs them in pass managers of
+; its own, built after the one of the main thread. Temporary labels would be
+; numbered in a different order (see @xray_tail_call), so this is not done
+; when their names are printed.
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -machine-function-threads=4 \
+; RUN:   -filetype=obj -debug-pass=Structure < %s -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -machine-function-threads=4 \
+; RUN:   -debug-pass=Structure < %s -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=ASM
+
+; CHECK: X86 DAG->DAG Instruction Selection
+; CHECK-NOT: Greedy Register Allocator
+; CHECK: Parallel Machine Passes
+; CHECK-NOT: Greedy Register Allocator
+; CHECK: X86 Assembly Printer
+; CHECK: Greedy Register Allocator
+
+; ASM-NOT: Parallel Machine Passes
+
+declare void @use(i8*)
+declare void @may_throw()
+declare i32 @__gxx_personality_v0(...)
+declare void @llvm.lifetime.start.p0i8(i64, i8* nocapture)
+declare void @llvm.lifetime.end.p0i8(i64, i8* nocapture)
+
+define i32 @switch_table(i32 %x) {
+entry:
+  switch i32 %x, label %default [
+    i32 0, label %bb0
+    i32 1, label %bb1
+    i32 2, label %bb2
+    i32 3, label %bb3
+    i32 4, label %bb4
+    i32 5, label %bb5
+  ]
+bb0:
+  br label %exit
+bb1:
+  br label %exit
+bb2:
+  br label %exit
+bb3:
+  br label %exit
+bb4:
+  br label %exit
+bb5:
+  br label %exit
+default:
+  br label %exit
+exit:
+  %r = phi i32 [ 7, %bb0 ], [ 11, %bb1 ], [ 13, %bb2 ], [ 17, %bb3 ],
+               [ 19, %bb4 ], [ 23, %bb5 ], [ 0, %default ]
+  ret i32 %r
+}
+
+; Disjoint lifetimes of allocas of different types, merged by stack coloring.
+define void @stack_slots(i1 %c) {
+entry:
+  %a = alloca [64 x i32]
+  %b = alloca [32 x i64]
+  %a8 = bitcast [64 x i32]* %a to i8*
+  %b8 = bitcast [32 x i64]* %b to i8*
+  call void @llvm.lifetime.start.p0i8(i64 256, i8* %a8)
+  call void @use(i8* %a8)
+  call void @llvm.lifetime.end.p0i8(i64 256, i8* %a8)
+  call void @llvm.lifetime.start.p0i8(i64 256, i8* %b8)
+  call void @use(i8* %b8)
+  call void @llvm.lifetime.end.p0i8(i64 256, i8* %b8)
+  ret void
+}
+
+define double @float_loop(double* %p, i64 %n) {
+entry:
+  br label %loop
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = phi double [ 0.0, %entry ], [ %acc.next, %loop ]
+  %addr = getelementptr double, double* %p, i64 %i
+  %v = load double, double* %addr
+  %m = fmul double %v, 1.5
+  %acc.next = fadd double %acc, %m
+  %i.next = add i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+exit:
+  ret double %acc.next
+}
+
+; Enough live values to spill around the call.
+define i64 @pressure(i64* %p) {
+  %p1 = getelementptr i64, i64* %p, i64 1
+  %p2 = getelementptr i64, i64* %p, i64 2
+  %p3 = getelementptr i64, i64* %p, i64 3
+  %p4 = getelementptr i64, i64* %p, i64 4
+  %p5 = getelementptr i64, i64* %p, i64 5
+  %p6 = getelementptr i64, i64* %p, i64 6
+  %p7 = getelementptr i64, i64* %p, i64 7
+  %v0 = load i64, i64* %p
+  %v1 = load i64, i64* %p1
+  %v2 = load i64, i64* %p2
+  %v3 = load i64, i64* %p3
+  %v4 = load i64, i64* %p4
+  %v5 = load i64, i64* %p5
+  %v6 = load i64, i64* %p6
+  %v7 = load i64, i64* %p7
+  %q = bitcast i64* %p to i8*
+  call void @use(i8* %q)
+  %s0 = mul i64 %v0, %v1
+  %s1 = mul i64 %v2, %v3
+  %s2 = mul i64 %v4, %v5
+  %s3 = mul i64 %v6, %v7
+  %t0 = add i64 %s0, %s1
+  %t1 = add i64 %s2, %s3
+  %r = xor i64 %t0, %t1
+  ret i64 %r
+}
+
+define <4 x i32> @vectors(<4 x i32> %a, <4 x i32> %b) {
+  %s = add <4 x i32> %a, %b
+  %m = mul <4 x i32> %s, <i32 1, i32 2, i32 3, i32 4>
+  %c = icmp sgt <4 x i32> %m, zeroinitializer
+  %r = select <4 x i1> %c, <4 x i32> %m, <4 x i32> <i32 -1, i32 -1, i32 -1, i32 -1>
+  ret <4 x i32> %r
+}
+
+define i32 @recursive(i32 %n) {
+  %base = icmp slt i32 %n, 2
+  br i1 %base, label %done, label %rec
+rec:
+  %n1 = sub i32 %n, 1
+  %n2 = sub i32 %n, 2
+  %f1 = call i32 @recursive(i32 %n1)
+  %f2 = call i32 @recursive(i32 %n2)
+  %f = add i32 %f1, %f2
+  ret i32 %f
+done:
+  ret i32 %n
+}
+
+define available_externally i32 @external(i32 %x) {
+  ret i32 %x
+}
+
+define i32 @calls_external(i32 %x) {
+  %r = call i32 @external(i32 %x)
+  %s = call i32 @switch_table(i32 %r)
+  ret i32 %s
+}
+
+; The AsmPrinter creates a temporary label for the sled of the tail call, after
+; instruction selection created those of the invoke below when the machine
+; passes run in parallel.
+define void @xray_tail_call() "function-instrument"="xray-always" {
+  tail call void @may_throw()
+  ret void
+}
+
+define void @invoke() personality i32 (...)* @__gxx_personality_v0 {
+  invoke void @may_throw() to label %ok unwind label %lp
+ok:
+  ret void
+lp:
+  %l = landingpad { i8*, i32 } cleanup
+  resume { i8*, i32 } %l
+}
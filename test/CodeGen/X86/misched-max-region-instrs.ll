@@ -0,0 +1,28 @@
+; RUN: llc < %s -mtriple=x86_64-apple-macosx -mattr=+sse2 -enable-misched \
+; RUN:   -misched=ilpmin | FileCheck -check-prefix=SCHED %s
+; RUN: llc < %s -mtriple=x86_64-apple-macosx -mattr=+sse2 -enable-misched \
+; RUN:   -misched=ilpmin -misched-max-region-instrs=4 \
+; RUN:   | FileCheck -check-prefix=SOURCE %s
+;
+; A region larger than -misched-max-region-instrs keeps its source order.
+;
+; SCHED: addss
+; SCHED: addss
+; SCHED: subss
+; SCHED: addss
+; SCHED: addss
+;
+; SOURCE: addss
+; SOURCE: addss
+; SOURCE: addss
+; SOURCE: subss
+; SOURCE: addss
+define float @ilpsched(float %a, float %b, float %c, float %d, float %e, float %f) nounwind uwtable readnone ssp {
+entry:
+  %add = fadd float %a, %b
+  %add1 = fadd float %c, %d
+  %add2 = fadd float %e, %f
+  %add3 = fsub float %add1, %add2
+  %add4 = fadd float %add, %add3
+  ret float %add4
+}
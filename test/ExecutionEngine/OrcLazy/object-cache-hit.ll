@@ -0,0 +1,25 @@
+; REQUIRES: asserts
+; RUN: rm -rf %t.cache
+; RUN: lli -jit-kind=orc-lazy -enable-cache-manager -object-cache-dir=%t.cache \
+; RUN:   -debug-only=orc %s 2>&1 | FileCheck --check-prefix=MISS %s
+;
+; The second run loads every object from the cache and compiles nothing.
+; RUN: lli -jit-kind=orc-lazy -enable-cache-manager -object-cache-dir=%t.cache \
+; RUN:   -debug-only=orc %s 2>&1 | FileCheck --check-prefix=HIT %s
+
+; MISS: Object cache miss for
+; MISS-NOT: Object cache hit for
+
+; HIT: Object cache hit for
+; HIT-NOT: Object cache miss for
+
+define i32 @foo() {
+entry:
+  ret i32 0
+}
+
+define i32 @main(i32 %argc, i8** nocapture readnone %argv) {
+entry:
+  %0 = call i32() @foo()
+  ret i32 %0
+}
@@ -0,0 +1,28 @@
+; RUN: rm -rf %t.cache
+; RUN: lli -jit-kind=orc-lazy -enable-cache-manager -object-cache-dir=%t.cache \
+; RUN:   %s
+; RUN: ls %t.cache | FileCheck %s
+; RUN: ls %t.cache > %t.entries
+;
+; A second run is served from the cache: no new entries are created.
+; RUN: lli -jit-kind=orc-lazy -enable-cache-manager -object-cache-dir=%t.cache \
+; RUN:   %s
+; RUN: ls %t.cache | diff %t.entries -
+;
+; Check that cached objects are keyed on the target configuration.
+; RUN: lli -jit-kind=orc-lazy -enable-cache-manager -object-cache-dir=%t.cache \
+; RUN:   -relocation-model=pic %s
+; RUN: ls %t.cache | not diff %t.entries -
+
+; CHECK: llvmcache-
+
+define i32 @foo() {
+entry:
+  ret i32 0
+}
+
+define i32 @main(i32 %argc, i8** nocapture readnone %argv) {
+entry:
+  %0 = call i32() @foo()
+  ret i32 %0
+}
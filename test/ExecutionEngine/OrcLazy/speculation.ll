@@ -0,0 +1,46 @@
+; RUN: lli -jit-kind=orc-lazy -orc-lazy-debug=funcs-to-stdout %s \
+; RUN:   | FileCheck --check-prefix=CHECK-NOSPEC %s
+; RUN: lli -jit-kind=orc-lazy -speculation-limit=4 -compile-threads=2 \
+; RUN:   -orc-lazy-debug=funcs-to-stdout %s | FileCheck --check-prefix=CHECK-SPEC %s
+; RUN: not lli -jit-kind=orc-lazy -speculation-limit=4 %s 2>&1 \
+; RUN:   | FileCheck --check-prefix=CHECK-NOTHREADS %s
+;
+; Checks that callees of a compiled function are compiled speculatively on the
+; compile threads even if they are never called, unless their profile entry
+; count is zero. Without compile threads speculation would only delay the
+; program, so it is rejected.
+;
+; CHECK-NOTHREADS: -speculation-limit requires -compile-threads
+;
+; CHECK-NOSPEC: [ main ]
+; CHECK-NOSPEC-NOT: foo
+;
+; CHECK-SPEC: [ main ]
+; CHECK-SPEC: [ foo ]
+; CHECK-SPEC-NOT: cold
+
+define void @foo() {
+entry:
+  ret void
+}
+
+define void @cold() !prof !0 {
+entry:
+  ret void
+}
+
+define i32 @main(i32 %argc, i8** nocapture readnone %argv) {
+entry:
+  %cmp = icmp sgt i32 %argc, 100
+  br i1 %cmp, label %if.then, label %if.end
+
+if.then:
+  call void @foo()
+  call void @cold()
+  br label %if.end
+
+if.end:
+  ret i32 0
+}
+
+!0 = !{!"function_entry_count", i64 0}
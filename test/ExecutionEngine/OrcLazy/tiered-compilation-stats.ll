@@ -0,0 +1,35 @@
+; REQUIRES: asserts
+; RUN: lli -jit-kind=orc-lazy -compile-threads=2 -tier-up-threshold=5 -stats \
+; RUN:   %s 2>&1 | FileCheck %s
+; RUN: lli -jit-kind=orc-lazy -compile-threads=2 -tier-up-threshold=5000 \
+; RUN:   -stats %s 2>&1 | FileCheck --check-prefix=CHECK-COLD %s
+;
+; Checks that a function called more often than the threshold is recompiled
+; and its stub redirected to the optimized body, and that one called less
+; often is not.
+;
+; CHECK: 1 orc - Number of functions redirected to their optimized body
+; CHECK-COLD-NOT: Number of functions redirected to their optimized body
+
+define i32 @inc(i32 %x) {
+entry:
+  %r = add i32 %x, 1
+  ret i32 %r
+}
+
+define i32 @main(i32 %argc, i8** nocapture readnone %argv) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = phi i32 [ 0, %entry ], [ %acc.next, %loop ]
+  %acc.next = call i32 @inc(i32 %acc)
+  %i.next = add i32 %i, 1
+  %done = icmp eq i32 %i.next, 1000
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %ret = sub i32 %acc.next, 1000
+  ret i32 %ret
+}
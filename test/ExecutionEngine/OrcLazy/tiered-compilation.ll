@@ -0,0 +1,38 @@
+; RUN: lli -jit-kind=orc-lazy -compile-threads=2 -tier-up-threshold=5 %s
+; RUN: not lli -jit-kind=orc-lazy -tier-up-threshold=5 %s 2>&1 \
+; RUN:   | FileCheck --check-prefix=CHECK-NOTHREADS %s
+;
+; Checks that instrumented tier-0 code, and the switch to the optimized body
+; part-way through the loop, do not change the program's result.
+;
+; CHECK-NOTHREADS: Tiered compilation requires a multi-threaded LLLazyJIT
+
+@total = internal global i32 0
+
+define i32 @inc(i32 %x) {
+entry:
+  %local = alloca i32
+  store i32 %x, i32* %local
+  %v = load i32, i32* %local
+  %r = add i32 %v, 1
+  ret i32 %r
+}
+
+define i32 @main(i32 %argc, i8** nocapture readnone %argv) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = phi i32 [ 0, %entry ], [ %acc.next, %loop ]
+  %acc.next = call i32 @inc(i32 %acc)
+  store i32 %acc.next, i32* @total
+  %i.next = add i32 %i, 1
+  %done = icmp eq i32 %i.next, 1000
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %t = load i32, i32* @total
+  %ret = sub i32 %t, 1000
+  ret i32 %ret
+}
@@ -0,0 +1,25 @@
+; REQUIRES: asserts
+; RUN: %lli -jit-kind=orc-mcjit -remote-mcjit -remote-shared-memory=4 \
+; RUN:   -mcjit-remote-process=lli-child-target%exeext -debug-only=orc-remote \
+; RUN:   %s 2> %t.log
+; RUN: FileCheck %s < %t.log
+; RUN: not grep "copying section" %t.log
+; XFAIL: windows-gnu,windows-msvc
+; UNSUPPORTED: powerpc64-unknown-linux-gnu
+; Remove UNSUPPORTED for powerpc64-unknown-linux-gnu if problem caused by r266663 is fixed
+
+; Check that with -remote-shared-memory the sections are placed in shared
+; memory and only their permissions are set remotely: no section is copied
+; with WriteMem.
+
+; CHECK: reserved shared:
+; CHECK: setting permissions on shared block
+
+@count = global i32 10, align 4
+
+define i32 @main() nounwind {
+entry:
+  %c = load i32, i32* @count, align 4
+  %ret = sub i32 %c, 10
+  ret i32 %ret
+}
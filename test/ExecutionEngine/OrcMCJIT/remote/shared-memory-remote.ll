@@ -0,0 +1,30 @@
+; RUN: %lli -jit-kind=orc-mcjit -remote-mcjit -remote-shared-memory=4 -mcjit-remote-process=lli-child-target%exeext %s
+; XFAIL: windows-gnu,windows-msvc
+; UNSUPPORTED: powerpc64-unknown-linux-gnu
+; Remove UNSUPPORTED for powerpc64-unknown-linux-gnu if problem caused by r266663 is fixed
+
+; Check that code, read-only data and writable data placed in memory shared
+; with the remote process are usable there: main returns zero only if every
+; value it reads is correct.
+
+@table = constant [4 x i32] [i32 1, i32 2, i32 3, i32 4], align 4
+@count = global i32 10, align 4
+
+define i32 @lookup(i32 %i) nounwind {
+entry:
+  %p = getelementptr [4 x i32], [4 x i32]* @table, i32 0, i32 %i
+  %v = load i32, i32* %p, align 4
+  ret i32 %v
+}
+
+define i32 @main() nounwind {
+entry:
+  %c = load i32, i32* @count, align 4
+  %inc = add i32 %c, 1
+  store i32 %inc, i32* @count, align 4
+  %v = call i32 @lookup(i32 3)
+  %c2 = load i32, i32* @count, align 4
+  %sum = add i32 %v, %c2
+  %ret = sub i32 %sum, 15
+  ret i32 %ret
+}
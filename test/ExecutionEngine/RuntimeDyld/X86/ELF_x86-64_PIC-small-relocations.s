@@ -1,6 +1,7 @@
 # RUN: rm -rf %t && mkdir -p %t
 # RUN: llvm-mc -triple=x86_64-unknown-freebsd -filetype=obj -o %t/testsmall_x86-64.o %s
 # RUN: llvm-rtdyld -triple=x86_64-unknown-freebsd -verify -check=%s %t/testsmall_x86-64.o
+# RUN: llvm-rtdyld -triple=x86_64-unknown-freebsd -parallel-relocations -rtdyld-parallel-relocation-threshold=0 -verify -check=%s %t/testsmall_x86-64.o
 
 	.globl	foo
 	.align	4, 0x90
@@ -0,0 +1,210 @@
+; RUN: %lli -force-interpreter %s
+; RUN: %lli -force-interpreter -interpreter-fast-path=false %s
+; RUN: %lli -force-interpreter -interpreter-fast-path-max-depth=4 %s
+
+; Functions that only use scalar values run as bytecode, the others are
+; interpreted instruction by instruction; calls go both ways. main returns the
+; number of the first check that fails, or 0.
+
+%pair = type { i8, i32 }
+
+@table = global [4 x i16] [i16 3, i16 -1, i16 7, i16 100]
+
+; PHIs that swap their values must be copied in parallel.
+define i32 @fib(i32 %n) {
+entry:
+  br label %loop
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %a = phi i32 [ 0, %entry ], [ %b, %loop ]
+  %b = phi i32 [ 1, %entry ], [ %sum, %loop ]
+  %sum = add i32 %a, %b
+  %i.next = add i32 %i, 1
+  %done = icmp sge i32 %i.next, %n
+  br i1 %done, label %exit, label %loop
+exit:
+  ret i32 %b
+}
+
+define i64 @fact(i64 %n) {
+  %base = icmp ule i64 %n, 1
+  br i1 %base, label %one, label %rec
+one:
+  ret i64 1
+rec:
+  %m = sub i64 %n, 1
+  %f = call i64 @fact(i64 %m)
+  %r = mul i64 %n, %f
+  ret i64 %r
+}
+
+define i32 @classify(i32 %x) {
+  switch i32 %x, label %other [ i32 1, label %one
+                                i32 -5, label %neg ]
+one:
+  ret i32 10
+neg:
+  ret i32 20
+other:
+  ret i32 30
+}
+
+; Sums @table through a pointer computed with a variable GEP index.
+define i32 @sum_table() {
+entry:
+  br label %loop
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %acc = phi i32 [ 0, %entry ], [ %acc.next, %loop ]
+  %p = getelementptr [4 x i16], [4 x i16]* @table, i64 0, i64 %i
+  %v = load i16, i16* %p
+  %v.ext = sext i16 %v to i32
+  %acc.next = add i32 %acc, %v.ext
+  %i.next = add i64 %i, 1
+  %done = icmp eq i64 %i.next, 4
+  br i1 %done, label %exit, label %loop
+exit:
+  ret i32 %acc.next
+}
+
+define i32 @struct_roundtrip(i32 %x) {
+  %s = alloca %pair
+  %f0 = getelementptr %pair, %pair* %s, i32 0, i32 0
+  %f1 = getelementptr %pair, %pair* %s, i32 0, i32 1
+  store i8 -1, i8* %f0
+  store i32 %x, i32* %f1
+  %a = load i8, i8* %f0
+  %b = load i32, i32* %f1
+  %a.ext = zext i8 %a to i32
+  %r = add i32 %a.ext, %b
+  ret i32 %r
+}
+
+define double @poly(float %x) {
+  %xd = fpext float %x to double
+  %x2 = fmul double %xd, %xd
+  %t = fadd double %x2, 5.000000e-01
+  %h = fdiv double %t, 2.000000e+00
+  ret double %h
+}
+
+; Uses a vector, so it is never turned into bytecode.
+define i32 @slow_add(i32 %a, i32 %b) {
+  %va = insertelement <2 x i32> undef, i32 %a, i32 0
+  %vb = insertelement <2 x i32> undef, i32 %b, i32 0
+  %vs = add <2 x i32> %va, %vb
+  %s = extractelement <2 x i32> %vs, i32 0
+  %f = call i32 @fib(i32 %s)
+  ret i32 %f
+}
+
+define i32 @apply(i32 (i32, i32)* %fn, i32 %a, i32 %b) {
+  %r = call i32 %fn(i32 %a, i32 %b)
+  ret i32 %r
+}
+
+define void @ignore(i32 %x) {
+  ret void
+}
+
+; The void call has no result register and must leave %x alone.
+define i32 @after_void_call(i32 %x) {
+  call void @ignore(i32 1)
+  ret i32 %x
+}
+
+; Recurses deeper than the native stack allows; the calls beyond the depth
+; limit are interpreted.
+define i64 @count_down(i64 %n) {
+  %base = icmp eq i64 %n, 0
+  br i1 %base, label %zero, label %rec
+zero:
+  ret i64 0
+rec:
+  %m = sub i64 %n, 1
+  %c = call i64 @count_down(i64 %m)
+  %r = add i64 %c, 1
+  ret i64 %r
+}
+
+define i32 @main() {
+entry:
+  %fib = call i32 @fib(i32 20)
+  %c1 = icmp ne i32 %fib, 6765
+  br i1 %c1, label %fail1, label %check2
+check2:
+  %fact = call i64 @fact(i64 20)
+  %c2 = icmp ne i64 %fact, 2432902008176640000
+  br i1 %c2, label %fail2, label %check3
+check3:
+  %s1 = call i32 @classify(i32 1)
+  %s2 = call i32 @classify(i32 -5)
+  %s3 = call i32 @classify(i32 7)
+  %s12 = add i32 %s1, %s2
+  %s = add i32 %s12, %s3
+  %c3 = icmp ne i32 %s, 60
+  br i1 %c3, label %fail3, label %check4
+check4:
+  %t = call i32 @sum_table()
+  %c4 = icmp ne i32 %t, 109
+  br i1 %c4, label %fail4, label %check5
+check5:
+  %st = call i32 @struct_roundtrip(i32 1000)
+  %c5 = icmp ne i32 %st, 1255
+  br i1 %c5, label %fail5, label %check6
+check6:
+  %p = call double @poly(float 3.000000e+00)
+  %c6 = fcmp une double %p, 4.750000e+00
+  br i1 %c6, label %fail6, label %check7
+check7:
+  ; Wrapping, signed division and shifts of narrow types.
+  %w = add i8 127, 1
+  %q = sdiv i8 %w, 3
+  %sh = ashr i8 %q, 2
+  %shl = shl i8 %sh, 1
+  %c7 = icmp ne i8 %shl, -22
+  br i1 %c7, label %fail7, label %check8
+check8:
+  %fi = fptosi double -2.500000e+00 to i32
+  %if = sitofp i32 %fi to float
+  %cmp = fcmp olt float %if, 0.000000e+00
+  %sel = select i1 %cmp, i32 %fi, i32 0
+  %c8 = icmp ne i32 %sel, -2
+  br i1 %c8, label %fail8, label %check9
+check9:
+  %ind = call i32 @apply(i32 (i32, i32)* @slow_add, i32 4, i32 6)
+  %c9 = icmp ne i32 %ind, 55
+  br i1 %c9, label %fail9, label %check10
+check10:
+  %av = call i32 @after_void_call(i32 42)
+  %c10 = icmp ne i32 %av, 42
+  br i1 %c10, label %fail10, label %check11
+check11:
+  %cd = call i64 @count_down(i64 200000)
+  %c11 = icmp ne i64 %cd, 200000
+  br i1 %c11, label %fail11, label %pass
+pass:
+  ret i32 0
+fail1:
+  ret i32 1
+fail2:
+  ret i32 2
+fail3:
+  ret i32 3
+fail4:
+  ret i32 4
+fail5:
+  ret i32 5
+fail6:
+  ret i32 6
+fail7:
+  ret i32 7
+fail8:
+  ret i32 8
+fail9:
+  ret i32 9
+fail10:
+  ret i32 10
+fail11:
+  ret i32 11
+}
@@ -0,0 +1,38 @@
+; The archive symbol table for bitcode members is built from the irsymtab and
+; lists defined, global, non-format-specific symbols in member order.
+; RUN: llvm-as %s -o %t1.bc
+; RUN: cp %t1.bc %t2.bc
+; RUN: rm -f %t.a
+; RUN: llvm-ar rcs %t.a %t1.bc %t2.bc
+; RUN: llvm-nm -M %t.a | FileCheck %s
+
+; CHECK: Archive map
+; CHECK-NEXT: global_fn in {{.*}}1.bc
+; CHECK-NEXT: weak_fn in {{.*}}1.bc
+; CHECK-NEXT: global_var in {{.*}}1.bc
+; CHECK-NEXT: global_fn in {{.*}}2.bc
+; CHECK-NEXT: weak_fn in {{.*}}2.bc
+; CHECK-NEXT: global_var in {{.*}}2.bc
+; CHECK-NOT: {{ in }}
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+@global_var = global i32 0
+@local_var = internal global i32 0
+@llvm.used = appending global [1 x i8*] [i8* bitcast (i32* @local_var to i8*)], section "llvm.metadata"
+
+declare void @undef_fn()
+
+define void @global_fn() {
+  call void @undef_fn()
+  ret void
+}
+
+define weak void @weak_fn() {
+  ret void
+}
+
+define internal void @local_fn() {
+  ret void
+}
@@ -0,0 +1,59 @@
+; Check that in-process ThinLTO backend tasks are scheduled largest-first and
+; that tasks larger than the whole memory budget still run, one at a time.
+; REQUIRES: asserts
+; RUN: opt -module-summary %s -o %t1.bc
+; RUN: opt -module-summary %p/Inputs/funcimport2.ll -o %t2.bc
+
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -debug-only=lto \
+; RUN:     -r=%t1.bc,_foo,plx \
+; RUN:     -r=%t2.bc,_main,plx \
+; RUN:     -r=%t2.bc,_foo,l 2>&1 | FileCheck %s --check-prefix=CHECK \
+; RUN:     --implicit-check-not="exceeds the memory budget"
+
+; A budget of 1 MB holds both of these small tasks at the default estimate
+; of 1 KB per instruction.
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -debug-only=lto \
+; RUN:     -thinlto-backend-memory-budget=1 \
+; RUN:     -r=%t1.bc,_foo,plx \
+; RUN:     -r=%t2.bc,_main,plx \
+; RUN:     -r=%t2.bc,_foo,l 2>&1 | FileCheck %s --check-prefix=CHECK \
+; RUN:     --implicit-check-not="exceeds the memory budget"
+
+; At 1 MB per instruction, each task alone is larger than the budget.
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -debug-only=lto \
+; RUN:     -thinlto-backend-memory-budget=1 \
+; RUN:     -thinlto-backend-bytes-per-instruction=1048576 \
+; RUN:     -r=%t1.bc,_foo,plx \
+; RUN:     -r=%t2.bc,_main,plx \
+; RUN:     -r=%t2.bc,_foo,l 2>&1 | FileCheck %s --check-prefix=OVER
+
+; A budget that rounds down to less than one instruction must still be
+; enforced rather than treated as unlimited.
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -debug-only=lto \
+; RUN:     -thinlto-backend-memory-budget=1 \
+; RUN:     -thinlto-backend-bytes-per-instruction=2097152 \
+; RUN:     -r=%t1.bc,_foo,plx \
+; RUN:     -r=%t2.bc,_main,plx \
+; RUN:     -r=%t2.bc,_foo,l 2>&1 | FileCheck %s --check-prefix=OVER
+; RUN: llvm-nm %t.o.1 | FileCheck %s --check-prefix=NM1
+; RUN: llvm-nm %t.o.2 | FileCheck %s --check-prefix=NM2
+
+; The module defining main imports foo, so it is the larger task.
+; CHECK: Scheduling ThinLTO backend task 2 ({{.*}}2.bc), estimated size: 4 instructions
+; CHECK: Scheduling ThinLTO backend task 1 ({{.*}}1.bc), estimated size: 2 instructions
+
+; OVER: Scheduling ThinLTO backend task 2 ({{.*}}2.bc), estimated size: 4 instructions
+; OVER-NEXT: Task 2 exceeds the memory budget; running it on its own
+; OVER: Scheduling ThinLTO backend task 1 ({{.*}}1.bc), estimated size: 2 instructions
+; OVER-NEXT: Task 1 exceeds the memory budget; running it on its own
+
+; NM1: T _foo
+; NM2: T _main
+
+target datalayout = "e-m:o-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-apple-macosx10.11.0"
+
+define void @foo() #0 {
+entry:
+  ret void
+}
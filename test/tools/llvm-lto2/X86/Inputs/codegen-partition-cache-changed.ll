@@ -0,0 +1,7 @@
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @bar(i32 %x) noinline {
+  %r = add i32 %x, 2
+  ret i32 %r
+}
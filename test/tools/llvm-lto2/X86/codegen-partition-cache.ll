@@ -0,0 +1,54 @@
+; RUN: llvm-as < %s > %t1.bc
+; RUN: llvm-as < %p/Inputs/codegen-partition-cache.ll > %t2.bc
+; RUN: llvm-as < %p/Inputs/codegen-partition-cache-changed.ll > %t3.bc
+
+; Each of the two codegen partitions gets a cache entry.
+; RUN: rm -Rf %t.cache
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -cache-dir %t.cache \
+; RUN:     -lto-partitions=2 -lto-cache-codegen-partitions \
+; RUN:     -r %t1.bc,foo,px -r %t1.bc,bar, -r %t2.bc,bar,px
+; RUN: ls %t.cache/llvmcache-* | count 2
+
+; Linking the same inputs again reuses both entries.
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -cache-dir %t.cache \
+; RUN:     -lto-partitions=2 -lto-cache-codegen-partitions \
+; RUN:     -r %t1.bc,foo,px -r %t1.bc,bar, -r %t2.bc,bar,px
+; RUN: ls %t.cache/llvmcache-* | count 2
+
+; The pre-codegen hook still runs when a partition comes from the cache.
+; -save-temps keeps value names, so it needs cache entries of its own.
+; RUN: rm -Rf %t.savetemps.cache
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -cache-dir %t.savetemps.cache \
+; RUN:     -lto-partitions=2 -lto-cache-codegen-partitions -save-temps \
+; RUN:     -r %t1.bc,foo,px -r %t1.bc,bar, -r %t2.bc,bar,px
+; RUN: rm -f %t.o.*
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -cache-dir %t.savetemps.cache \
+; RUN:     -lto-partitions=2 -lto-cache-codegen-partitions -save-temps \
+; RUN:     -r %t1.bc,foo,px -r %t1.bc,bar, -r %t2.bc,bar,px
+; RUN: ls %t.savetemps.cache/llvmcache-* | count 2
+; RUN: llvm-dis %t.o.0.5.precodegen.bc -o - | FileCheck %s --check-prefix=PRECG
+; RUN: llvm-dis %t.o.1.5.precodegen.bc -o - | FileCheck %s --check-prefix=PRECG
+; PRECG: define i32 @
+
+; Changing bar only invalidates the partition that contains it.
+; RUN: llvm-lto2 run %t1.bc %t3.bc -o %t.o -cache-dir %t.cache \
+; RUN:     -lto-partitions=2 -lto-cache-codegen-partitions \
+; RUN:     -r %t1.bc,foo,px -r %t1.bc,bar, -r %t3.bc,bar,px
+; RUN: ls %t.cache/llvmcache-* | count 3
+
+; Without -lto-cache-codegen-partitions regular LTO does not use the cache.
+; RUN: rm -Rf %t.cache
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -cache-dir %t.cache \
+; RUN:     -lto-partitions=2 \
+; RUN:     -r %t1.bc,foo,px -r %t1.bc,bar, -r %t2.bc,bar,px
+; RUN: ls %t.cache | count 0
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i32 @bar(i32)
+
+define i32 @foo(i32 %x) {
+  %r = call i32 @bar(i32 %x)
+  ret i32 %r
+}
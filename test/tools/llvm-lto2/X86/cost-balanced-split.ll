@@ -0,0 +1,41 @@
+; RUN: llvm-as < %s > %t1.bc
+
+; Split the regular LTO module into two cost-balanced codegen partitions and
+; report the time spent in each.
+; RUN: llvm-lto2 run %t1.bc -o %t.o -O0 -lto-partitions=2 \
+; RUN:     -lto-cost-balanced-split -lto-report-codegen-partitions \
+; RUN:     -r %t1.bc,a,px -r %t1.bc,b,px -r %t1.bc,big,px 2>&1 \
+; RUN:     | FileCheck %s --check-prefix=REPORT
+; RUN: llvm-nm %t.o.0 | FileCheck %s --check-prefix=NM0
+; RUN: llvm-nm %t.o.1 | FileCheck %s --check-prefix=NM1
+
+; REPORT: LTO Code Generation Partitions
+; REPORT-DAG: partition 0 ({{[0-9]+}} instructions)
+; REPORT-DAG: partition 1 ({{[0-9]+}} instructions)
+
+; NM0: T big
+; NM1: T a
+; NM1: T b
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @a(i32 %x) {
+  %r = call i32 @b(i32 %x)
+  ret i32 %r
+}
+
+define i32 @b(i32 %x) {
+  %r = call i32 @a(i32 %x)
+  ret i32 %r
+}
+
+define i32 @big(i32 %x) {
+  %1 = add i32 %x, 1
+  %2 = mul i32 %1, 3
+  %3 = sub i32 %2, %x
+  %4 = xor i32 %3, 7
+  %5 = shl i32 %4, 2
+  %6 = or i32 %5, %1
+  ret i32 %6
+}
@@ -0,0 +1,46 @@
+; With profile data, cost-balanced partitions weight functions by their entry
+; count. Without it, @hot would be the cheapest function and would share a
+; partition with @cold1.
+
+; RUN: llvm-split -j=2 -cost-balanced -o %t %s
+; RUN: llvm-dis -o - %t0 | FileCheck --check-prefix=CHECK0 %s
+; RUN: llvm-dis -o - %t1 | FileCheck --check-prefix=CHECK1 %s
+
+; CHECK0: define i32 @hot
+; CHECK0: declare i32 @cold1
+; CHECK0: declare i32 @cold2
+
+; CHECK1: declare i32 @hot
+; CHECK1: define i32 @cold1
+; CHECK1: define i32 @cold2
+
+define i32 @hot(i32 %x) !prof !0 {
+  %1 = add i32 %x, 1
+  %2 = mul i32 %1, 3
+  ret i32 %2
+}
+
+define i32 @cold1(i32 %x) !prof !1 {
+  %1 = add i32 %x, 1
+  %2 = mul i32 %1, 3
+  %3 = sub i32 %2, %x
+  %4 = xor i32 %3, 7
+  %5 = shl i32 %4, 2
+  %6 = or i32 %5, %1
+  %7 = and i32 %6, %2
+  ret i32 %7
+}
+
+define i32 @cold2(i32 %x) !prof !1 {
+  %1 = add i32 %x, 2
+  %2 = mul i32 %1, 5
+  %3 = sub i32 %2, %x
+  %4 = xor i32 %3, 9
+  %5 = shl i32 %4, 3
+  %6 = or i32 %5, %1
+  %7 = and i32 %6, %2
+  ret i32 %7
+}
+
+!0 = !{!"function_entry_count", i64 100000}
+!1 = !{!"function_entry_count", i64 0}
@@ -0,0 +1,46 @@
+; Partitions are balanced by instruction count and functions in the same
+; call graph SCC stay together.
+
+; RUN: llvm-split -j=2 -cost-balanced -o %t %s
+; RUN: llvm-dis -o - %t0 | FileCheck --check-prefix=CHECK0 %s
+; RUN: llvm-dis -o - %t1 | FileCheck --check-prefix=CHECK1 %s
+
+; CHECK0: declare i32 @a
+; CHECK0: declare i32 @b
+; CHECK0: define i32 @big
+; CHECK0: declare i32 @c
+; CHECK0: define i32 @d
+
+; CHECK1: define i32 @a
+; CHECK1: define i32 @b
+; CHECK1: declare i32 @big
+; CHECK1: define i32 @c
+; CHECK1: declare i32 @d
+
+define i32 @a(i32 %x) {
+  %r = call i32 @b(i32 %x)
+  ret i32 %r
+}
+
+define i32 @b(i32 %x) {
+  %r = call i32 @a(i32 %x)
+  ret i32 %r
+}
+
+define i32 @big(i32 %x) {
+  %1 = add i32 %x, 1
+  %2 = mul i32 %1, 3
+  %3 = sub i32 %2, %x
+  %4 = xor i32 %3, 7
+  %5 = shl i32 %4, 2
+  %6 = or i32 %5, %1
+  ret i32 %6
+}
+
+define i32 @c() {
+  ret i32 0
+}
+
+define i32 @d() {
+  ret i32 1
+}
@@ -21,8 +21,9 @@ ExitOnError ExitOnErr;
 
 int main(int argc, char *argv[]) {
 
-  if (argc != 3) {
-    errs() << "Usage: " << argv[0] << " <input fd> <output fd>\n";
+  if (argc != 3 && argc != 4) {
+    errs() << "Usage: " << argv[0]
+           << " <input fd> <output fd> [<shared memory fd>]\n";
     return 1;
   }
 
@@ -30,10 +31,15 @@ int main(int argc, char *argv[]) {
 
   int InFD;
   int OutFD;
+  int SharedMemFD = -1;
   {
     std::istringstream InFDStream(argv[1]), OutFDStream(argv[2]);
     InFDStream >> InFD;
     OutFDStream >> OutFD;
+    if (argc == 4) {
+      std::istringstream SharedMemFDStream(argv[3]);
+      SharedMemFDStream >> SharedMemFD;
+    }
   }
 
   if (sys::DynamicLibrary::LoadLibraryPermanently(nullptr)) {
@@ -56,12 +62,16 @@ int main(int argc, char *argv[]) {
   FDRawChannel Channel(InFD, OutFD);
   typedef remote::OrcRemoteTargetServer<FDRawChannel, HostOrcArch> JITServer;
   JITServer Server(Channel, SymbolLookup, RegisterEHFrames, DeregisterEHFrames);
+  if (SharedMemFD >= 0)
+    Server.enableSharedMemory(SharedMemFD);
 
   while (!Server.receivedTerminate())
     ExitOnErr(Server.handleOne());
 
   close(InFD);
   close(OutFD);
+  if (SharedMemFD >= 0)
+    close(SharedMemFD);
 
   return 0;
 }
@@ -71,8 +71,13 @@ private:
   int InFD, OutFD;
 };
 
-// launch the remote process (see lli.cpp) and return a channel to it.
-std::unique_ptr<FDRawChannel> launchRemote();
+// create a file of Size bytes to share with the remote process (see lli.cpp)
+// and return its descriptor, or -1 on failure.
+int createSharedMemory(uint64_t Size);
+
+// launch the remote process (see lli.cpp) and return a channel to it. If
+// SharedMemFD is not -1, the remote process can map it as shared memory.
+std::unique_ptr<FDRawChannel> launchRemote(int SharedMemFD);
 
 namespace llvm {
 
@@ -28,6 +28,7 @@
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/LocalObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/OrcRemoteTargetClient.h"
 #include "llvm/ExecutionEngine/OrcMCJITReplacement.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
@@ -60,6 +61,14 @@
 #include "llvm/Transforms/Instrumentation.h"
 #include <cerrno>
 
+#ifdef LLVM_ON_UNIX
+#include <fcntl.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
 #ifdef __CYGWIN__
 #include <cygwin/version.h>
 #if defined(CYGWIN_VERSION_DLL_MAJOR) && CYGWIN_VERSION_DLL_MAJOR<1007
@@ -109,6 +118,19 @@ namespace {
                     cl::desc("calls the given entry-point on a new thread "
                              "(jit-kind=orc-lazy only)"));
 
+  cl::opt<unsigned> SpeculationLimit(
+      "speculation-limit",
+      cl::desc("Maximum number of functions to compile speculatively at any "
+               "one time (jit-kind=orc-lazy only)"),
+      cl::init(0));
+
+  cl::opt<unsigned> TierUpThreshold(
+      "tier-up-threshold",
+      cl::desc("Compile functions at -O0 first and recompile them at -O3 "
+               "once they have been called this many times "
+               "(jit-kind=orc-lazy only, requires -compile-threads)"),
+      cl::init(0));
+
   cl::opt<bool> PerModuleLazy(
       "per-module-lazy",
       cl::desc("Performs lazy compilation on whole module boundaries "
@@ -138,6 +160,16 @@ namespace {
                          "\n\tremote execution will be simulated in-process."),
                 cl::value_desc("filename"), cl::init(""));
 
+  // Share a memory region with the child process, so that JIT'd code and data
+  // is written into the child's memory directly instead of being copied over
+  // the pipes.
+  cl::opt<unsigned> RemoteSharedMemory(
+      "remote-shared-memory",
+      cl::desc("Size, in megabytes, of the memory region to share with the "
+               "remote process for JIT'd code and data (0 to copy everything "
+               "over the pipes)"),
+      cl::value_desc("megabytes"), cl::init(0));
+
   // Determine optimization level.
   cl::opt<char>
   OptLevel("O",
@@ -183,6 +215,12 @@ namespace {
                            "(must be user writable)"),
                   cl::init(""));
 
+  cl::opt<std::string>
+  ObjectCachePruningPolicy("object-cache-pruning-policy",
+                           cl::desc("Pruning policy for the object cache used "
+                                    "by -jit-kind=orc-lazy"),
+                           cl::init(""));
+
   cl::opt<std::string>
   FakeArgv0("fake-argv0",
             cl::desc("Override the 'argv[0]' value passed into the executing"
@@ -647,8 +685,20 @@ int main(int argc, char **argv, char * const *envp) {
     // it couldn't. This is a limitation of the LLI implementation, not the
     // MCJIT itself. FIXME.
 
+    // Create the memory to share with the remote process, if requested.
+    uint64_t SharedMemSize = uint64_t(RemoteSharedMemory) * 1024 * 1024;
+    int SharedMemFD = -1;
+    if (SharedMemSize) {
+      SharedMemFD = createSharedMemory(SharedMemSize);
+      if (SharedMemFD < 0) {
+        WithColor::error(errs(), argv[0])
+            << "failed to create shared memory for remote JIT.\n";
+        exit(1);
+      }
+    }
+
     // Lanch the remote process and get a channel to it.
-    std::unique_ptr<FDRawChannel> C = launchRemote();
+    std::unique_ptr<FDRawChannel> C = launchRemote(SharedMemFD);
     if (!C) {
       WithColor::error(errs(), argv[0]) << "failed to launch remote JIT.\n";
       exit(1);
@@ -659,6 +709,8 @@ int main(int argc, char **argv, char * const *envp) {
     ES.setErrorReporter([&](Error Err) { ExitOnErr(std::move(Err)); });
     typedef orc::remote::OrcRemoteTargetClient MyRemote;
     auto R = ExitOnErr(MyRemote::Create(*C, ES));
+    if (SharedMemFD >= 0)
+      ExitOnErr(R->enableSharedMemory(SharedMemFD, SharedMemSize));
 
     // Create a remote memory manager.
     auto RemoteMM = ExitOnErr(R->createRemoteMemoryManager());
@@ -784,16 +836,50 @@ int runOrcLazyJIT(const char *ProgName) {
                         ? Optional<CodeModel::Model>(CMModel)
                         : None);
 
+  // With tiering, functions start out in a fast -O0/FastISel tier and only
+  // hot ones are compiled, at -O3.
+  Optional<orc::JITTargetMachineBuilder> FastJTMB;
+  if (TierUpThreshold != 0) {
+    FastJTMB = JTMB;
+    FastJTMB->setCodeGenOptLevel(CodeGenOpt::None);
+    FastJTMB->getOptions().EnableFastISel = true;
+    JTMB.setCodeGenOptLevel(CodeGenOpt::Aggressive);
+  }
+
   DataLayout DL = ExitOnErr(JTMB.getDefaultDataLayoutForTarget());
 
+  std::unique_ptr<orc::LocalObjectCache> ObjCache;
+  if (EnableCacheManager) {
+    if (ObjectCacheDir.empty())
+      ExitOnErr(make_error<StringError>(
+          "-enable-cache-manager requires -object-cache-dir with "
+          "-jit-kind=orc-lazy",
+          inconvertibleErrorCode()));
+    auto TM = ExitOnErr(JTMB.createTargetMachine());
+    auto Policy = ExitOnErr(parseCachePruningPolicy(ObjectCachePruningPolicy));
+    ObjCache = ExitOnErr(
+        orc::LocalObjectCache::Create(ObjectCacheDir, *TM, std::move(Policy)));
+  }
+
   auto J = ExitOnErr(orc::LLLazyJIT::Create(
       std::move(JTMB), DL,
       pointerToJITTargetAddress(exitOnLazyCallThroughFailure),
-      LazyJITCompileThreads));
+      LazyJITCompileThreads, ObjCache.get()));
 
   if (PerModuleLazy)
     J->setPartitionFunction(orc::CompileOnDemandLayer::compileWholeModule);
 
+  // Speculative compiles only run on the background compile threads.
+  if (SpeculationLimit != 0 && LazyJITCompileThreads == 0)
+    ExitOnErr(make_error<StringError>(
+        "-speculation-limit requires -compile-threads with -jit-kind=orc-lazy",
+        inconvertibleErrorCode()));
+  J->setSpeculationLimit(SpeculationLimit);
+
+  if (FastJTMB)
+    ExitOnErr(
+        J->enableTieredCompilation(std::move(*FastJTMB), TierUpThreshold));
+
   auto Dump = createDebugDumper();
 
   J->setLazyCompileTransform([&](orc::ThreadSafeModule TSM,
@@ -910,9 +996,44 @@ void disallowOrcOptions() {
     errs() << "-per-module-lazy requires -jit-kind=orc-lazy\n";
     exit(1);
   }
+
+  if (SpeculationLimit != 0) {
+    errs() << "-speculation-limit requires -jit-kind=orc-lazy\n";
+    exit(1);
+  }
+
+  if (TierUpThreshold != 0) {
+    errs() << "-tier-up-threshold requires -jit-kind=orc-lazy\n";
+    exit(1);
+  }
+}
+
+int createSharedMemory(uint64_t Size) {
+#ifndef LLVM_ON_UNIX
+  llvm_unreachable("createSharedMemory not supported on non-Unix platforms");
+#else
+  int FD = -1;
+#if defined(__linux__) && defined(SYS_memfd_create)
+  FD = syscall(SYS_memfd_create, "lli-remote-jit", 0);
+#endif
+  // Without memfd, fall back to an unlinked temporary file.
+  if (FD < 0) {
+    SmallString<128> Path;
+    if (sys::fs::createTemporaryFile("lli-remote-jit", "mem", FD, Path))
+      return -1;
+    sys::fs::remove(Path);
+  }
+
+  // The child process inherits the descriptor.
+  if (fcntl(FD, F_SETFD, 0) != 0 || sys::fs::resize_file(FD, Size)) {
+    close(FD);
+    return -1;
+  }
+  return FD;
+#endif
 }
 
-std::unique_ptr<FDRawChannel> launchRemote() {
+std::unique_ptr<FDRawChannel> launchRemote(int SharedMemFD) {
 #ifndef LLVM_ON_UNIX
   llvm_unreachable("launchRemote not supported on non-Unix platforms");
 #else
@@ -949,7 +1070,10 @@ std::unique_ptr<FDRawChannel> launchRemote() {
       ChildOut[ChildOutStr.size()] = '\0';
     }
 
-    char * const args[] = { &ChildPath[0], &ChildIn[0], &ChildOut[0], nullptr };
+    std::string SharedMemStr = SharedMemFD >= 0 ? utostr(SharedMemFD) : "";
+    char * const args[] = { &ChildPath[0], &ChildIn[0], &ChildOut[0],
+                            SharedMemFD >= 0 ? &SharedMemStr[0] : nullptr,
+                            nullptr };
     int rc = execv(ChildExecPath.c_str(), args);
     if (rc != 0)
       perror("Error executing child process: ");
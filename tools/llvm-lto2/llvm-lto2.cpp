@@ -69,6 +69,10 @@ static cl::opt<bool>
 static cl::opt<int> Threads("thinlto-threads",
                             cl::init(llvm::heavyweight_hardware_concurrency()));
 
+static cl::opt<unsigned> ParallelCodeGenParallelismLevel(
+    "lto-partitions", cl::init(1),
+    cl::desc("Number of regular LTO codegen partitions"));
+
 static cl::list<std::string> SymbolResolutions(
     "r",
     cl::desc("Specify a symbol resolution: filename,symbolname,resolution\n"
@@ -256,7 +260,8 @@ static int run(int argc, char **argv) {
                                             /* OnWrite */ {});
   else
     Backend = createInProcessThinBackend(Threads);
-  LTO Lto(std::move(Conf), std::move(Backend));
+  LTO Lto(std::move(Conf), std::move(Backend),
+          ParallelCodeGenParallelismLevel);
 
   bool HasErrors = false;
   for (std::string F : InputFilenames) {
@@ -138,6 +138,12 @@ PrintAllocationRequests("print-alloc-requests",
                                  "manager by RuntimeDyld"),
                         cl::Hidden);
 
+static cl::opt<bool>
+ParallelRelocations("parallel-relocations",
+                    cl::desc("Resolve relocations on multiple threads where "
+                             "the target supports it"),
+                    cl::Hidden);
+
 /* *** */
 
 // A trivial memory manager that doesn't do anything fancy, just uses the
@@ -690,6 +696,7 @@ static int linkAndVerify() {
   doPreallocation(MemMgr);
   RuntimeDyld Dyld(MemMgr, MemMgr);
   Dyld.setProcessAllSections(true);
+  Dyld.setResolveRelocationsInParallel(ParallelRelocations);
   RuntimeDyldChecker Checker(Dyld, Disassembler.get(), InstPrinter.get(),
                              llvm::dbgs());
 
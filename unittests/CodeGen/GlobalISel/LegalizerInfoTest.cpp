@@ -198,4 +198,36 @@ TEST(LegalizerInfoTest, SizeChangeStrategy) {
   ASSERT_EQ(L.getAction({G_UREM, {LLT::scalar(33)}}),
             LegalizeActionStep(Unsupported, 0, LLT::scalar(33)));
 }
+
+TEST(LegalizerInfoTest, RememberedDecisions) {
+  using namespace TargetOpcode;
+  LegalizerInfo L;
+  LLT s32 = LLT::scalar(32);
+  LLT p0 = LLT::pointer(0, 64);
+  unsigned NumRuleRuns = 0;
+  L.getActionDefinitionsBuilder(G_LOAD).legalIf(
+      [&](const LegalityQuery &Query) {
+        ++NumRuleRuns;
+        return Query.MMODescrs[0].SizeInBits == 32;
+      });
+  L.computeTables();
+
+  // The rules only run for the first query with a given signature, and the
+  // memory operand is part of it.
+  LegalityQuery::MemDesc Mem32 = {32, AtomicOrdering::NotAtomic};
+  LegalityQuery::MemDesc Mem8 = {8, AtomicOrdering::NotAtomic};
+  for (unsigned I = 0; I != 3; ++I) {
+    ASSERT_EQ(L.getAction({G_LOAD, {s32, p0}, {Mem32}}),
+              LegalizeActionStep(Legal, 0, LLT{}));
+    ASSERT_EQ(L.getAction({G_LOAD, {s32, p0}, {Mem8}}),
+              LegalizeActionStep(Unsupported, 0, LLT{}));
+  }
+  EXPECT_EQ(NumRuleRuns, 2u);
+
+  // Changing the rules forgets the decisions.
+  L.getActionDefinitionsBuilder(G_STORE).legalFor({{s32, p0}});
+  ASSERT_EQ(L.getAction({G_LOAD, {s32, p0}, {Mem32}}),
+            LegalizeActionStep(Legal, 0, LLT{}));
+  EXPECT_EQ(NumRuleRuns, 3u);
+}
 }
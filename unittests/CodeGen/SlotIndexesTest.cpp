@@ -0,0 +1,198 @@
+//===- SlotIndexesTest.cpp ------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/CodeGen/SlotIndexes.h"
+#include "llvm/CodeGen/MachineFunction.h"
+#include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/TargetFrameLowering.h"
+#include "llvm/CodeGen/TargetInstrInfo.h"
+#include "llvm/CodeGen/TargetLowering.h"
+#include "llvm/CodeGen/TargetSubtargetInfo.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Target/TargetOptions.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+// Add a few Bogus backend classes so we can create MachineInstrs without
+// depending on a real target.
+class BogusTargetLowering : public TargetLowering {
+public:
+  BogusTargetLowering(TargetMachine &TM) : TargetLowering(TM) {}
+};
+
+class BogusFrameLowering : public TargetFrameLowering {
+public:
+  BogusFrameLowering()
+      : TargetFrameLowering(TargetFrameLowering::StackGrowsDown, 4, 4) {}
+
+  void emitPrologue(MachineFunction &MF,
+                    MachineBasicBlock &MBB) const override {}
+  void emitEpilogue(MachineFunction &MF,
+                    MachineBasicBlock &MBB) const override {}
+  bool hasFP(const MachineFunction &MF) const override { return false; }
+};
+
+class BogusSubtarget : public TargetSubtargetInfo {
+public:
+  BogusSubtarget(TargetMachine &TM)
+      : TargetSubtargetInfo(Triple(""), "", "", {}, {}, nullptr, nullptr,
+                            nullptr, nullptr, nullptr, nullptr, nullptr),
+        FL(), TL(TM) {}
+  ~BogusSubtarget() override {}
+
+  const TargetFrameLowering *getFrameLowering() const override { return &FL; }
+
+  const TargetLowering *getTargetLowering() const override { return &TL; }
+
+  const TargetInstrInfo *getInstrInfo() const override { return &TII; }
+
+private:
+  BogusFrameLowering FL;
+  BogusTargetLowering TL;
+  TargetInstrInfo TII;
+};
+
+class BogusTargetMachine : public LLVMTargetMachine {
+public:
+  BogusTargetMachine()
+      : LLVMTargetMachine(Target(), "", Triple(""), "", "", TargetOptions(),
+                          Reloc::Static, CodeModel::Small, CodeGenOpt::Default),
+        ST(*this) {}
+  ~BogusTargetMachine() override {}
+
+  const TargetSubtargetInfo *getSubtargetImpl(const Function &) const override {
+    return &ST;
+  }
+
+private:
+  BogusSubtarget ST;
+};
+
+// An instruction without operands.
+const MCInstrDesc MCID = {0, 0, 0, 0, 0, 0, 0, nullptr, nullptr, nullptr, 0,
+                          nullptr};
+
+class SlotIndexesTest : public testing::Test {
+protected:
+  SlotIndexesTest() : M("Module", Ctx), MMI(&TM) {
+    auto Type = FunctionType::get(Type::getVoidTy(Ctx), false);
+    auto F = Function::Create(Type, GlobalValue::ExternalLinkage, "Test", &M);
+    MF = make_unique<MachineFunction>(*F, TM, *TM.getSubtargetImpl(*F), 0,
+                                      MMI);
+    MBB = MF->CreateMachineBasicBlock();
+    MF->push_back(MBB);
+  }
+
+  MachineInstr *createInstr() {
+    return MF->CreateMachineInstr(MCID, DebugLoc());
+  }
+
+  /// Check that the indexes of the instructions of MBB increase strictly.
+  void checkOrder() {
+    SlotIndex Prev = SI.getMBBStartIdx(MBB);
+    unsigned N = 0;
+    for (MachineInstr &MI : *MBB) {
+      SlotIndex Idx = SI.getInstructionIndex(MI);
+      ASSERT_TRUE(Prev < Idx) << "at instruction " << N;
+      Prev = Idx;
+      ++N;
+    }
+    EXPECT_TRUE(Prev < SI.getMBBEndIdx(MBB));
+  }
+
+  /// Check that renumbering after \p NumInserted insertions touched
+  /// O(log n) entries per insertion, amortized.  Renumbering the whole tail
+  /// on every collision would be linear and blow well past this bound.
+  void checkRenumberingWork(unsigned NumInserted) {
+    EXPECT_LE(SI.getNumRenumberedEntries(),
+              uint64_t(NumInserted) * 32 * Log2_32_Ceil(NumInserted));
+  }
+
+  LLVMContext Ctx;
+  Module M;
+  BogusTargetMachine TM;
+  MachineModuleInfo MMI;
+  std::unique_ptr<MachineFunction> MF;
+  MachineBasicBlock *MBB;
+  SlotIndexes SI;
+};
+
+// Inserting repeatedly at the same point is the worst case for renumbering.
+TEST_F(SlotIndexesTest, InsertAtSamePoint) {
+  MachineInstr *Anchor = createInstr();
+  MBB->push_back(Anchor);
+  MBB->push_back(createInstr());
+  SI.runOnMachineFunction(*MF);
+
+  for (unsigned I = 0; I != 200000; ++I) {
+    MachineInstr *MI = createInstr();
+    MBB->insertAfter(Anchor, MI);
+    SI.insertMachineInstrInMaps(*MI);
+  }
+  checkOrder();
+  checkRenumberingWork(200000);
+}
+
+TEST_F(SlotIndexesTest, InsertAtFront) {
+  MBB->push_back(createInstr());
+  SI.runOnMachineFunction(*MF);
+
+  for (unsigned I = 0; I != 100000; ++I) {
+    MachineInstr *MI = createInstr();
+    MBB->insert(MBB->begin(), MI);
+    SI.insertMachineInstrInMaps(*MI);
+  }
+  checkOrder();
+  checkRenumberingWork(100000);
+}
+
+TEST_F(SlotIndexesTest, InsertAtEnd) {
+  MBB->push_back(createInstr());
+  SI.runOnMachineFunction(*MF);
+
+  for (unsigned I = 0; I != 100000; ++I) {
+    MachineInstr *MI = createInstr();
+    MBB->push_back(MI);
+    SI.insertMachineInstrInMaps(*MI);
+  }
+  checkOrder();
+  checkRenumberingWork(100000);
+}
+
+// Insert into a large block that was numbered in one go, at pseudo-random
+// points, every other one right after the previous insertion.
+TEST_F(SlotIndexesTest, InsertIntoLargeBlock) {
+  std::vector<MachineInstr *> Instrs;
+  for (unsigned I = 0; I != 100000; ++I) {
+    Instrs.push_back(createInstr());
+    MBB->push_back(Instrs.back());
+  }
+  SI.runOnMachineFunction(*MF);
+
+  uint32_t Seed = 1;
+  MachineInstr *Last = Instrs.front();
+  for (unsigned I = 0; I != 100000; ++I) {
+    Seed = Seed * 1103515245 + 12345;
+    MachineInstr *After = I % 2 ? Last : Instrs[(Seed >> 8) % Instrs.size()];
+    MachineInstr *MI = createInstr();
+    MBB->insertAfter(After, MI);
+    SI.insertMachineInstrInMaps(*MI);
+    Instrs.push_back(MI);
+    Last = MI;
+  }
+  checkOrder();
+  checkRenumberingWork(100000);
+}
+
+} // end anonymous namespace
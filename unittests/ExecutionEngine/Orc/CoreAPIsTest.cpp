@@ -197,6 +197,93 @@ TEST_F(CoreAPIsStandardTest, RemoveSymbolsTest) {
   EXPECT_TRUE(OnReadyRun) << "OnReady should have been run";
 }
 
+TEST_F(CoreAPIsStandardTest, RemoveModuleTest) {
+  // Test that:
+  // (1) Modules with materializing symbols can not be removed.
+  // (2) Removing a module removes the symbols defined under its key, in all
+  //     JITDylibs, and only those.
+  // (3) Registered resource managers are notified of successful removals.
+
+  class RecordingResourceManager : public ResourceManager {
+  public:
+    Error removeResources(VModuleKey K) override {
+      Removed.push_back(K);
+      return Error::success();
+    }
+
+    std::vector<VModuleKey> Removed;
+  };
+
+  RecordingResourceManager RM;
+  ES.registerResourceManager(RM);
+
+  auto K1 = ES.allocateVModule();
+  auto K2 = ES.allocateVModule();
+  auto &JD2 = ES.createJITDylib("JD2");
+
+  cantFail(JD.define(absoluteSymbols({{Foo, FooSym}}, K1)));
+  cantFail(JD2.define(absoluteSymbols({{Bar, BarSym}}, K1)));
+  cantFail(JD.define(absoluteSymbols({{Baz, BazSym}}, K2)));
+
+  // Qux, also from K2, is left in the materializing state.
+  Optional<MaterializationResponsibility> QuxR;
+  cantFail(JD.define(llvm::make_unique<SimpleMaterializationUnit>(
+      SymbolFlagsMap({{Qux, QuxSym.getFlags()}}),
+      [&](MaterializationResponsibility R) { QuxR.emplace(std::move(R)); },
+      SimpleMaterializationUnit::DiscardFunction(),
+      SimpleMaterializationUnit::DestructorFunction(), K2)));
+
+  // Speculation needs a speculative dispatcher; materialize Qux right away.
+  ES.setDispatchSpeculativeMaterialization(
+      [](JITDylib &JD, std::unique_ptr<MaterializationUnit> MU) {
+        MU->doMaterialize(JD);
+      });
+  bool OnDoneRun = false;
+  ES.speculate(JITDylibSearchList({{&JD, false}}), {Qux}, [&](Error Err) {
+    EXPECT_FALSE(!!Err) << "Speculative lookup failed unexpectedly";
+    consumeError(std::move(Err));
+    OnDoneRun = true;
+  });
+  ASSERT_TRUE(QuxR.hasValue()) << "Qux should be materializing";
+
+  {
+    auto Err = ES.removeModule(K2);
+    EXPECT_TRUE(Err.isA<SymbolsCouldNotBeRemoved>())
+        << "Expected a SymbolsCouldNotBeRemoved error";
+    consumeError(std::move(Err));
+  }
+  EXPECT_TRUE(RM.Removed.empty()) << "Failed removal reached the manager";
+
+  cantFail(ES.removeModule(K1));
+  EXPECT_EQ(RM.Removed, std::vector<VModuleKey>({K1}));
+
+  auto ExpectNotFound = [&](JITDylib &LookupJD, SymbolStringPtr Name) {
+    auto Result = ES.lookup({&LookupJD}, Name);
+    EXPECT_FALSE(!!Result) << "Expected " << *Name << " to be removed";
+    if (!Result) {
+      auto Err = Result.takeError();
+      EXPECT_TRUE(Err.isA<SymbolsNotFound>())
+          << "Expected a SymbolsNotFound error";
+      consumeError(std::move(Err));
+    }
+  };
+  ExpectNotFound(JD, Foo);
+  ExpectNotFound(JD2, Bar);
+  EXPECT_EQ(cantFail(ES.lookup({&JD}, Baz)).getAddress(), BazAddr)
+      << "Symbol from another module was removed";
+
+  QuxR->resolve({{Qux, QuxSym}});
+  QuxR->emit();
+  EXPECT_TRUE(OnDoneRun) << "Speculative lookup should have completed";
+
+  cantFail(ES.removeModule(K2));
+  ExpectNotFound(JD, Baz);
+  ExpectNotFound(JD, Qux);
+  EXPECT_EQ(RM.Removed, std::vector<VModuleKey>({K1, K2}));
+
+  ES.deregisterResourceManager(RM);
+}
+
 TEST_F(CoreAPIsStandardTest, ChainedJITDylibLookup) {
   cantFail(JD.define(absoluteSymbols({{Foo, FooSym}})));
 
@@ -774,6 +861,48 @@ TEST_F(CoreAPIsStandardTest, TestLookupWithThreadedMaterialization) {
 #endif
 }
 
+TEST_F(CoreAPIsStandardTest, TestLookupOfReadySymbolsHonorsSearchOrder) {
+  // Lookups of symbols that are already ready skip the session lock. Check
+  // that they still find the first definition in the search order, even when
+  // that definition is not ready yet.
+  auto &JD2 = ES.createJITDylib("JD2");
+  cantFail(JD2.define(absoluteSymbols({{Foo, FooSym}, {Bar, BarSym}})));
+  cantFail(JD2.define(absoluteSymbols(
+      {{Baz, JITEvaluatedSymbol(BazAddr, JITSymbolFlags::None)}})));
+
+  JITDylibSearchList SearchOrder({{&JD, false}, {&JD2, false}});
+
+  auto Result = cantFail(ES.lookup(SearchOrder, {Foo, Bar}));
+  EXPECT_EQ(Result[Foo].getAddress(), FooAddr) << "Wrong address for foo";
+  EXPECT_EQ(Result[Bar].getAddress(), BarAddr) << "Wrong address for bar";
+
+  // Baz is not exported, so it is only visible with MatchNonExported set.
+  EXPECT_EQ(
+      cantFail(ES.lookup(JITDylibSearchList({{&JD2, true}}), Baz)).getAddress(),
+      BazAddr)
+      << "Wrong address for baz";
+  auto Err = ES.lookup(SearchOrder, Baz).takeError();
+  EXPECT_TRUE(Err.isA<SymbolsNotFound>()) << "Expected a lookup failure";
+  consumeError(std::move(Err));
+
+  // A lazy definition of Foo in JD shadows the ready one in JD2.
+  cantFail(JD.define(llvm::make_unique<SimpleMaterializationUnit>(
+      SymbolFlagsMap({{Foo, JITSymbolFlags::Exported}}),
+      [&](MaterializationResponsibility R) {
+        R.resolve({{Foo, QuxSym}});
+        R.emit();
+      })));
+  EXPECT_EQ(cantFail(ES.lookup(SearchOrder, Foo)).getAddress(), QuxAddr)
+      << "Lookup should have materialized foo in JD";
+  EXPECT_EQ(cantFail(ES.lookup(SearchOrder, Foo)).getAddress(), QuxAddr)
+      << "Ready lookup should have found foo in JD";
+
+  // Once it is removed from JD, lookups find JD2's definition again.
+  cantFail(JD.remove({Foo}));
+  EXPECT_EQ(cantFail(ES.lookup(SearchOrder, Foo)).getAddress(), FooAddr)
+      << "Lookup should have found foo in JD2";
+}
+
 TEST_F(CoreAPIsStandardTest, TestGetRequestedSymbolsAndReplace) {
   // Test that GetRequestedSymbols returns the set of symbols that currently
   // have pending queries, and test that MaterializationResponsibility's
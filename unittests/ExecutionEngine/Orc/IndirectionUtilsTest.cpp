@@ -10,6 +10,7 @@
 #include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
 #include "OrcTestCommon.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ExecutionEngine/Orc/OrcABISupport.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -44,4 +45,24 @@ TEST(IndirectionUtilsTest, MakeStub) {
     << "makeStub should propagate byval attr on 2nd argument.";
 }
 
+TEST(IndirectionUtilsTest, RemoveStub) {
+  orc::LocalIndirectStubsManager<orc::OrcX86_64_SysV> ISM;
+
+  cantFail(ISM.createStub("foo", 0x1000, JITSymbolFlags::Exported));
+  auto FooAddr = ISM.findStub("foo", false).getAddress();
+  ASSERT_NE(FooAddr, 0U) << "Stub for foo not created";
+
+  cantFail(ISM.removeStub("foo"));
+  EXPECT_FALSE(ISM.findStub("foo", false)) << "Stub for foo not removed";
+
+  // Removed stubs are reused.
+  cantFail(ISM.createStub("bar", 0x2000, JITSymbolFlags::Exported));
+  EXPECT_EQ(FooAddr, ISM.findStub("bar", false).getAddress())
+      << "Stub slot of foo was not reused";
+
+  auto Err = ISM.removeStub("foo");
+  EXPECT_TRUE(!!Err) << "Removing a missing stub should fail";
+  consumeError(std::move(Err));
+}
+
 }
@@ -0,0 +1,70 @@
+//===------- LocalObjectCacheTest.cpp - Unit tests for LocalObjectCache ---===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/LocalObjectCache.h"
+#include "OrcTestCommon.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class LocalObjectCacheTest : public testing::Test, public OrcExecutionTest {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(
+        sys::fs::createUniqueDirectory("orc-object-cache-test", CacheDir));
+  }
+
+  void TearDown() override { sys::fs::remove_directories(CacheDir); }
+
+  unsigned countEntries() {
+    unsigned NumEntries = 0;
+    std::error_code EC;
+    for (sys::fs::directory_iterator I(CacheDir, EC), E; I != E && !EC;
+         I.increment(EC))
+      if (sys::path::filename(I->path()).startswith("llvmcache-"))
+        ++NumEntries;
+    return NumEntries;
+  }
+
+  SmallString<64> CacheDir;
+};
+
+TEST_F(LocalObjectCacheTest, FailedCompileDropsPendingKey) {
+  if (!TM)
+    return;
+
+  auto Cache = cantFail(LocalObjectCache::Create(CacheDir, *TM));
+  LLVMContext Ctx;
+  Module M("failed", Ctx);
+  auto Obj = MemoryBuffer::getMemBuffer("object");
+
+  // After a failed compile, a notification for a module at the same address
+  // that was not looked up first must not be stored under the old key.
+  EXPECT_FALSE(Cache->getObject(&M));
+  Cache->notifyObjectCompileFailed(&M);
+  Cache->notifyObjectCompiled(&M, Obj->getMemBufferRef());
+  EXPECT_EQ(countEntries(), 0U);
+
+  // A miss followed by a successful compile still populates the cache.
+  EXPECT_FALSE(Cache->getObject(&M));
+  Cache->notifyObjectCompiled(&M, Obj->getMemBufferRef());
+  EXPECT_EQ(countEntries(), 1U);
+  auto Cached = Cache->getObject(&M);
+  ASSERT_TRUE(!!Cached);
+  EXPECT_EQ(Cached->getBuffer(), "object");
+}
+
+} // end anonymous namespace
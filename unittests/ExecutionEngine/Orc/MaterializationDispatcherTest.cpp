@@ -0,0 +1,244 @@
+//===- MaterializationDispatcherTest.cpp - Unit tests for MU dispatch -----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OrcTestCommon.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/MaterializationDispatcher.h"
+
+#include <future>
+#include <mutex>
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class MaterializationDispatcherTest : public CoreAPIsBasedStandardTest {
+protected:
+  // Make D the session's dispatcher. Units for the symbols in
+  // SpeculativeNames are dispatched speculatively, as an embedder that
+  // prefetches code would do.
+  void useDispatcher(MaterializationDispatcher &D) {
+    ES.setDispatchMaterialization(
+        [this, &D](JITDylib &JD, std::unique_ptr<MaterializationUnit> MU) {
+          if (SpeculativeNames.count(MU->getSymbols().begin()->first))
+            D.dispatchSpeculative(JD, std::move(MU));
+          else
+            D.dispatch(JD, std::move(MU));
+        });
+    ES.setNotifyQueryBlocked(D.getNotifyQueryBlockedFunction());
+  }
+
+  // Define a symbol in JD whose materializer runs Body, then resolves and
+  // emits it.
+  SymbolStringPtr defineUnit(StringRef Name, std::function<void()> Body) {
+    auto SymName = ES.intern(Name);
+    JITEvaluatedSymbol Sym(0x1000 + NextAddr++, JITSymbolFlags::Exported);
+    cantFail(JD.define(llvm::make_unique<SimpleMaterializationUnit>(
+        SymbolFlagsMap({{SymName, Sym.getFlags()}}),
+        [SymName, Sym, Body](MaterializationResponsibility R) {
+          Body();
+          R.resolve({{SymName, Sym}});
+          R.emit();
+        })));
+    return SymName;
+  }
+
+  // Issue a lookup for Name that does not wait for the result.
+  void demand(SymbolStringPtr Name, bool *Done = nullptr) {
+    ES.lookup(JITDylibSearchList({{&JD, false}}), {Name},
+              [](Expected<SymbolMap> Result) { cantFail(Result.takeError()); },
+              [Done](Error Err) {
+                cantFail(std::move(Err));
+                if (Done)
+                  *Done = true;
+              },
+              NoDependenciesToRegister);
+  }
+
+  void speculate(SymbolStringPtr Name, bool *Done) {
+    ES.speculate(JITDylibSearchList({{&JD, false}}), {Name},
+                 [Done](Error Err) {
+                   cantFail(std::move(Err));
+                   *Done = true;
+                 });
+  }
+
+  SymbolNameSet SpeculativeNames;
+  unsigned NextAddr = 0;
+};
+
+#if LLVM_ENABLE_THREADS
+
+TEST_F(MaterializationDispatcherTest, DemandedBeforeSpeculative) {
+  MaterializationDispatcher D(1);
+  useDispatcher(D);
+  std::vector<std::string> Order;
+
+  auto defineRecorded = [&](std::string Name) {
+    return defineUnit(Name, [&Order, Name]() { Order.push_back(Name); });
+  };
+
+  // Keep the only compile thread busy until everything else is queued.
+  std::promise<void> ReleaseBlocker;
+  auto BlockerReleased = ReleaseBlocker.get_future().share();
+  demand(
+      defineUnit("blocker", [BlockerReleased]() { BlockerReleased.wait(); }));
+
+  auto Spec1 = defineRecorded("spec1");
+  auto Spec2 = defineRecorded("spec2");
+  SpeculativeNames = {Spec1, Spec2};
+
+  // The lookups that dispatch the speculative units do not promote them.
+  demand(Spec1);
+  demand(defineRecorded("demand1"));
+  demand(Spec2);
+  demand(defineRecorded("demand2"));
+
+  ReleaseBlocker.set_value();
+  D.wait();
+
+  std::vector<std::string> Expected = {"demand1", "demand2", "spec1", "spec2"};
+  EXPECT_EQ(Order, Expected)
+      << "Speculative units should run after all demanded units";
+
+  auto Stats = D.getStatistics();
+  EXPECT_EQ(Stats.NumDispatched, 5U) << "Wrong dispatch count";
+  EXPECT_EQ(Stats.NumSpeculative, 2U) << "Wrong speculative dispatch count";
+  EXPECT_EQ(Stats.NumPromoted, 0U) << "Nothing should have been promoted";
+  EXPECT_EQ(Stats.NumMaterialized, 5U) << "Wrong materialization count";
+  EXPECT_GE(Stats.MaxQueueDepth, 4U) << "Queue depth not tracked";
+  EXPECT_EQ(D.getQueueDepth(), 0U) << "Queue should be empty after wait";
+}
+
+TEST_F(MaterializationDispatcherTest, SessionDispatch) {
+  MaterializationDispatcher D(2);
+  ES.setDispatchMaterialization(D.getDispatchFunction());
+
+  auto MU = llvm::make_unique<SimpleMaterializationUnit>(
+      SymbolFlagsMap({{Foo, FooSym.getFlags()}}),
+      [&](MaterializationResponsibility R) {
+        R.resolve({{Foo, FooSym}});
+        R.emit();
+      });
+
+  cantFail(JD.define(MU));
+
+  auto FooLookupResult =
+      cantFail(ES.lookup(JITDylibSearchList({{&JD, false}}), Foo));
+  EXPECT_EQ(FooLookupResult.getAddress(), FooSym.getAddress())
+      << "lookup returned an incorrect address";
+
+  D.wait();
+  EXPECT_EQ(D.getStatistics().NumMaterialized, 1U)
+      << "Expected one unit to be materialized on the compile threads";
+}
+
+TEST_F(MaterializationDispatcherTest, PromoteBlockedSpeculation) {
+  MaterializationDispatcher D(1);
+  useDispatcher(D);
+
+  std::mutex OrderMutex;
+  std::vector<std::string> Order;
+  auto record = [&](std::string Name) {
+    std::lock_guard<std::mutex> Lock(OrderMutex);
+    Order.push_back(std::move(Name));
+  };
+
+  std::promise<void> ReleaseBlocker;
+  auto BlockerReleased = ReleaseBlocker.get_future().share();
+  demand(
+      defineUnit("blocker", [BlockerReleased]() { BlockerReleased.wait(); }));
+
+  auto FooName = defineUnit("foo", [&]() { record("foo"); });
+  SpeculativeNames.insert(FooName);
+  demand(FooName);
+
+  demand(defineUnit("other", [&]() { record("other"); }));
+
+  // This lookup waits on the queued speculative unit for foo, so that unit
+  // should overtake "other".
+  bool LookupDone = false;
+  demand(FooName, &LookupDone);
+
+  ReleaseBlocker.set_value();
+  D.wait();
+
+  std::vector<std::string> Expected = {"foo", "other"};
+  EXPECT_EQ(Order, Expected) << "Blocked speculative unit was not promoted";
+  EXPECT_EQ(D.getStatistics().NumPromoted, 1U) << "Wrong promotion count";
+  EXPECT_TRUE(LookupDone) << "Lookup callback not run";
+}
+
+TEST_F(MaterializationDispatcherTest, PromoteBlockedSessionSpeculation) {
+  MaterializationDispatcher D(1);
+  ES.setDispatchMaterialization(D.getDispatchFunction());
+  ES.setDispatchSpeculativeMaterialization(
+      D.getSpeculativeDispatchFunction());
+  ES.setNotifyQueryBlocked(D.getNotifyQueryBlockedFunction());
+
+  std::mutex OrderMutex;
+  std::vector<std::string> Order;
+  auto record = [&](std::string Name) {
+    std::lock_guard<std::mutex> Lock(OrderMutex);
+    Order.push_back(std::move(Name));
+  };
+
+  std::promise<void> ReleaseBlocker;
+  auto BlockerReleased = ReleaseBlocker.get_future().share();
+  demand(
+      defineUnit("blocker", [BlockerReleased]() { BlockerReleased.wait(); }));
+
+  // Speculating on bar and then on foo queues both speculatively. The second
+  // speculative query on bar does not promote it.
+  bool BarSpeculated = false, BarSpeculatedAgain = false;
+  auto BarName = defineUnit("bar", [&]() { record("bar"); });
+  speculate(BarName, &BarSpeculated);
+  speculate(BarName, &BarSpeculatedAgain);
+
+  bool SpeculationDone = false;
+  auto FooName = defineUnit("foo", [&]() { record("foo"); });
+  speculate(FooName, &SpeculationDone);
+
+  demand(defineUnit("other", [&]() { record("other"); }));
+
+  // A real lookup now blocks on foo, so it should overtake "other" and bar.
+  bool LookupDone = false;
+  demand(FooName, &LookupDone);
+
+  ReleaseBlocker.set_value();
+  D.wait();
+
+  std::vector<std::string> Expected = {"foo", "other", "bar"};
+  EXPECT_EQ(Order, Expected) << "Blocked speculative unit was not promoted";
+  EXPECT_EQ(D.getStatistics().NumPromoted, 1U) << "Wrong promotion count";
+  EXPECT_TRUE(BarSpeculated && BarSpeculatedAgain)
+      << "Speculation callbacks not run";
+  EXPECT_TRUE(SpeculationDone) << "Speculation callback not run";
+  EXPECT_TRUE(LookupDone) << "Lookup callback not run";
+}
+
+#endif
+
+TEST_F(MaterializationDispatcherTest, SpeculateWithoutDispatcher) {
+  // Without a speculative dispatcher, speculation must not materialize
+  // anything on the calling thread.
+  bool Materialized = false;
+  auto FooName = defineUnit("foo", [&]() { Materialized = true; });
+
+  bool SpeculationDone = false;
+  speculate(FooName, &SpeculationDone);
+  EXPECT_TRUE(SpeculationDone) << "Speculation callback not run";
+  EXPECT_FALSE(Materialized) << "Speculation materialized synchronously";
+
+  demand(FooName);
+  EXPECT_TRUE(Materialized) << "Lookup did not materialize foo";
+}
+
+} // namespace
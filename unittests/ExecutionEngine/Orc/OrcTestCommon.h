@@ -96,8 +96,9 @@ public:
   SimpleMaterializationUnit(
       orc::SymbolFlagsMap SymbolFlags, MaterializeFunction Materialize,
       DiscardFunction Discard = DiscardFunction(),
-      DestructorFunction Destructor = DestructorFunction())
-      : MaterializationUnit(std::move(SymbolFlags), orc::VModuleKey()),
+      DestructorFunction Destructor = DestructorFunction(),
+      orc::VModuleKey K = orc::VModuleKey())
+      : MaterializationUnit(std::move(SymbolFlags), std::move(K)),
         Materialize(std::move(Materialize)), Discard(std::move(Discard)),
         Destructor(std::move(Destructor)) {}
 
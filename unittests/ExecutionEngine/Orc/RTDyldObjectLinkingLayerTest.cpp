@@ -16,6 +16,7 @@
 #include "llvm/ExecutionEngine/Orc/NullResolver.h"
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/ExecutionEngine/SlabMemoryManager.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/LLVMContext.h"
 #include "gtest/gtest.h"
@@ -226,4 +227,85 @@ TEST(RTDyldObjectLinkingLayerTest, TestAutoClaimResponsibilityForSymbols) {
             NoDependenciesToRegister);
 }
 
+TEST(RTDyldObjectLinkingLayerTest, TestRemoveModuleFreesMemory) {
+
+  OrcNativeTarget::initialize();
+
+  std::unique_ptr<TargetMachine> TM(
+      EngineBuilder().selectTarget(Triple("x86_64-unknown-linux-gnu"), "", "",
+                                   SmallVector<std::string, 1>()));
+
+  if (!TM)
+    return;
+
+  // Compile a module with a single void() function, foo, once, then churn
+  // through many copies of the resulting object.
+  std::unique_ptr<MemoryBuffer> Obj;
+  {
+    LLVMContext Ctx;
+    ModuleBuilder MB(Ctx, TM->getTargetTriple().str(), "dummy");
+    MB.getModule()->setDataLayout(TM->createDataLayout());
+
+    Function *FooImpl = MB.createFunctionDecl<void()>("foo");
+    BasicBlock *FooEntry = BasicBlock::Create(Ctx, "entry", FooImpl);
+    IRBuilder<> B(FooEntry);
+    B.CreateRetVoid();
+
+    Obj = SimpleCompiler(*TM)(*MB.getModule());
+  }
+
+  // Count the memory managers that are alive, and allocate all of them from
+  // one pool so that the memory in use can be observed.
+  class CountingMemoryManager : public SlabMemoryManager {
+  public:
+    CountingMemoryManager(std::shared_ptr<SlabPool> Pool, unsigned &NumLive)
+        : SlabMemoryManager(std::move(Pool)), NumLive(NumLive) {
+      ++NumLive;
+    }
+    ~CountingMemoryManager() override { --NumLive; }
+
+  private:
+    unsigned &NumLive;
+  };
+
+  auto Pool = std::make_shared<SlabMemoryManager::SlabPool>();
+  unsigned NumLive = 0;
+
+  ExecutionSession ES;
+  auto &JD = ES.createJITDylib("main");
+  auto Foo = ES.intern("foo");
+  RTDyldObjectLinkingLayer ObjLayer(ES, [&]() {
+    return llvm::make_unique<CountingMemoryManager>(Pool, NumLive);
+  });
+
+  JITTargetAddress FirstFooAddr = 0;
+  unsigned SlabsAfterFirstLoad = 0;
+  for (unsigned I = 0; I != 2000; ++I) {
+    auto K = ES.allocateVModule();
+    cantFail(ObjLayer.add(
+        JD, MemoryBuffer::getMemBufferCopy(Obj->getBuffer()), K));
+    auto FooSym = cantFail(ES.lookup({&JD}, Foo));
+    EXPECT_EQ(1U, NumLive) << "Expected one live memory manager";
+
+    if (I == 0) {
+      FirstFooAddr = FooSym.getAddress();
+      SlabsAfterFirstLoad = Pool->getStatistics().NumSlabs;
+    } else
+      ASSERT_EQ(FirstFooAddr, FooSym.getAddress())
+          << "Memory of removed module was not reused";
+
+    cantFail(ES.removeModule(K));
+    ASSERT_EQ(0U, NumLive) << "Memory manager not freed on removal";
+    ASSERT_EQ(0U, Pool->getStatistics().BytesInUse)
+        << "Memory not returned to the pool";
+  }
+
+  EXPECT_EQ(SlabsAfterFirstLoad, Pool->getStatistics().NumSlabs)
+      << "Pool grew while churning modules";
+
+  auto Result = ES.lookup({&JD}, Foo);
+  EXPECT_FALSE(!!Result) << "Removed symbol still defined";
+  consumeError(Result.takeError());
+}
+
 } // end anonymous namespace
@@ -0,0 +1,145 @@
+//===- SlabMemoryManagerTest.cpp - Unit tests for the slab memory manager -===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/SlabMemoryManager.h"
+#include "llvm/Support/Process.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+using SlabPool = SlabMemoryManager::SlabPool;
+
+// Allocates sections the way RuntimeDyld does for an object with one code,
+// one read-only and one read-write section of Size bytes each.
+static void loadObject(SlabMemoryManager &MemMgr, uintptr_t Size,
+                       uint8_t *&Code, uint8_t *&ROData, uint8_t *&RWData) {
+  MemMgr.reserveAllocationSpace(Size, 16, Size, 16, Size, 16);
+  Code = MemMgr.allocateCodeSection(Size, 16, 1, ".text");
+  ROData = MemMgr.allocateDataSection(Size, 16, 2, ".rodata", true);
+  RWData = MemMgr.allocateDataSection(Size, 16, 3, ".data", false);
+}
+
+TEST(SlabMemoryManagerTest, BasicAllocations) {
+  SlabMemoryManager MemMgr;
+
+  uint8_t *Code, *ROData, *RWData;
+  loadObject(MemMgr, 256, Code, ROData, RWData);
+  uint8_t *Code2 = MemMgr.allocateCodeSection(256, 0, 4, "");
+
+  EXPECT_NE((uint8_t *)nullptr, Code);
+  EXPECT_NE((uint8_t *)nullptr, ROData);
+  EXPECT_NE((uint8_t *)nullptr, RWData);
+  EXPECT_NE((uint8_t *)nullptr, Code2);
+
+  for (unsigned i = 0; i < 256; ++i) {
+    Code[i] = 1;
+    ROData[i] = 2;
+    RWData[i] = 3;
+    Code2[i] = 4;
+  }
+
+  // Verify the data (this is checking for overlaps in the addresses)
+  for (unsigned i = 0; i < 256; ++i) {
+    EXPECT_EQ(1, Code[i]);
+    EXPECT_EQ(2, ROData[i]);
+    EXPECT_EQ(3, RWData[i]);
+    EXPECT_EQ(4, Code2[i]);
+  }
+
+  std::string Error;
+  EXPECT_FALSE(MemMgr.finalizeMemory(&Error)) << Error;
+}
+
+TEST(SlabMemoryManagerTest, PacksObjectsAndBatchesPermissions) {
+  auto Pool = std::make_shared<SlabPool>();
+  SlabMemoryManager MemMgr1(Pool), MemMgr2(Pool);
+  static const uintptr_t PageSize = sys::Process::getPageSize();
+
+  uint8_t *Code1, *ROData1, *RWData1, *Code2, *ROData2, *RWData2;
+  loadObject(MemMgr1, 100, Code1, ROData1, RWData1);
+  loadObject(MemMgr2, 100, Code2, ROData2, RWData2);
+
+  // The code of both objects is on adjacent pages of the same slab.
+  EXPECT_EQ(Code1 + PageSize, Code2) << "Code was not packed";
+  EXPECT_EQ(ROData1 + PageSize, ROData2) << "Read-only data was not packed";
+  EXPECT_EQ(3U, Pool->getStatistics().NumSlabs)
+      << "Expected one slab per purpose";
+
+  std::string Error;
+  EXPECT_FALSE(MemMgr1.finalizeMemory(&Error)) << Error;
+  EXPECT_EQ(2U, Pool->getStatistics().NumProtectCalls)
+      << "Expected one permission change for code and one for read-only data";
+
+  // Sections allocated after finalization go to fresh, writable memory.
+  uint8_t *Late = MemMgr1.allocateCodeSection(16, 16, 4, "");
+  ASSERT_NE((uint8_t *)nullptr, Late);
+  Late[0] = 1;
+  EXPECT_EQ(1, Late[0]);
+}
+
+TEST(SlabMemoryManagerTest, ReusesReleasedMemory) {
+  auto Pool = std::make_shared<SlabPool>();
+
+  uint8_t *FirstCode;
+  {
+    SlabMemoryManager MemMgr(Pool);
+    uint8_t *ROData, *RWData;
+    loadObject(MemMgr, 4096, FirstCode, ROData, RWData);
+    std::string Error;
+    EXPECT_FALSE(MemMgr.finalizeMemory(&Error)) << Error;
+  }
+  EXPECT_EQ(0U, Pool->getStatistics().BytesInUse) << "Memory not released";
+
+  // Churn through many objects: memory is reused rather than mapped again,
+  // and released code pages are writable again.
+  for (unsigned i = 0; i < 1000; ++i) {
+    SlabMemoryManager MemMgr(Pool);
+    uint8_t *Code, *ROData, *RWData;
+    loadObject(MemMgr, 4096, Code, ROData, RWData);
+    ASSERT_EQ(FirstCode, Code) << "Released memory was not reused";
+    Code[0] = 0xc3;
+    std::string Error;
+    ASSERT_FALSE(MemMgr.finalizeMemory(&Error)) << Error;
+  }
+
+  EXPECT_EQ(3U, Pool->getStatistics().NumSlabs) << "Pool grew during churn";
+}
+
+TEST(SlabMemoryManagerTest, LargeAllocations) {
+  auto Pool = std::make_shared<SlabPool>(1024 * 1024);
+  SlabMemoryManager MemMgr(Pool);
+
+  // Larger than a slab: gets a dedicated one.
+  uint8_t *Code = MemMgr.allocateCodeSection(0x300000, 0, 1, "");
+  ASSERT_NE((uint8_t *)nullptr, Code);
+  Code[0] = 1;
+  Code[0x2fffff] = 2;
+  EXPECT_EQ(1, Code[0]);
+  EXPECT_EQ(2, Code[0x2fffff]);
+
+  std::string Error;
+  EXPECT_FALSE(MemMgr.finalizeMemory(&Error)) << Error;
+}
+
+TEST(SlabMemoryManagerTest, HugePageSlabs) {
+  auto Pool = std::make_shared<SlabPool>(SlabPool::HugePageSize, true);
+  SlabMemoryManager MemMgr(Pool);
+
+  uint8_t *Code = MemMgr.allocateCodeSection(64, 0, 1, "");
+  ASSERT_NE((uint8_t *)nullptr, Code);
+  EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(Code) % SlabPool::HugePageSize)
+      << "Huge page slab is not aligned";
+
+  std::string Error;
+  EXPECT_FALSE(MemMgr.finalizeMemory(&Error)) << Error;
+}
+
+} // end anonymous namespace
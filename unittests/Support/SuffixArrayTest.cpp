@@ -0,0 +1,104 @@
+//===- SuffixArrayTest.cpp - Unit tests for SuffixArray -------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/SuffixArray.h"
+#include "llvm/Support/SuffixTree.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+typedef std::vector<std::pair<unsigned, std::vector<unsigned>>> RepeatList;
+
+RepeatList treeRepeats(const std::vector<unsigned> &Str) {
+  SuffixTree ST(Str);
+  RepeatList Repeats;
+  for (auto It = ST.begin(), Et = ST.end(); It != Et; ++It) {
+    std::vector<unsigned> Starts = (*It).StartIndices;
+    std::sort(Starts.begin(), Starts.end());
+    Repeats.emplace_back((*It).Length, Starts);
+  }
+  std::sort(Repeats.begin(), Repeats.end());
+  return Repeats;
+}
+
+RepeatList arrayRepeats(const std::vector<unsigned> &Str) {
+  SuffixArray SA(Str);
+  RepeatList Repeats;
+  SA.forEachRepeatedSubstring([&](const RepeatedSubstring &RS) {
+    EXPECT_TRUE(
+        std::is_sorted(RS.StartIndices.begin(), RS.StartIndices.end()));
+    Repeats.emplace_back(RS.Length, RS.StartIndices);
+  });
+  std::sort(Repeats.begin(), Repeats.end());
+  return Repeats;
+}
+
+TEST(SuffixArrayTest, Banana) {
+  // The characters are renumbered in the order they first occur, so b sorts
+  // before a, n and the terminator.
+  std::vector<unsigned> Str = {'b', 'a', 'n', 'a', 'n', 'a', '$'};
+  SuffixArray SA(Str);
+  EXPECT_EQ(std::vector<unsigned>({0, 1, 3, 5, 2, 4, 6}),
+            SA.getSuffixes().vec());
+  EXPECT_EQ(std::vector<unsigned>({0, 0, 3, 1, 0, 2, 0}), SA.getLCPs().vec());
+
+  // "ana" at 1 and 3, and "na" at 2 and 4. "a" is too short.
+  RepeatList Expected = {{2, {2, 4}}, {3, {1, 3}}};
+  EXPECT_EQ(Expected, arrayRepeats(Str));
+  EXPECT_EQ(Expected, treeRepeats(Str));
+}
+
+TEST(SuffixArrayTest, NoRepeats) {
+  std::vector<unsigned> Str = {7, 3, 9, 1, 4};
+  SuffixArray SA(Str);
+  EXPECT_EQ(std::vector<unsigned>({0, 1, 2, 3, 4}), SA.getSuffixes().vec());
+  EXPECT_TRUE(arrayRepeats(Str).empty());
+
+  EXPECT_TRUE(SuffixArray({}).getSuffixes().empty());
+  EXPECT_TRUE(arrayRepeats({}).empty());
+}
+
+TEST(SuffixArrayTest, Run) {
+  // Every run of 5s shorter than the whole one repeats, as a chain of nested
+  // intervals.
+  std::vector<unsigned> Str(8, 5);
+  Str.push_back(6);
+  EXPECT_EQ(treeRepeats(Str), arrayRepeats(Str));
+  EXPECT_FALSE(arrayRepeats(Str).empty());
+}
+
+TEST(SuffixArrayTest, SameRepeatsAsSuffixTree) {
+  // Strings shaped like the ones the MachineOutliner builds: runs of a few
+  // legal instructions, separated by unique illegal ones that count down from
+  // -3.
+  uint32_t Seed = 12345;
+  auto Next = [&Seed]() {
+    Seed = Seed * 1103515245 + 12345;
+    return Seed >> 16;
+  };
+  for (unsigned Alphabet : {2, 3, 8, 64}) {
+    for (unsigned Length : {1, 2, 10, 100, 1000, 5000}) {
+      std::vector<unsigned> Str;
+      unsigned Illegal = -3;
+      for (unsigned I = 0; I != Length; ++I)
+        Str.push_back(Next() % 16 == 0 ? Illegal-- : Next() % Alphabet);
+      Str.push_back(Illegal);
+      EXPECT_EQ(treeRepeats(Str), arrayRepeats(Str))
+          << "alphabet " << Alphabet << ", length " << Length;
+    }
+  }
+}
+
+} // end anonymous namespace